@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <vfs/path-normalize.hpp>
+#include <vfs/unix/unix-path.hpp>
+
+namespace
+{
+    volatile std::size_t sink;
+
+    std::vector<std::string> make_paths(bool dirty)
+    {
+        std::vector<std::string> paths;
+
+        uint32_t seed = 0x9e3779b9u;
+
+        for (int i = 0; i < 4096; ++i)
+        {
+            std::string value {"/data/vfs"};
+
+            for (int k = 0; k < 6; ++k)
+            {
+                seed = seed * 1664525u + 1013904223u;
+
+                value += "/object-" + std::to_string(seed >> 12);
+
+                if (dirty && k % 3 == 1)
+                {
+                    value += (seed & 1) != 0 ? "/./" : "//x/..";
+                }
+            }
+
+            paths.push_back(value);
+        }
+
+        return paths;
+    }
+
+    std::size_t normalize_with_unix_path(const std::string &value)
+    {
+        vfs::unix_path path {std::string {value.front() == '/' ? "/" : ""}};
+        std::size_t i = 0;
+
+        while (i < value.size())
+        {
+            auto e = value.find('/', i);
+
+            if (e == std::string::npos)
+            {
+                e = value.size();
+            }
+
+            std::string_view component {value.data() + i, e - i};
+
+            if (component == "..")
+            {
+                path.parent();
+            }
+            else if (!component.empty() && component != ".")
+            {
+                path.append(component);
+            }
+
+            i = e + 1;
+        }
+
+        return path.str().size();
+    }
+
+    template<typename t_value, typename t_fn>
+    void run(const char *name, const std::vector<t_value> &values, t_fn fn)
+    {
+        const int rounds = 200;
+
+        std::vector<t_value> copies {values};
+        std::size_t total = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                copies[i] = values[i];
+                total += fn(copies[i]);
+            }
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+        sink = total;
+
+        std::printf("  %-36s %8.1f ns/path\n", name, static_cast<double>(ns) / (rounds * values.size()));
+    }
+
+    void run_suite(const char *title, const std::vector<std::string> &values)
+    {
+        std::vector<vfs::unix_path> paths;
+
+        for (auto &value : values)
+        {
+            paths.emplace_back(std::string {value});
+        }
+
+        std::printf("%s (avx2: %s)\n", title, vfs::path_has_avx2() ? "yes" : "no");
+
+        run("unix_path::is_valid", paths, [](vfs::unix_path &path)
+        {
+            return static_cast<std::size_t>(path.is_valid());
+        });
+
+        run("unix_path::validate (scalar scan)", paths, [](vfs::unix_path &path)
+        {
+            return vfs::path_scan_sw(path.view()).longest;
+        });
+
+        run("unix_path::validate (simd scan)", paths, [](vfs::unix_path &path)
+        {
+            return static_cast<std::size_t>(-path.validate());
+        });
+
+        run("unix_path parent/append", values, [](std::string &value)
+        {
+            return normalize_with_unix_path(value);
+        });
+
+        run("normalize_path (scalar scan)", values, [](std::string &value)
+        {
+            auto scan = vfs::path_scan_sw(value);
+
+            return scan.restart == vfs::path_scan_result::clean
+                   ? value.size()
+                   : vfs::normalize_path_from(&value[0], value.size(), scan.restart);
+        });
+
+        run("normalize_path (simd scan)", values, [](std::string &value)
+        {
+            return vfs::normalize_path(&value[0], value.size());
+        });
+    }
+}
+
+int main()
+{
+    run_suite("canonical paths", make_paths(false));
+    run_suite("non-canonical paths", make_paths(true));
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+#ifndef VFS_BATCH_HPP
+#define VFS_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+
+#include <vfs/callback.hpp>
+
+namespace vfs
+{
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class filesystem;
+
+    enum class batch_op : uint8_t
+    {
+        exists,
+        stat,
+        unlink,
+        move,
+        read,
+        write
+    };
+
+    template<typename t_stat, typename t_buffer>
+    class batch_result
+    {
+      private:
+
+        batch_op _op;
+        int _error;
+        std::variant<std::monostate, bool, t_stat, t_buffer> _value;
+
+      public:
+
+        batch_result() noexcept
+            : _op(batch_op::exists), _error(0), _value()
+        {}
+
+        template<typename t_value>
+        batch_result(batch_op op, int error, t_value &&value) noexcept
+            : _op(op), _error(error), _value(std::forward<t_value>(value))
+        {}
+
+        inline batch_op op() const noexcept
+        {
+            return _op;
+        }
+
+        inline int error() const noexcept
+        {
+            return _error;
+        }
+
+        inline bool exists() const noexcept
+        {
+            auto value = std::get_if<bool>(&_value);
+            return value != nullptr && *value;
+        }
+
+        inline t_stat &stat() noexcept
+        {
+            return std::get<t_stat>(_value);
+        }
+
+        inline t_buffer &buffer() noexcept
+        {
+            return std::get<t_buffer>(_value);
+        }
+    };
+
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class batch
+    {
+      public:
+
+        using result_type = batch_result<t_stat, t_buffer>;
+
+        using batch_cb = vfs::callback<
+            void(int, std::vector<result_type> &)>;
+
+      private:
+
+        using filesystem_type = vfs::filesystem<t_path, t_stat, t_file, t_buffer>;
+
+        struct exists_entry
+        {
+            static constexpr batch_op op = batch_op::exists;
+            t_path p;
+        };
+
+        struct stat_entry
+        {
+            static constexpr batch_op op = batch_op::stat;
+            t_path p;
+        };
+
+        struct unlink_entry
+        {
+            static constexpr batch_op op = batch_op::unlink;
+            t_path p;
+        };
+
+        struct move_entry
+        {
+            static constexpr batch_op op = batch_op::move;
+            t_path p;
+            t_path move_p;
+        };
+
+        struct read_entry
+        {
+            static constexpr batch_op op = batch_op::read;
+            t_file file;
+            t_buffer buf;
+            off64_t off;
+        };
+
+        struct write_entry
+        {
+            static constexpr batch_op op = batch_op::write;
+            t_file file;
+            t_buffer buf;
+            off64_t off;
+        };
+
+        using entry = std::variant<exists_entry, stat_entry, unlink_entry, move_entry, read_entry, write_entry>;
+
+        filesystem_type &_fs;
+        std::size_t _concurrency;
+
+        std::vector<entry> _entries;
+        std::vector<result_type> _results;
+        batch_cb _cb;
+
+        std::size_t _next;
+        std::size_t _in_flight;
+        std::size_t _done;
+        int _error;
+        bool _pumping;
+
+        int start(std::size_t i, exists_entry &e) noexcept
+        {
+            return _fs.exists(e.p, [this, i](t_path &, int err, bool exists)
+            {
+                finish(i, batch_op::exists, err, exists);
+            });
+        }
+
+        int start(std::size_t i, stat_entry &e) noexcept
+        {
+            return _fs.stat(e.p, [this, i](t_path &, int err, t_stat stat)
+            {
+                finish(i, batch_op::stat, err, std::move(stat));
+            });
+        }
+
+        int start(std::size_t i, unlink_entry &e) noexcept
+        {
+            return _fs.unlink(e.p, [this, i](t_path &, int err)
+            {
+                finish(i, batch_op::unlink, err, std::monostate {});
+            });
+        }
+
+        int start(std::size_t i, move_entry &e) noexcept
+        {
+            return _fs.move(e.p, e.move_p, [this, i](t_path &, t_path &, int err)
+            {
+                finish(i, batch_op::move, err, std::monostate {});
+            });
+        }
+
+        int start(std::size_t i, read_entry &e) noexcept
+        {
+            return _fs.read(e.file, std::move(e.buf), e.off, [this, i](t_file &, int err, t_buffer &buf)
+            {
+                finish(i, batch_op::read, err, std::move(buf));
+            });
+        }
+
+        int start(std::size_t i, write_entry &e) noexcept
+        {
+            return _fs.write(e.file, std::move(e.buf), e.off, [this, i](t_file &, int err, t_buffer &buf)
+            {
+                finish(i, batch_op::write, err, std::move(buf));
+            });
+        }
+
+        template<typename t_value>
+        void finish(std::size_t i, batch_op op, int err, t_value &&value) noexcept
+        {
+            _results[i] = result_type {op, err, std::forward<t_value>(value)};
+
+            if (err != 0 && _error == 0)
+            {
+                _error = err;
+            }
+
+            --_in_flight;
+            ++_done;
+
+            if (!_pumping)
+            {
+                pump();
+            }
+        }
+
+        void pump() noexcept
+        {
+            _pumping = true;
+
+            while (_next < _entries.size() && _in_flight < _concurrency)
+            {
+                auto i = _next++;
+
+                ++_in_flight;
+
+                auto result = std::visit([this, i](auto &e)
+                {
+                    return start(i, e);
+                }, _entries[i]);
+
+                if (result != 0)
+                {
+                    auto op = std::visit([](auto &e)
+                    {
+                        return e.op;
+                    }, _entries[i]);
+
+                    finish(i, op, result < 0 ? -result : result, std::monostate {});
+                }
+            }
+
+            _pumping = false;
+
+            if (_done == _entries.size())
+            {
+                _cb(_error, _results);
+
+                delete this;
+            }
+        }
+
+      public:
+
+        batch(filesystem_type &fs, std::size_t concurrency) noexcept
+            : _fs(fs), _concurrency(concurrency > 0 ? concurrency : 1),
+              _next(0), _in_flight(0), _done(0), _error(0), _pumping(false)
+        {}
+
+        batch(const batch &lhs) = delete;
+
+        batch(batch &&rhs) noexcept = default;
+
+        batch &operator=(const batch &lhs) = delete;
+
+        inline std::size_t size() const noexcept
+        {
+            return _entries.size();
+        }
+
+        inline batch &exists(t_path path)
+        {
+            _entries.emplace_back(exists_entry {path});
+            return *this;
+        }
+
+        inline batch &stat(t_path path)
+        {
+            _entries.emplace_back(stat_entry {path});
+            return *this;
+        }
+
+        inline batch &unlink(t_path path)
+        {
+            _entries.emplace_back(unlink_entry {path});
+            return *this;
+        }
+
+        inline batch &move(t_path path, t_path move_path)
+        {
+            _entries.emplace_back(move_entry {path, move_path});
+            return *this;
+        }
+
+        inline batch &read(t_file file, t_buffer buf, off64_t off)
+        {
+            _entries.emplace_back(read_entry {file, std::move(buf), off});
+            return *this;
+        }
+
+        inline batch &write(t_file file, t_buffer buf, off64_t off)
+        {
+            _entries.emplace_back(write_entry {file, std::move(buf), off});
+            return *this;
+        }
+
+        int submit(batch_cb cb) noexcept
+        {
+            auto self = new batch {std::move(*this)};
+
+            self->_results.resize(self->_entries.size());
+            self->_cb = std::move(cb);
+
+            self->pump();
+
+            return 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,673 @@
+#ifndef VFS_BLOCK_CACHE_FILESYSTEM_HPP
+#define VFS_BLOCK_CACHE_FILESYSTEM_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <vfs/buffer-chain.hpp>
+#include <vfs/callback.hpp>
+#include <vfs/filesystem-proxy.hpp>
+
+namespace vfs
+{
+    struct block_cache_tier_stats
+    {
+        uint64_t hits;
+        uint64_t inserts;
+        uint64_t evictions;
+        std::size_t blocks;
+        std::size_t bytes;
+    };
+
+    struct block_cache_stats
+    {
+        block_cache_tier_stats recent;
+        block_cache_tier_stats frequent;
+        uint64_t misses;
+        uint64_t ghost_hits;
+        uint64_t stale;
+        uint64_t invalidations;
+
+        inline uint64_t lookups() const noexcept
+        {
+            return recent.hits + frequent.hits + misses;
+        }
+
+        inline double hit_rate(const block_cache_tier_stats &tier) const noexcept
+        {
+            auto total = lookups();
+
+            return total == 0 ? 0.0 : static_cast<double>(tier.hits) / static_cast<double>(total);
+        }
+
+        inline double hit_rate() const noexcept
+        {
+            auto total = lookups();
+            auto hits = recent.hits + frequent.hits;
+
+            return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+    };
+
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class block_cache_filesystem :
+        public filesystem_proxy<t_path, t_stat, t_file, t_buffer>
+    {
+
+      public:
+
+        using proxy_type = filesystem_proxy<t_path, t_stat, t_file, t_buffer>;
+
+        using typename proxy_type::filesystem_type;
+        using typename proxy_type::read_cb;
+        using typename proxy_type::write_cb;
+        using typename proxy_type::writev_cb;
+        using typename proxy_type::truncate_cb;
+        using typename proxy_type::close_cb;
+
+        using read_chain_cb = vfs::callback<
+            void(t_file &, int, vfs::buffer_chain &)>;
+
+        static const std::size_t default_block_size = 64 * 1024;
+        static const std::size_t default_budget = 64 * 1024 * 1024;
+
+      private:
+
+        // device and inode, so files on different mounts never share blocks
+        using inode_type = std::pair<uint64_t, uint64_t>;
+        using key_type = std::pair<inode_type, uint64_t>;
+
+        enum class tier : uint8_t
+        {
+            recent,
+            frequent
+        };
+
+        struct entry
+        {
+            key_type key;
+            vfs::buffer_slice block;
+            uint64_t mtime;
+            uint64_t size;
+            tier where;
+            typename std::list<entry *>::iterator lru;
+        };
+
+        struct read_job
+        {
+            read_chain_cb cb;
+            uint64_t off;
+            uint64_t end;
+            uint64_t first;
+            inode_type inode;
+            uint64_t mtime;
+            uint64_t size;
+            uint64_t generation;
+            std::vector<vfs::buffer_slice> blocks;
+            std::size_t pending;
+            int err;
+        };
+
+        using proxy_type::_inner;
+
+        std::size_t _block_size;
+        std::size_t _budget;
+        std::size_t _recent_budget;
+        std::size_t _ghost_capacity;
+
+        std::map<key_type, std::unique_ptr<entry>> _entries;
+        std::list<entry *> _recent;
+        std::list<entry *> _frequent;
+
+        std::list<key_type> _ghosts;
+        std::map<key_type, std::list<key_type>::iterator> _ghost_index;
+
+        std::unordered_map<uint64_t, inode_type> _inodes;
+
+        uint64_t _generation;
+        block_cache_stats _stats;
+
+        inline block_cache_tier_stats &stats_of(tier where) noexcept
+        {
+            return where == tier::frequent ? _stats.frequent : _stats.recent;
+        }
+
+        inline std::list<entry *> &list_of(tier where) noexcept
+        {
+            return where == tier::frequent ? _frequent : _recent;
+        }
+
+        inline uint64_t expected_size(uint64_t index, uint64_t size) const noexcept
+        {
+            return std::min<uint64_t>(_block_size, size - index * _block_size);
+        }
+
+        void drop(entry *e) noexcept
+        {
+            auto &stats = stats_of(e->where);
+
+            --stats.blocks;
+            stats.bytes -= e->block.size();
+
+            list_of(e->where).erase(e->lru);
+            _entries.erase(e->key);
+        }
+
+        void remember(const key_type &key) noexcept
+        {
+            try
+            {
+                _ghosts.push_front(key);
+                _ghost_index[key] = _ghosts.begin();
+            }
+            catch (...)
+            {
+                return;
+            }
+
+            while (_ghosts.size() > _ghost_capacity)
+            {
+                _ghost_index.erase(_ghosts.back());
+                _ghosts.pop_back();
+            }
+        }
+
+        bool forget(const key_type &key) noexcept
+        {
+            auto it = _ghost_index.find(key);
+
+            if (it == _ghost_index.end())
+            {
+                return false;
+            }
+
+            _ghosts.erase(it->second);
+            _ghost_index.erase(it);
+
+            return true;
+        }
+
+        void reclaim() noexcept
+        {
+            while (_stats.recent.bytes + _stats.frequent.bytes > _budget)
+            {
+                entry *victim;
+
+                if (!_recent.empty() && (_stats.recent.bytes > _recent_budget || _frequent.empty()))
+                {
+                    victim = _recent.back();
+
+                    remember(victim->key);
+                }
+                else
+                {
+                    victim = _frequent.back();
+                }
+
+                ++stats_of(victim->where).evictions;
+
+                drop(victim);
+            }
+        }
+
+        bool lookup(const key_type &key, uint64_t mtime, uint64_t size, vfs::buffer_slice &block) noexcept
+        {
+            auto it = _entries.find(key);
+
+            if (it == _entries.end())
+            {
+                ++_stats.misses;
+                return false;
+            }
+
+            auto e = it->second.get();
+
+            if (e->mtime != mtime || e->size != size)
+            {
+                ++_stats.stale;
+                ++_stats.misses;
+
+                drop_inode(key.first);
+                return false;
+            }
+
+            if (e->where == tier::frequent)
+            {
+                _frequent.splice(_frequent.begin(), _frequent, e->lru);
+            }
+
+            ++stats_of(e->where).hits;
+
+            block = e->block;
+
+            return true;
+        }
+
+        void insert(const key_type &key, const vfs::buffer_slice &block, uint64_t mtime, uint64_t size) noexcept
+        {
+            if (_entries.find(key) != _entries.end())
+            {
+                return;
+            }
+
+            auto where = tier::recent;
+
+            if (forget(key))
+            {
+                ++_stats.ghost_hits;
+
+                where = tier::frequent;
+            }
+
+            try
+            {
+                auto e = std::make_unique<entry>();
+
+                e->key = key;
+                e->block = block;
+                e->mtime = mtime;
+                e->size = size;
+                e->where = where;
+
+                auto &lru = list_of(where);
+
+                lru.push_front(e.get());
+                e->lru = lru.begin();
+
+                try
+                {
+                    _entries.emplace(key, std::move(e));
+                }
+                catch (...)
+                {
+                    lru.pop_front();
+                    return;
+                }
+            }
+            catch (...)
+            {
+                return;
+            }
+
+            auto &stats = stats_of(where);
+
+            ++stats.inserts;
+            ++stats.blocks;
+            stats.bytes += block.size();
+
+            reclaim();
+        }
+
+        std::size_t drop_inode(const inode_type &inode) noexcept
+        {
+            std::size_t dropped = 0;
+
+            auto it = _entries.lower_bound(key_type {inode, 0});
+
+            while (it != _entries.end() && it->first.first == inode)
+            {
+                drop((it++)->second.get());
+
+                ++dropped;
+            }
+
+            return dropped;
+        }
+
+        void invalidate(const inode_type &inode) noexcept
+        {
+            ++_generation;
+
+            _stats.invalidations += drop_inode(inode);
+        }
+
+        void invalidate_fd(uint64_t fd) noexcept
+        {
+            auto it = _inodes.find(fd);
+
+            if (it != _inodes.end())
+            {
+                invalidate(it->second);
+            }
+        }
+
+        void fetch(t_file &file, const t_stat &stat, uint64_t off, uint64_t len, read_chain_cb cb) noexcept
+        {
+            vfs::buffer_chain chain;
+
+            auto size = stat.size();
+
+            try
+            {
+                _inodes[file.fd()] = inode_type {stat.dev(), stat.inode()};
+            }
+            catch (...)
+            {
+                cb(file, ENOMEM, chain);
+                return;
+            }
+
+            if (off >= size || len == 0)
+            {
+                cb(file, 0, chain);
+                return;
+            }
+
+            auto end = len > size - off ? size : off + len;
+            auto first = off / _block_size;
+            auto last = (end - 1) / _block_size;
+
+            std::unique_ptr<read_job> job;
+
+            try
+            {
+                job.reset(new read_job {
+                    .cb = std::move(cb),
+                    .off = off,
+                    .end = end,
+                    .first = first,
+                    .inode = inode_type {stat.dev(), stat.inode()},
+                    .mtime = stat.mtime(),
+                    .size = size,
+                    .generation = _generation,
+                    .blocks = std::vector<vfs::buffer_slice>(last - first + 1),
+                    .pending = 1,
+                    .err = 0
+                });
+            }
+            catch (const std::bad_alloc &)
+            {
+                cb(file, ENOMEM, chain);
+                return;
+            }
+
+            auto *raw = job.release();
+
+            for (auto index = first; index <= last;)
+            {
+                if (lookup(key_type {raw->inode, index}, raw->mtime, size, raw->blocks[index - first]))
+                {
+                    ++index;
+                    continue;
+                }
+
+                auto run = index;
+
+                while (index <= last && _entries.find(key_type {raw->inode, index}) == _entries.end())
+                {
+                    ++index;
+                }
+
+                for (auto i = run + 1; i < index; ++i)
+                {
+                    ++_stats.misses;
+                }
+
+                fill(file, raw, run, index);
+            }
+
+            if (--raw->pending == 0)
+            {
+                finish(file, raw);
+            }
+        }
+
+        void fill(t_file &file, read_job *job, uint64_t begin, uint64_t end) noexcept
+        {
+            std::vector<t_buffer> bufs;
+
+            try
+            {
+                bufs.reserve(end - begin);
+
+                for (auto index = begin; index < end; ++index)
+                {
+                    bufs.emplace_back(expected_size(index, job->size));
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                job->err = ENOMEM;
+                return;
+            }
+
+            ++job->pending;
+
+            auto result = _inner.readv(file, std::move(bufs), static_cast<off64_t>(begin * _block_size),
+                                       [this, job, begin](t_file &file, int err, std::vector<t_buffer> &bufs)
+            {
+                if (err != 0)
+                {
+                    job->err = err;
+                }
+                else
+                {
+                    filled(job, begin, bufs);
+                }
+
+                if (--job->pending == 0)
+                {
+                    finish(file, job);
+                }
+            });
+
+            if (result != 0)
+            {
+                --job->pending;
+
+                job->err = -result;
+            }
+        }
+
+        void filled(read_job *job, uint64_t begin, std::vector<t_buffer> &bufs) noexcept
+        {
+            for (std::size_t i = 0; i < bufs.size(); ++i)
+            {
+                auto index = begin + i;
+                auto full = bufs[i].size() == expected_size(index, job->size);
+
+                try
+                {
+                    job->blocks[index - job->first] = vfs::buffer_slice {std::move(bufs[i])};
+                }
+                catch (const std::bad_alloc &)
+                {
+                    job->err = ENOMEM;
+                    return;
+                }
+
+                if (full && job->generation == _generation)
+                {
+                    insert(key_type {job->inode, index}, job->blocks[index - job->first], job->mtime, job->size);
+                }
+            }
+        }
+
+        void finish(t_file &file, read_job *raw) noexcept
+        {
+            std::unique_ptr<read_job> job {raw};
+
+            vfs::buffer_chain chain;
+
+            auto err = job->err;
+
+            if (err == 0)
+            {
+                try
+                {
+                    for (std::size_t i = 0; i < job->blocks.size(); ++i)
+                    {
+                        auto &block = job->blocks[i];
+                        auto base = (job->first + i) * _block_size;
+                        auto begin = std::max(job->off, base) - base;
+                        auto end = std::min(job->end, base + _block_size) - base;
+
+                        chain.append(block.slice(begin, end - begin));
+
+                        if (block.size() < expected_size(job->first + i, job->size))
+                        {
+                            break;
+                        }
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    chain.clear();
+
+                    err = ENOMEM;
+                }
+            }
+
+            job->cb(file, err, chain);
+        }
+
+      public:
+
+        explicit block_cache_filesystem(filesystem_type &inner,
+                                        std::size_t budget = default_budget,
+                                        std::size_t block_size = default_block_size) noexcept
+            : proxy_type(inner),
+              _block_size(std::max<std::size_t>(block_size, 1)),
+              _budget(budget),
+              _recent_budget(budget / 4),
+              _ghost_capacity(std::max<std::size_t>(budget / std::max<std::size_t>(block_size, 1) / 2, 1)),
+              _generation(0),
+              _stats({})
+        {}
+
+        inline std::size_t block_size() const noexcept
+        {
+            return _block_size;
+        }
+
+        inline std::size_t budget() const noexcept
+        {
+            return _budget;
+        }
+
+        int read_blocks(t_file file, uint64_t off, uint64_t len, read_chain_cb cb) noexcept
+        {
+            return _inner.stat(file, [this, off, len, cb = std::move(cb)](t_file &file, int err,
+                                                                          t_stat stat) mutable
+            {
+                if (err != 0)
+                {
+                    vfs::buffer_chain chain;
+
+                    cb(file, err, chain);
+                    return;
+                }
+
+                fetch(file, stat, off, len, std::move(cb));
+            });
+        }
+
+        void invalidate_inode(uint64_t dev, uint64_t inode) noexcept
+        {
+            invalidate(inode_type {dev, inode});
+        }
+
+        void clear() noexcept
+        {
+            ++_generation;
+
+            _recent.clear();
+            _frequent.clear();
+            _entries.clear();
+            _ghosts.clear();
+            _ghost_index.clear();
+
+            _stats.recent.blocks = _stats.recent.bytes = 0;
+            _stats.frequent.blocks = _stats.frequent.bytes = 0;
+        }
+
+        inline block_cache_stats stats() const noexcept
+        {
+            return _stats;
+        }
+
+        int read(t_file file, t_buffer buf, off64_t off, read_cb cb) noexcept override
+        {
+            // a negative offset reads from the current file position, which the cache cannot serve
+            if (off < 0)
+            {
+                return _inner.read(file, std::move(buf), off, std::move(cb));
+            }
+
+            auto len = buf.capacity();
+
+            return read_blocks(file, static_cast<uint64_t>(off), len,
+                               [buf = std::move(buf), cb = std::move(cb)](t_file &file, int err,
+                                                                          vfs::buffer_chain &chain) mutable
+            {
+                uint64_t n = 0;
+
+                for (auto &slice : chain)
+                {
+                    std::memcpy(buf.data() + n, slice.data(), slice.size());
+
+                    n += slice.size();
+                }
+
+                buf.truncate(n);
+                cb(file, err, buf);
+            });
+        }
+
+        int write(t_file file, t_buffer buf, off64_t off, write_cb cb) noexcept override
+        {
+            invalidate_fd(file.fd());
+
+            return _inner.write(file, std::move(buf), off, [this, cb = std::move(cb)](t_file &file, int err,
+                                                                                      t_buffer &buf) mutable
+            {
+                invalidate_fd(file.fd());
+
+                cb(file, err, buf);
+            });
+        }
+
+        int writev(t_file file, std::vector<t_buffer> bufs, off64_t off, writev_cb cb) noexcept override
+        {
+            invalidate_fd(file.fd());
+
+            return _inner.writev(file, std::move(bufs), off, [this, cb = std::move(cb)](t_file &file, int err,
+                                                                                        auto &bufs) mutable
+            {
+                invalidate_fd(file.fd());
+
+                cb(file, err, bufs);
+            });
+        }
+
+        int truncate(t_file file, uint64_t size, truncate_cb cb) noexcept override
+        {
+            invalidate_fd(file.fd());
+
+            return _inner.truncate(file, size, [this, cb = std::move(cb)](t_file &file, int err,
+                                                                          uint64_t size) mutable
+            {
+                invalidate_fd(file.fd());
+
+                cb(file, err, size);
+            });
+        }
+
+        int close(t_file file, close_cb cb) noexcept override
+        {
+            _inodes.erase(file.fd());
+
+            return _inner.close(file, std::move(cb));
+        }
+    };
+}
+
+#endif
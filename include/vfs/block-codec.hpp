@@ -0,0 +1,176 @@
+#ifndef VFS_BLOCK_CODEC_HPP
+#define VFS_BLOCK_CODEC_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef VFS_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef VFS_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace vfs
+{
+    enum class block_codec_id : uint8_t
+    {
+        stored = 0,
+        lz4 = 1,
+        zstd = 2
+    };
+
+    class block_codec
+    {
+      public:
+
+        virtual ~block_codec() noexcept = default;
+
+        virtual uint8_t id() const noexcept = 0;
+
+        virtual std::size_t bound(std::size_t size) const noexcept = 0;
+
+        virtual int64_t compress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept = 0;
+
+        virtual int64_t decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept = 0;
+    };
+
+    class stored_codec :
+        public block_codec
+    {
+      public:
+
+        static const stored_codec &instance() noexcept
+        {
+            static const stored_codec codec;
+
+            return codec;
+        }
+
+        uint8_t id() const noexcept override
+        {
+            return static_cast<uint8_t>(block_codec_id::stored);
+        }
+
+        std::size_t bound(std::size_t size) const noexcept override
+        {
+            return size;
+        }
+
+        int64_t compress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            if (size > cap)
+            {
+                return -ENOBUFS;
+            }
+
+            std::memcpy(dst, src, size);
+
+            return static_cast<int64_t>(size);
+        }
+
+        int64_t decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            return compress(src, size, dst, cap);
+        }
+    };
+
+#ifdef VFS_HAVE_LZ4
+
+    class lz4_codec :
+        public block_codec
+    {
+      public:
+
+        static const lz4_codec &instance() noexcept
+        {
+            static const lz4_codec codec;
+
+            return codec;
+        }
+
+        uint8_t id() const noexcept override
+        {
+            return static_cast<uint8_t>(block_codec_id::lz4);
+        }
+
+        std::size_t bound(std::size_t size) const noexcept override
+        {
+            return static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(size)));
+        }
+
+        int64_t compress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            auto n = LZ4_compress_default(reinterpret_cast<const char *>(src), reinterpret_cast<char *>(dst),
+                                          static_cast<int>(size), static_cast<int>(cap));
+
+            return n > 0 ? n : -ENOBUFS;
+        }
+
+        int64_t decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            auto n = LZ4_decompress_safe(reinterpret_cast<const char *>(src), reinterpret_cast<char *>(dst),
+                                         static_cast<int>(size), static_cast<int>(cap));
+
+            return n >= 0 ? n : -EBADMSG;
+        }
+    };
+
+#endif
+
+#ifdef VFS_HAVE_ZSTD
+
+    class zstd_codec :
+        public block_codec
+    {
+      private:
+
+        int _level;
+
+      public:
+
+        static const int default_level = 3;
+
+        explicit zstd_codec(int level = default_level) noexcept
+            : _level(level)
+        {}
+
+        static const zstd_codec &instance() noexcept
+        {
+            static const zstd_codec codec;
+
+            return codec;
+        }
+
+        uint8_t id() const noexcept override
+        {
+            return static_cast<uint8_t>(block_codec_id::zstd);
+        }
+
+        std::size_t bound(std::size_t size) const noexcept override
+        {
+            return ZSTD_compressBound(size);
+        }
+
+        int64_t compress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            auto n = ZSTD_compress(dst, cap, src, size, _level);
+
+            return ZSTD_isError(n) ? -ENOBUFS : static_cast<int64_t>(n);
+        }
+
+        int64_t decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            auto n = ZSTD_decompress(dst, cap, src, size);
+
+            return ZSTD_isError(n) ? -EBADMSG : static_cast<int64_t>(n);
+        }
+    };
+
+#endif
+}
+
+#endif
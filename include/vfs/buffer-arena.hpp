@@ -0,0 +1,286 @@
+#ifndef VFS_BUFFER_ARENA_HPP
+#define VFS_BUFFER_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <vfs/buffer.hpp>
+
+namespace vfs
+{
+    enum class buffer_arena_pages : uint8_t
+    {
+        normal,
+        transparent_huge,
+        huge
+    };
+
+    struct buffer_arena_options
+    {
+        static const std::size_t default_region_size = 64 * 1024 * 1024;
+
+        std::size_t region_size = default_region_size;
+        buffer_arena_pages pages = buffer_arena_pages::transparent_huge;
+        int numa_node = -1;
+    };
+
+    struct buffer_arena_stats
+    {
+        std::size_t regions;
+        std::size_t huge_regions;
+        std::size_t bind_failures;
+        uint64_t mapped_bytes;
+        uint64_t used_bytes;
+        uint64_t live;
+    };
+
+    class buffer_arena :
+        public buffer_source
+    {
+      public:
+
+        static const std::size_t huge_page_size = 2 * 1024 * 1024;
+        static const std::size_t alignment = 64;
+
+      private:
+
+        struct region
+        {
+            uint8_t *base;
+            std::size_t size;
+            std::size_t used;
+        };
+
+        buffer_arena_options _options;
+
+        std::mutex _mutex;
+        std::vector<region> _regions;
+        std::size_t _current;
+
+        std::size_t _huge_regions;
+        std::size_t _bind_failures;
+
+        std::atomic<uint64_t> _live;
+
+        static std::size_t round_up(std::size_t n, std::size_t to) noexcept
+        {
+            return (n + to - 1) / to * to;
+        }
+
+        void *map(std::size_t size, bool &huge) noexcept
+        {
+            void *ptr = MAP_FAILED;
+
+            huge = false;
+
+            if (_options.pages == buffer_arena_pages::huge)
+            {
+                ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+                huge = ptr != MAP_FAILED;
+            }
+
+            if (ptr == MAP_FAILED)
+            {
+                ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+                if (ptr == MAP_FAILED)
+                {
+                    return nullptr;
+                }
+
+                if (_options.pages != buffer_arena_pages::normal)
+                {
+                    ::madvise(ptr, size, MADV_HUGEPAGE);
+                }
+            }
+
+            if (_options.numa_node >= 0 && !bind(ptr, size))
+            {
+                ++_bind_failures;
+            }
+
+            return ptr;
+        }
+
+        bool bind(void *ptr, std::size_t size) const noexcept
+        {
+            const std::size_t bits = 8 * sizeof(unsigned long);
+
+            auto node = static_cast<std::size_t>(_options.numa_node);
+
+            std::vector<unsigned long> mask;
+
+            try
+            {
+                mask.resize(node / bits + 1, 0);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return false;
+            }
+
+            mask[node / bits] |= 1UL << (node % bits);
+
+            return ::syscall(SYS_mbind, ptr, size, MPOL_BIND, mask.data(), mask.size() * bits + 1, 0) == 0;
+        }
+
+        uint8_t *allocate(std::size_t size)
+        {
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            for (; _current < _regions.size(); ++_current)
+            {
+                auto &r = _regions[_current];
+
+                if (r.size - r.used >= size)
+                {
+                    auto ptr = r.base + r.used;
+
+                    r.used += size;
+                    ++_live;
+
+                    return ptr;
+                }
+            }
+
+            auto region_size = round_up(std::max(size, _options.region_size), huge_page_size);
+
+            bool huge;
+
+            auto base = static_cast<uint8_t *>(map(region_size, huge));
+
+            if (base == nullptr)
+            {
+                throw std::bad_alloc {};
+            }
+
+            try
+            {
+                _regions.push_back(region {base, region_size, size});
+            }
+            catch (...)
+            {
+                ::munmap(base, region_size);
+                throw;
+            }
+
+            _huge_regions += huge ? 1 : 0;
+            _current = _regions.size() - 1;
+            ++_live;
+
+            return base;
+        }
+
+      public:
+
+        explicit buffer_arena(buffer_arena_options options = buffer_arena_options {}) noexcept
+            : _options(options), _current(0), _huge_regions(0), _bind_failures(0), _live(0)
+        {}
+
+        buffer_arena(const buffer_arena &lhs) = delete;
+
+        buffer_arena &operator=(const buffer_arena &lhs) = delete;
+
+        // buffers point straight into the arena's regions, so every one of them must be released
+        // before the arena is destroyed
+        ~buffer_arena() noexcept override
+        {
+            assert(_live == 0);
+
+            for (auto &r : _regions)
+            {
+                ::munmap(r.base, r.size);
+            }
+        }
+
+        buffer acquire(uint64_t capacity)
+        {
+            auto ptr = allocate(round_up(capacity > 0 ? capacity : 1, alignment));
+
+            return buffer {buffer::ptr_type {ptr, buffer_deleter {this, 0}}, capacity};
+        }
+
+        void release(uint8_t *, uint64_t) noexcept override
+        {
+            --_live;
+        }
+
+        int reset() noexcept
+        {
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            if (_live > 0)
+            {
+                return -EBUSY;
+            }
+
+            for (auto &r : _regions)
+            {
+                r.used = 0;
+            }
+
+            _current = 0;
+
+            return 0;
+        }
+
+        int trim() noexcept
+        {
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            if (_live > 0)
+            {
+                return -EBUSY;
+            }
+
+            for (auto &r : _regions)
+            {
+                ::munmap(r.base, r.size);
+            }
+
+            _regions.clear();
+            _current = 0;
+            _huge_regions = 0;
+
+            return 0;
+        }
+
+        buffer_arena_stats stats() noexcept
+        {
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            buffer_arena_stats stats {
+                .regions = _regions.size(),
+                .huge_regions = _huge_regions,
+                .bind_failures = _bind_failures,
+                .mapped_bytes = 0,
+                .used_bytes = 0,
+                .live = _live.load()
+            };
+
+            for (auto &r : _regions)
+            {
+                stats.mapped_bytes += r.size;
+                stats.used_bytes += r.used;
+            }
+
+            return stats;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,282 @@
+#ifndef VFS_BUFFER_CHAIN_HPP
+#define VFS_BUFFER_CHAIN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <vfs/buffer.hpp>
+
+namespace vfs
+{
+    class buffer_slice
+    {
+      private:
+
+        std::shared_ptr<vfs::buffer> _owner;
+        uint8_t *_ptr;
+        uint64_t _size;
+
+        buffer_slice(std::shared_ptr<vfs::buffer> owner, uint8_t *ptr, uint64_t size) noexcept
+            : _owner(std::move(owner)), _ptr(ptr), _size(size)
+        {}
+
+      public:
+
+        buffer_slice() noexcept
+            : _owner(), _ptr(nullptr), _size(0)
+        {}
+
+        explicit buffer_slice(vfs::buffer &&buf)
+            : buffer_slice(std::move(buf), buf.size())
+        {}
+
+        explicit buffer_slice(vfs::buffer &&buf, uint64_t size)
+            : _owner(std::make_shared<vfs::buffer>(std::move(buf))),
+              _ptr(_owner->data()), _size(std::min(size, _owner->capacity()))
+        {}
+
+        inline uint64_t size() const noexcept
+        {
+            return _size;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        inline uint8_t *data() const noexcept
+        {
+            return _ptr;
+        }
+
+        inline const uint8_t *begin() const noexcept
+        {
+            return _ptr;
+        }
+
+        inline const uint8_t *end() const noexcept
+        {
+            return _ptr + _size;
+        }
+
+        inline long use_count() const noexcept
+        {
+            return _owner.use_count();
+        }
+
+        buffer_slice slice(uint64_t off, uint64_t len) const noexcept
+        {
+            off = std::min(off, _size);
+            len = std::min(len, _size - off);
+
+            return buffer_slice {_owner, _ptr + off, len};
+        }
+
+        void truncate(uint64_t size) noexcept
+        {
+            _size = std::min(size, _size);
+        }
+
+        void advance(uint64_t n) noexcept
+        {
+            n = std::min(n, _size);
+
+            _ptr += n;
+            _size -= n;
+        }
+    };
+
+    class buffer_chain
+    {
+      private:
+
+        std::vector<buffer_slice> _slices;
+        uint64_t _size;
+
+      public:
+
+        buffer_chain() noexcept
+            : _slices(), _size(0)
+        {}
+
+        explicit buffer_chain(buffer_slice slice)
+            : buffer_chain()
+        {
+            append(std::move(slice));
+        }
+
+        buffer_chain(const buffer_chain &lhs) = delete;
+
+        buffer_chain(buffer_chain &&rhs) noexcept
+            : _slices(std::move(rhs._slices)), _size(rhs._size)
+        {
+            rhs._size = 0;
+        }
+
+        buffer_chain &operator=(const buffer_chain &lhs) = delete;
+
+        buffer_chain &operator=(buffer_chain &&rhs) noexcept
+        {
+            _slices = std::move(rhs._slices);
+            _size = rhs._size;
+
+            rhs._size = 0;
+
+            return *this;
+        }
+
+        inline uint64_t size() const noexcept
+        {
+            return _size;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        inline std::size_t count() const noexcept
+        {
+            return _slices.size();
+        }
+
+        inline const buffer_slice &operator[](std::size_t i) const noexcept
+        {
+            return _slices[i];
+        }
+
+        inline std::vector<buffer_slice>::const_iterator begin() const noexcept
+        {
+            return _slices.begin();
+        }
+
+        inline std::vector<buffer_slice>::const_iterator end() const noexcept
+        {
+            return _slices.end();
+        }
+
+        buffer_chain &append(buffer_slice slice)
+        {
+            if (!slice.empty())
+            {
+                _size += slice.size();
+                _slices.emplace_back(std::move(slice));
+            }
+
+            return *this;
+        }
+
+        buffer_chain &append(vfs::buffer &&buf)
+        {
+            return append(buffer_slice {std::move(buf)});
+        }
+
+        buffer_chain &append(buffer_chain &&chain)
+        {
+            for (auto &slice : chain._slices)
+            {
+                append(std::move(slice));
+            }
+
+            chain._slices.clear();
+            chain._size = 0;
+
+            return *this;
+        }
+
+        buffer_chain split(uint64_t n)
+        {
+            buffer_chain head;
+
+            std::size_t i = 0;
+
+            for (; i < _slices.size() && n > 0; ++i)
+            {
+                auto &slice = _slices[i];
+
+                if (slice.size() > n)
+                {
+                    head.append(slice.slice(0, n));
+                    slice.advance(n);
+
+                    _size -= n;
+                    break;
+                }
+
+                n -= slice.size();
+                _size -= slice.size();
+
+                head.append(std::move(slice));
+            }
+
+            _slices.erase(_slices.begin(), _slices.begin() + i);
+
+            return head;
+        }
+
+        void truncate(uint64_t size) noexcept
+        {
+            if (size >= _size)
+            {
+                return;
+            }
+
+            std::size_t i = 0;
+            uint64_t kept = 0;
+
+            for (; i < _slices.size() && kept < size; ++i)
+            {
+                auto &slice = _slices[i];
+
+                slice.truncate(size - kept);
+                kept += slice.size();
+            }
+
+            _slices.resize(i);
+            _size = size;
+        }
+
+        const buffer_slice &coalesce()
+        {
+            static const buffer_slice empty_slice;
+
+            if (_slices.empty())
+            {
+                return empty_slice;
+            }
+
+            if (_slices.size() > 1)
+            {
+                vfs::buffer buf {_size};
+
+                uint64_t off = 0;
+
+                for (auto &slice : _slices)
+                {
+                    std::memcpy(buf.data() + off, slice.data(), slice.size());
+
+                    off += slice.size();
+                }
+
+                buf.truncate(_size);
+
+                _slices.clear();
+                _slices.emplace_back(std::move(buf));
+            }
+
+            return _slices.front();
+        }
+
+        void clear() noexcept
+        {
+            _slices.clear();
+            _size = 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,441 @@
+#ifndef VFS_BUFFER_POOL_HPP
+#define VFS_BUFFER_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <vfs/buffer.hpp>
+
+namespace vfs
+{
+    struct buffer_pool_stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t releases;
+        uint64_t drops;
+        uint64_t cached_bytes;
+    };
+
+    class buffer_pool :
+        public buffer_source
+    {
+      public:
+
+        static const uint64_t min_class_size = 4 * 1024;
+        static const std::size_t class_count = 11;
+        static const uint64_t max_class_size = min_class_size << (class_count - 1);
+
+        static const uint64_t default_cap = 256 * 1024 * 1024;
+        static const std::size_t default_thread_cache_depth = 4;
+
+      private:
+
+        using free_list = std::vector<uint8_t *>;
+        using free_lists = std::array<free_list, class_count>;
+
+        struct thread_cache
+        {
+            std::thread::id owner;
+            std::mutex mutex;
+            free_lists lists;
+        };
+
+        struct thread_slot
+        {
+            uint64_t pool_id;
+            thread_cache *cache;
+        };
+
+        // buffers release through the anchor rather than the pool, so one that outlives the pool
+        // finds it detached and frees its memory instead of touching the destroyed pool; releases hold
+        // the anchor's lock shared, so detach waits for any that are already inside the pool
+        class anchor :
+            public buffer_source
+        {
+          private:
+
+            std::shared_mutex _lock;
+            buffer_pool *_pool;
+            std::atomic<uint64_t> _refs;
+
+          public:
+
+            explicit anchor(buffer_pool *pool) noexcept
+                : _lock(), _pool(pool), _refs(1)
+            {}
+
+            void retain() noexcept
+            {
+                _refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void unref() noexcept
+            {
+                if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+            void detach() noexcept
+            {
+                {
+                    std::unique_lock<std::shared_mutex> lock {_lock};
+
+                    _pool = nullptr;
+                }
+
+                unref();
+            }
+
+            void release(uint8_t *ptr, uint64_t tag) noexcept override
+            {
+                {
+                    std::shared_lock<std::shared_mutex> lock {_lock};
+
+                    if (_pool != nullptr)
+                    {
+                        _pool->release(ptr, tag);
+                    }
+                    else
+                    {
+                        delete[] ptr;
+                    }
+                }
+
+                unref();
+            }
+        };
+
+        static constexpr uint64_t unpooled = ~uint64_t {0};
+
+        uint64_t _id;
+        uint64_t _cap;
+        std::size_t _thread_cache_depth;
+        anchor *_anchor;
+
+        std::mutex _mutex;
+        free_lists _lists;
+        std::vector<std::unique_ptr<thread_cache>> _caches;
+
+        std::atomic<uint64_t> _cached_bytes;
+        std::atomic<uint64_t> _hits;
+        std::atomic<uint64_t> _misses;
+        std::atomic<uint64_t> _releases;
+        std::atomic<uint64_t> _drops;
+
+        static uint64_t next_id() noexcept
+        {
+            static std::atomic<uint64_t> id {0};
+
+            return ++id;
+        }
+
+        static std::size_t class_of(uint64_t capacity) noexcept
+        {
+            std::size_t cls = 0;
+
+            while ((min_class_size << cls) < capacity)
+            {
+                ++cls;
+            }
+
+            return cls;
+        }
+
+        static uint64_t class_size(std::size_t cls) noexcept
+        {
+            return min_class_size << cls;
+        }
+
+        thread_cache *local_cache() noexcept
+        {
+            thread_local thread_slot slot {0, nullptr};
+
+            if (slot.pool_id == _id)
+            {
+                return slot.cache;
+            }
+
+            auto owner = std::this_thread::get_id();
+
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            for (auto &cache : _caches)
+            {
+                if (cache->owner == owner)
+                {
+                    slot = thread_slot {_id, cache.get()};
+
+                    return slot.cache;
+                }
+            }
+
+            try
+            {
+                std::unique_ptr<thread_cache> cache {new thread_cache};
+
+                cache->owner = owner;
+
+                for (auto &list : cache->lists)
+                {
+                    list.reserve(_thread_cache_depth);
+                }
+
+                _caches.emplace_back(std::move(cache));
+            }
+            catch (const std::bad_alloc &)
+            {
+                return nullptr;
+            }
+
+            slot = thread_slot {_id, _caches.back().get()};
+
+            return slot.cache;
+        }
+
+        bool reserve(uint64_t size) noexcept
+        {
+            auto cached = _cached_bytes.load(std::memory_order_relaxed);
+
+            do
+            {
+                if (cached + size > _cap)
+                {
+                    return false;
+                }
+            }
+            while (!_cached_bytes.compare_exchange_weak(cached, cached + size, std::memory_order_relaxed));
+
+            return true;
+        }
+
+        uint8_t *take(std::size_t cls) noexcept
+        {
+            uint8_t *ptr = nullptr;
+
+            auto cache = local_cache();
+
+            if (cache != nullptr)
+            {
+                std::lock_guard<std::mutex> lock {cache->mutex};
+
+                auto &list = cache->lists[cls];
+
+                if (!list.empty())
+                {
+                    ptr = list.back();
+                    list.pop_back();
+                }
+            }
+
+            if (ptr == nullptr)
+            {
+                std::lock_guard<std::mutex> lock {_mutex};
+
+                auto &list = _lists[cls];
+
+                if (!list.empty())
+                {
+                    ptr = list.back();
+                    list.pop_back();
+                }
+
+                for (auto it = _caches.begin(); ptr == nullptr && it != _caches.end(); ++it)
+                {
+                    if (it->get() == cache)
+                    {
+                        continue;
+                    }
+
+                    std::lock_guard<std::mutex> cache_lock {(*it)->mutex};
+
+                    auto &other = (*it)->lists[cls];
+
+                    if (!other.empty())
+                    {
+                        ptr = other.back();
+                        other.pop_back();
+                    }
+                }
+            }
+
+            if (ptr != nullptr)
+            {
+                _cached_bytes -= class_size(cls);
+            }
+
+            return ptr;
+        }
+
+        bool give(std::size_t cls, uint8_t *ptr) noexcept
+        {
+            if (!reserve(class_size(cls)))
+            {
+                return false;
+            }
+
+            auto cache = local_cache();
+
+            if (cache != nullptr)
+            {
+                std::lock_guard<std::mutex> lock {cache->mutex};
+
+                auto &list = cache->lists[cls];
+
+                if (list.size() < _thread_cache_depth)
+                {
+                    list.push_back(ptr);
+                    return true;
+                }
+            }
+
+            try
+            {
+                std::lock_guard<std::mutex> lock {_mutex};
+
+                _lists[cls].push_back(ptr);
+            }
+            catch (const std::bad_alloc &)
+            {
+                _cached_bytes -= class_size(cls);
+
+                return false;
+            }
+
+            return true;
+        }
+
+        static void free_all(free_lists &lists) noexcept
+        {
+            for (auto &list : lists)
+            {
+                for (auto ptr : list)
+                {
+                    delete[] ptr;
+                }
+
+                list.clear();
+            }
+        }
+
+      public:
+
+        explicit buffer_pool(uint64_t cap = default_cap,
+                             std::size_t thread_cache_depth = default_thread_cache_depth)
+            : _id(next_id()), _cap(cap), _thread_cache_depth(thread_cache_depth), _anchor(new anchor {this}),
+              _cached_bytes(0), _hits(0), _misses(0), _releases(0), _drops(0)
+        {}
+
+        buffer_pool(const buffer_pool &lhs) = delete;
+
+        buffer_pool &operator=(const buffer_pool &lhs) = delete;
+
+        ~buffer_pool() noexcept override
+        {
+            _anchor->detach();
+
+            for (auto &cache : _caches)
+            {
+                free_all(cache->lists);
+            }
+
+            free_all(_lists);
+        }
+
+        buffer acquire(uint64_t capacity)
+        {
+            if (capacity > max_class_size)
+            {
+                ++_misses;
+
+                buffer::ptr_type ptr {new uint8_t[capacity], buffer_deleter {_anchor, unpooled}};
+
+                _anchor->retain();
+
+                return buffer {std::move(ptr), capacity};
+            }
+
+            auto cls = class_of(capacity);
+            auto ptr = take(cls);
+
+            if (ptr != nullptr)
+            {
+                ++_hits;
+            }
+            else
+            {
+                ++_misses;
+
+                ptr = new uint8_t[class_size(cls)];
+            }
+
+            _anchor->retain();
+
+            return buffer {buffer::ptr_type {ptr, buffer_deleter {_anchor, cls}}, capacity};
+        }
+
+        void release(uint8_t *ptr, uint64_t tag) noexcept override
+        {
+            ++_releases;
+
+            if (tag == unpooled || !give(static_cast<std::size_t>(tag), ptr))
+            {
+                ++_drops;
+
+                delete[] ptr;
+            }
+        }
+
+        void trim() noexcept
+        {
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            for (auto &cache : _caches)
+            {
+                std::lock_guard<std::mutex> cache_lock {cache->mutex};
+
+                for (std::size_t cls = 0; cls < class_count; ++cls)
+                {
+                    _cached_bytes -= class_size(cls) * cache->lists[cls].size();
+                }
+
+                free_all(cache->lists);
+            }
+
+            for (std::size_t cls = 0; cls < class_count; ++cls)
+            {
+                _cached_bytes -= class_size(cls) * _lists[cls].size();
+            }
+
+            free_all(_lists);
+        }
+
+        inline uint64_t cap() const noexcept
+        {
+            return _cap;
+        }
+
+        inline buffer_pool_stats stats() const noexcept
+        {
+            return buffer_pool_stats {
+                .hits = _hits.load(),
+                .misses = _misses.load(),
+                .releases = _releases.load(),
+                .drops = _drops.load(),
+                .cached_bytes = _cached_bytes.load()
+            };
+        }
+    };
+}
+
+#endif
@@ -4,36 +4,98 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <new>
 
 namespace vfs
 {
     template<typename t_mem>
     using enable_if_not_pointer = std::enable_if_t<!std::is_pointer<t_mem>::value>;
 
+    class buffer_source
+    {
+      public:
+
+        virtual ~buffer_source() noexcept = default;
+
+        virtual void release(uint8_t *ptr, uint64_t tag) noexcept = 0;
+    };
+
+    struct buffer_deleter
+    {
+        buffer_source *source = nullptr;
+        uint64_t tag = 0;
+
+        void operator()(uint8_t *ptr) const noexcept
+        {
+            if (source != nullptr)
+            {
+                source->release(ptr, tag);
+            }
+            else
+            {
+                delete[] ptr;
+            }
+        }
+    };
+
+    class aligned_buffer_source :
+        public buffer_source
+    {
+      public:
+
+        static aligned_buffer_source &instance() noexcept
+        {
+            static aligned_buffer_source source;
+
+            return source;
+        }
+
+        void release(uint8_t *ptr, uint64_t tag) noexcept override
+        {
+            ::operator delete[](ptr, std::align_val_t {static_cast<std::size_t>(tag)});
+        }
+    };
+
     class buffer
     {
+      public:
+
+        using ptr_type = std::unique_ptr<uint8_t[], buffer_deleter>;
+
       private:
         uint64_t _size;
         uint64_t _capacity;
-        std::unique_ptr<uint8_t[]> _ptr;
+        ptr_type _ptr;
 
       public:
         explicit buffer()
-            : _size(0), _capacity(0), _ptr(std::unique_ptr<uint8_t[]>{nullptr})
+            : _size(0), _capacity(0), _ptr(nullptr)
         {}
 
         explicit buffer(uint64_t capacity)
-            : _size(0), _capacity(capacity), _ptr(std::make_unique<uint8_t[]>(capacity))
+            : _size(0), _capacity(capacity), _ptr(std::make_unique<uint8_t[]>(capacity).release())
         {}
 
         explicit buffer(std::unique_ptr<uint8_t[]> &&ptr, uint64_t capacity)
-            : _size(0), _capacity(capacity), _ptr(std::move(ptr))
+            : _size(0), _capacity(capacity), _ptr(ptr.release())
         {}
 
         explicit buffer(std::unique_ptr<uint8_t[]> &&ptr, uint64_t size, uint64_t capacity)
-            : _size(size), _capacity(capacity), _ptr(std::move(ptr))
+            : _size(size), _capacity(capacity), _ptr(ptr.release())
         {}
 
+        explicit buffer(ptr_type &&ptr, uint64_t capacity)
+            : _size(0), _capacity(capacity), _ptr(std::move(ptr))
+        {}
+
+        static buffer aligned(uint64_t capacity, std::size_t alignment)
+        {
+            auto size = (capacity + alignment - 1) / alignment * alignment;
+            auto ptr = new(std::align_val_t {alignment}) uint8_t[size > 0 ? size : alignment];
+
+            return buffer {ptr_type {ptr, buffer_deleter {&aligned_buffer_source::instance(), alignment}}, capacity};
+        }
+
         buffer(const buffer &lhs) = delete;
 
         buffer(buffer &&rhs) noexcept
@@ -61,6 +123,11 @@ namespace vfs
             return _capacity;
         }
 
+        bool is_aligned(std::size_t alignment)
+        {
+            return reinterpret_cast<uintptr_t>(_ptr.get()) % alignment == 0;
+        }
+
         template<typename t_data>
         t_data *data()
         {
@@ -0,0 +1,202 @@
+#ifndef VFS_CALLBACK_HPP
+#define VFS_CALLBACK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef VFS_CALLBACK_INLINE_SIZE
+#define VFS_CALLBACK_INLINE_SIZE 48
+#endif
+
+namespace vfs
+{
+    template<typename t_signature, std::size_t t_size = VFS_CALLBACK_INLINE_SIZE>
+    class callback;
+
+    template<typename t_result, typename... t_args, std::size_t t_size>
+    class callback<t_result(t_args...), t_size>
+    {
+      private:
+
+        struct ops
+        {
+            t_result (*invoke)(void *, t_args &&...);
+            void (*move)(void *, void *) noexcept;
+            void (*destroy)(void *) noexcept;
+            bool is_inline;
+        };
+
+        template<typename t_fn>
+        struct inline_ops
+        {
+            static t_result invoke(void *storage, t_args &&... args)
+            {
+                return (*static_cast<t_fn *>(storage))(std::forward<t_args>(args)...);
+            }
+
+            static void move(void *dst, void *src) noexcept
+            {
+                new(dst) t_fn {std::move(*static_cast<t_fn *>(src))};
+                static_cast<t_fn *>(src)->~t_fn();
+            }
+
+            static void destroy(void *storage) noexcept
+            {
+                static_cast<t_fn *>(storage)->~t_fn();
+            }
+
+            static const ops *get() noexcept
+            {
+                static constexpr ops value {&invoke, &move, &destroy, true};
+                return &value;
+            }
+        };
+
+        template<typename t_fn>
+        struct heap_ops
+        {
+            static t_result invoke(void *storage, t_args &&... args)
+            {
+                return (**static_cast<t_fn **>(storage))(std::forward<t_args>(args)...);
+            }
+
+            static void move(void *dst, void *src) noexcept
+            {
+                *static_cast<t_fn **>(dst) = *static_cast<t_fn **>(src);
+            }
+
+            static void destroy(void *storage) noexcept
+            {
+                delete *static_cast<t_fn **>(storage);
+            }
+
+            static const ops *get() noexcept
+            {
+                static constexpr ops value {&invoke, &move, &destroy, false};
+                return &value;
+            }
+        };
+
+        template<typename t_fn>
+        using enable_if_fn = std::enable_if_t<
+            !std::is_same<std::decay_t<t_fn>, callback>::value &&
+            !std::is_same<std::decay_t<t_fn>, std::nullptr_t>::value>;
+
+        alignas(std::max_align_t) mutable unsigned char _storage[t_size];
+        const ops *_ops;
+
+      public:
+
+        template<typename t_fn>
+        static constexpr bool fits_inline()
+        {
+            return sizeof(t_fn) <= t_size &&
+                   alignof(t_fn) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible<t_fn>::value;
+        }
+
+        callback() noexcept
+            : _ops(nullptr)
+        {}
+
+        callback(std::nullptr_t) noexcept
+            : _ops(nullptr)
+        {}
+
+        template<typename t_fn, typename = enable_if_fn<t_fn>>
+        callback(t_fn &&fn)
+        {
+            using fn_t = std::decay_t<t_fn>;
+
+            emplace(std::forward<t_fn>(fn), std::integral_constant<bool, fits_inline<fn_t>()> {});
+        }
+
+        callback(const callback &lhs) = delete;
+
+        callback(callback &&rhs) noexcept
+            : _ops(rhs._ops)
+        {
+            if (_ops != nullptr)
+            {
+                _ops->move(_storage, rhs._storage);
+                rhs._ops = nullptr;
+            }
+        }
+
+        callback &operator=(const callback &lhs) = delete;
+
+        callback &operator=(callback &&rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                reset();
+
+                if (rhs._ops != nullptr)
+                {
+                    _ops = rhs._ops;
+                    _ops->move(_storage, rhs._storage);
+                    rhs._ops = nullptr;
+                }
+            }
+
+            return *this;
+        }
+
+        ~callback() noexcept
+        {
+            reset();
+        }
+
+        inline explicit operator bool() const noexcept
+        {
+            return _ops != nullptr;
+        }
+
+        inline t_result operator()(t_args... args) const
+        {
+            return _ops->invoke(_storage, std::forward<t_args>(args)...);
+        }
+
+        inline bool is_inline() const noexcept
+        {
+            return _ops == nullptr || _ops->is_inline;
+        }
+
+      private:
+
+        template<typename t_fn>
+        inline void emplace(t_fn &&fn, std::true_type)
+        {
+            using fn_t = std::decay_t<t_fn>;
+
+            new(_storage) fn_t {std::forward<t_fn>(fn)};
+            _ops = inline_ops<fn_t>::get();
+        }
+
+        template<typename t_fn>
+        inline void emplace(t_fn &&fn, std::false_type)
+        {
+            using fn_t = std::decay_t<t_fn>;
+
+            *reinterpret_cast<fn_t **>(_storage) = new fn_t {std::forward<t_fn>(fn)};
+            _ops = heap_ops<fn_t>::get();
+        }
+
+        inline void reset() noexcept
+        {
+            if (_ops != nullptr)
+            {
+                _ops->destroy(_storage);
+                _ops = nullptr;
+            }
+        }
+    };
+
+    template<typename t_callback, typename t_fn>
+    using fits_inline_callback = std::integral_constant<bool,
+        t_callback::template fits_inline<std::decay_t<t_fn>>()>;
+}
+
+#endif
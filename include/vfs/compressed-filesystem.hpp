@@ -0,0 +1,841 @@
+#ifndef VFS_COMPRESSED_FILESYSTEM_HPP
+#define VFS_COMPRESSED_FILESYSTEM_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#include <vfs/block-codec.hpp>
+#include <vfs/callback.hpp>
+#include <vfs/crc32c.hpp>
+#include <vfs/filesystem-proxy.hpp>
+
+namespace vfs
+{
+    struct compressed_block_header
+    {
+        uint32_t raw_len;
+        uint32_t stored_len;
+        uint32_t crc;
+        uint8_t codec;
+        uint8_t reserved[3];
+    };
+
+    struct compressed_block_entry
+    {
+        uint64_t raw_off;
+        uint64_t file_off;
+    };
+
+    struct compressed_block_footer
+    {
+        uint64_t blocks;
+        uint64_t raw_size;
+        uint32_t block_size;
+        uint32_t magic;
+    };
+
+    struct compressed_filesystem_stats
+    {
+        uint64_t raw_bytes_written;
+        uint64_t stored_bytes_written;
+        uint64_t blocks_written;
+        uint64_t blocks_uncompressed;
+        uint64_t blocks_read;
+    };
+
+    using block_work = vfs::callback<void(), 128>;
+    using block_done = vfs::callback<void(), 128>;
+    using block_executor = vfs::callback<int(block_work, block_done)>;
+
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class compressed_filesystem :
+        public filesystem_proxy<t_path, t_stat, t_file, t_buffer>
+    {
+
+      public:
+
+        using proxy_type = filesystem_proxy<t_path, t_stat, t_file, t_buffer>;
+
+        using typename proxy_type::filesystem_type;
+        using typename proxy_type::open_cb;
+        using typename proxy_type::read_cb;
+        using typename proxy_type::write_cb;
+        using typename proxy_type::readv_cb;
+        using typename proxy_type::writev_cb;
+        using typename proxy_type::truncate_cb;
+        using typename proxy_type::close_cb;
+        using typename proxy_type::map_cb;
+
+        static const uint32_t magic = 0x315a4656;
+        static const std::size_t default_block_size = 64 * 1024;
+
+      private:
+
+        struct block_index
+        {
+            std::vector<compressed_block_entry> entries;
+            uint64_t raw_size;
+            uint64_t data_end;
+            bool writing;
+        };
+
+        struct read_job
+        {
+            t_buffer buf;
+            read_cb cb;
+            uint64_t off;
+            uint64_t len;
+            uint64_t phys_off;
+            std::vector<compressed_block_entry> entries;
+            t_buffer phys;
+            int result;
+        };
+
+        struct write_job
+        {
+            t_buffer buf;
+            write_cb cb;
+            uint64_t raw_off;
+            uint64_t data_end;
+            std::size_t trailer;
+            std::vector<compressed_block_entry> entries;
+            t_buffer out;
+            uint64_t uncompressed;
+            int result;
+        };
+
+        using proxy_type::_inner;
+
+        const block_codec &_codec;
+        std::size_t _block_size;
+        block_executor _executor;
+
+        std::unordered_map<uint64_t, block_index> _indexes;
+        compressed_filesystem_stats _stats;
+
+        static std::size_t block_of(const std::vector<compressed_block_entry> &entries, uint64_t off) noexcept
+        {
+            auto it = std::upper_bound(entries.begin(), entries.end(), off,
+                                       [](uint64_t off, const compressed_block_entry &entry)
+            {
+                return off < entry.raw_off;
+            });
+
+            return static_cast<std::size_t>(it - entries.begin()) - 1;
+        }
+
+        int submit(block_work work, block_done done) noexcept
+        {
+            return _executor(std::move(work), std::move(done));
+        }
+
+        int decode(read_job &job) const noexcept
+        {
+            auto *phys = job.phys.data();
+            auto phys_len = job.phys.size();
+            auto end = job.off + job.len;
+
+            std::vector<uint8_t> scratch;
+
+            for (auto &entry : job.entries)
+            {
+                auto at = entry.file_off - job.phys_off;
+
+                compressed_block_header header;
+
+                if (at + sizeof(header) > phys_len)
+                {
+                    return -EBADMSG;
+                }
+
+                std::memcpy(&header, phys + at, sizeof(header));
+
+                auto *payload = phys + at + sizeof(header);
+
+                if (at + sizeof(header) + header.stored_len > phys_len ||
+                    crc32c(payload, header.stored_len) != header.crc)
+                {
+                    return -EBADMSG;
+                }
+
+                auto from = std::max(job.off, entry.raw_off);
+                auto to = std::min(end, entry.raw_off + header.raw_len);
+
+                if (from >= to)
+                {
+                    continue;
+                }
+
+                auto *out = job.buf.data() + (from - job.off);
+
+                if (header.codec == static_cast<uint8_t>(block_codec_id::stored))
+                {
+                    if (header.stored_len != header.raw_len)
+                    {
+                        return -EBADMSG;
+                    }
+
+                    std::memcpy(out, payload + (from - entry.raw_off), to - from);
+
+                    continue;
+                }
+
+                if (header.codec != _codec.id())
+                {
+                    return -ENOTSUP;
+                }
+
+                auto whole = from == entry.raw_off && to == entry.raw_off + header.raw_len;
+
+                if (!whole)
+                {
+                    try
+                    {
+                        scratch.resize(header.raw_len);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return -ENOMEM;
+                    }
+                }
+
+                auto *raw = whole ? out : scratch.data();
+                auto n = _codec.decompress(payload, header.stored_len, raw, header.raw_len);
+
+                if (n != header.raw_len)
+                {
+                    return n < 0 ? static_cast<int>(n) : -EBADMSG;
+                }
+
+                if (!whole)
+                {
+                    std::memcpy(out, raw + (from - entry.raw_off), to - from);
+                }
+            }
+
+            return 0;
+        }
+
+        int encode(write_job &job) const noexcept
+        {
+            auto size = job.buf.size();
+            auto blocks = (size + _block_size - 1) / _block_size;
+            auto bound = std::max(_codec.bound(_block_size), _block_size) + sizeof(compressed_block_header);
+
+            try
+            {
+                job.out = t_buffer {blocks * bound + job.trailer + 1};
+                job.entries.reserve(blocks);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return -ENOMEM;
+            }
+
+            auto *dst = job.out.data();
+            uint64_t pos = 0;
+
+            for (uint64_t raw = 0; raw < size; raw += _block_size)
+            {
+                auto len = std::min<uint64_t>(_block_size, size - raw);
+                auto *src = job.buf.data() + raw;
+                auto *payload = dst + pos + sizeof(compressed_block_header);
+
+                compressed_block_header header {
+                    .raw_len = static_cast<uint32_t>(len),
+                    .stored_len = 0,
+                    .crc = 0,
+                    .codec = _codec.id(),
+                    .reserved = {0, 0, 0}
+                };
+
+                auto n = _codec.compress(src, len, payload, bound - sizeof(header));
+
+                if (n <= 0 || static_cast<uint64_t>(n) >= len)
+                {
+                    std::memcpy(payload, src, len);
+
+                    n = static_cast<int64_t>(len);
+                    header.codec = static_cast<uint8_t>(block_codec_id::stored);
+
+                    ++job.uncompressed;
+                }
+
+                header.stored_len = static_cast<uint32_t>(n);
+                header.crc = crc32c(payload, header.stored_len);
+
+                std::memcpy(dst + pos, &header, sizeof(header));
+
+                job.entries.push_back(compressed_block_entry {
+                    .raw_off = job.raw_off + raw,
+                    .file_off = job.data_end + pos
+                });
+
+                pos += sizeof(header) + header.stored_len;
+            }
+
+            job.out.truncate(pos);
+
+            return 0;
+        }
+
+        void fail_open(t_path path, int err, t_file &file, open_cb cb) noexcept
+        {
+            _inner.close(file, [](t_file &, int)
+            {});
+
+            cb(path, err, file);
+        }
+
+        void load_index(t_path path, t_file &file, uint64_t size, compressed_block_footer footer, open_cb cb) noexcept
+        {
+            // bound the block count by the file size before multiplying, so a corrupt footer can neither wrap
+            // the trailer size nor ask for an index larger than the file
+            if (footer.magic != magic || size < sizeof(footer) ||
+                footer.blocks > (size - sizeof(footer)) / sizeof(compressed_block_entry))
+            {
+                fail_open(path, EBADMSG, file, std::move(cb));
+
+                return;
+            }
+
+            auto trailer = footer.blocks * sizeof(compressed_block_entry) + sizeof(footer);
+
+            t_buffer buf;
+
+            try
+            {
+                buf = t_buffer {trailer - sizeof(footer)};
+            }
+            catch (const std::bad_alloc &)
+            {
+                fail_open(path, ENOMEM, file, std::move(cb));
+
+                return;
+            }
+
+            auto data_end = size - trailer;
+
+            auto result = _inner.read(file, std::move(buf), static_cast<off64_t>(data_end),
+                                      [this, path, data_end, footer, cb = std::move(cb)](t_file &file, int err,
+                                                                                         t_buffer &buf) mutable
+            {
+                if (err == 0 && buf.size() != footer.blocks * sizeof(compressed_block_entry))
+                {
+                    err = EBADMSG;
+                }
+
+                std::vector<compressed_block_entry> entries;
+
+                try
+                {
+                    entries.resize(footer.blocks);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    err = err != 0 ? err : ENOMEM;
+                }
+
+                if (err == 0)
+                {
+                    std::memcpy(entries.data(), buf.data(), buf.size());
+
+                    for (std::size_t i = 0; i < entries.size() && err == 0; ++i)
+                    {
+                        auto raw_end = i + 1 < entries.size() ? entries[i + 1].raw_off : footer.raw_size;
+                        auto file_end = i + 1 < entries.size() ? entries[i + 1].file_off : data_end;
+
+                        if (entries[i].raw_off >= raw_end || entries[i].file_off >= file_end)
+                        {
+                            err = EBADMSG;
+                        }
+                    }
+
+                    if (entries.empty() != (footer.raw_size == 0) || (!entries.empty() && entries[0].raw_off != 0))
+                    {
+                        err = EBADMSG;
+                    }
+                }
+
+                if (err != 0)
+                {
+                    fail_open(path, err, file, std::move(cb));
+
+                    return;
+                }
+
+                _indexes[file.fd()] = block_index {
+                    .entries = std::move(entries),
+                    .raw_size = footer.raw_size,
+                    .data_end = data_end,
+                    .writing = false
+                };
+
+                cb(path, 0, file);
+            });
+
+            if (result != 0)
+            {
+                fail_open(path, -result, file, std::move(cb));
+            }
+        }
+
+        void load(t_path path, t_file &file, open_cb cb) noexcept
+        {
+            auto result = _inner.stat(file, [this, path, cb = std::move(cb)](t_file &file, int err,
+                                                                             t_stat stat) mutable
+            {
+                if (err != 0)
+                {
+                    fail_open(path, err, file, std::move(cb));
+
+                    return;
+                }
+
+                auto size = stat.size();
+
+                if (size == 0)
+                {
+                    _indexes[file.fd()] = block_index {
+                        .entries = {},
+                        .raw_size = 0,
+                        .data_end = 0,
+                        .writing = false
+                    };
+
+                    cb(path, 0, file);
+
+                    return;
+                }
+
+                if (size < sizeof(compressed_block_footer))
+                {
+                    fail_open(path, EBADMSG, file, std::move(cb));
+
+                    return;
+                }
+
+                auto off = static_cast<off64_t>(size - sizeof(compressed_block_footer));
+
+                auto result = _inner.read(file, t_buffer {sizeof(compressed_block_footer)}, off,
+                                          [this, path, size, cb = std::move(cb)](t_file &file, int err,
+                                                                                 t_buffer &buf) mutable
+                {
+                    compressed_block_footer footer {};
+
+                    if (err == 0 && buf.size() != sizeof(footer))
+                    {
+                        err = EBADMSG;
+                    }
+
+                    if (err != 0)
+                    {
+                        fail_open(path, err, file, std::move(cb));
+
+                        return;
+                    }
+
+                    std::memcpy(&footer, buf.data(), sizeof(footer));
+
+                    load_index(path, file, size, footer, std::move(cb));
+                });
+
+                if (result != 0)
+                {
+                    fail_open(path, -result, file, std::move(cb));
+                }
+            });
+
+            if (result != 0)
+            {
+                fail_open(path, -result, file, std::move(cb));
+            }
+        }
+
+        void commit(t_file &file, std::unique_ptr<write_job> job) noexcept
+        {
+            auto &index = _indexes[file.fd()];
+
+            if (job->result != 0)
+            {
+                index.writing = false;
+                job->cb(file, -job->result, job->buf);
+
+                return;
+            }
+
+            auto frames = job->out.size();
+
+            compressed_block_footer footer {
+                .blocks = index.entries.size() + job->entries.size(),
+                .raw_size = index.raw_size + job->buf.size(),
+                .block_size = static_cast<uint32_t>(_block_size),
+                .magic = magic
+            };
+
+            if (!index.entries.empty())
+            {
+                job->out.put(index.entries.data(), index.entries.size() * sizeof(compressed_block_entry));
+            }
+
+            job->out.put(job->entries.data(), job->entries.size() * sizeof(compressed_block_entry));
+            job->out.put(footer);
+
+            auto expected = job->out.size();
+            auto *raw = job.release();
+
+            auto result = _inner.write(file, std::move(raw->out), static_cast<off64_t>(raw->data_end),
+                                       [this, frames, expected, raw](t_file &file, int err, t_buffer &out)
+            {
+                std::unique_ptr<write_job> job {raw};
+
+                auto &index = _indexes[file.fd()];
+
+                if (err == 0 && out.size() != expected)
+                {
+                    err = EIO;
+                }
+
+                if (err == 0)
+                {
+                    index.entries.insert(index.entries.end(), job->entries.begin(), job->entries.end());
+                    index.data_end += frames;
+                    index.raw_size += job->buf.size();
+
+                    _stats.raw_bytes_written += job->buf.size();
+                    _stats.stored_bytes_written += frames;
+                    _stats.blocks_written += job->entries.size();
+                    _stats.blocks_uncompressed += job->uncompressed;
+                }
+
+                index.writing = false;
+
+                job->cb(file, err, job->buf);
+            });
+
+            if (result != 0)
+            {
+                index.writing = false;
+                raw->cb(file, -result, raw->buf);
+                delete raw;
+            }
+        }
+
+      public:
+
+        // encode and decode run through the executor, so it must move them off the caller's loop thread
+        compressed_filesystem(filesystem_type &inner,
+                              block_executor executor,
+                              const block_codec &codec = stored_codec::instance(),
+                              std::size_t block_size = default_block_size) noexcept
+            : proxy_type(inner),
+              _codec(codec),
+              _block_size(std::clamp<std::size_t>(block_size, 512, UINT32_MAX / 2)),
+              _executor(std::move(executor)),
+              _stats {}
+        {
+            assert(_executor);
+        }
+
+        inline const block_codec &codec() const noexcept
+        {
+            return _codec;
+        }
+
+        inline std::size_t block_size() const noexcept
+        {
+            return _block_size;
+        }
+
+        inline compressed_filesystem_stats stats() const noexcept
+        {
+            return _stats;
+        }
+
+        int64_t size(const t_file &file) const noexcept
+        {
+            auto it = _indexes.find(file.fd());
+
+            return it == _indexes.end() ? -EBADF : static_cast<int64_t>(it->second.raw_size);
+        }
+
+        using proxy_type::open;
+
+        int open(t_path path, int32_t mode, int32_t flags, open_cb cb) noexcept override
+        {
+            flags &= ~O_APPEND;
+
+            if ((flags & O_ACCMODE) == O_WRONLY)
+            {
+                flags = (flags & ~O_ACCMODE) | O_RDWR;
+            }
+
+            return _inner.open(path, mode, flags, [this, cb = std::move(cb)](t_path &path, int err,
+                                                                             t_file &file) mutable
+            {
+                if (err != 0)
+                {
+                    cb(path, err, file);
+
+                    return;
+                }
+
+                load(path, file, std::move(cb));
+            });
+        }
+
+        int read(t_file file, t_buffer buf, off64_t off, read_cb cb) noexcept override
+        {
+            auto it = _indexes.find(file.fd());
+
+            if (it == _indexes.end())
+            {
+                return -EBADF;
+            }
+
+            if (off < 0)
+            {
+                return -EINVAL;
+            }
+
+            auto &index = it->second;
+            auto begin = static_cast<uint64_t>(off);
+
+            if (begin >= index.raw_size || buf.capacity() == 0)
+            {
+                buf.truncate(0);
+                cb(file, 0, buf);
+
+                return 0;
+            }
+
+            auto len = std::min<uint64_t>(buf.capacity(), index.raw_size - begin);
+            auto first = block_of(index.entries, begin);
+            auto last = block_of(index.entries, begin + len - 1);
+
+            auto phys_off = index.entries[first].file_off;
+            auto phys_end = last + 1 < index.entries.size() ? index.entries[last + 1].file_off : index.data_end;
+
+            std::unique_ptr<read_job> job;
+            t_buffer phys;
+
+            try
+            {
+                phys = t_buffer {phys_end - phys_off};
+
+                job.reset(new read_job {
+                    .buf = std::move(buf),
+                    .cb = std::move(cb),
+                    .off = begin,
+                    .len = len,
+                    .phys_off = phys_off,
+                    .entries = {index.entries.begin() + first, index.entries.begin() + last + 1},
+                    .phys = t_buffer {},
+                    .result = 0
+                });
+            }
+            catch (const std::bad_alloc &)
+            {
+                return -ENOMEM;
+            }
+
+            return _inner.read(file, std::move(phys), static_cast<off64_t>(phys_off),
+                               [this, job = std::move(job)](t_file &file, int err, t_buffer &phys) mutable
+            {
+                if (err == 0 && phys.size() != phys.capacity())
+                {
+                    err = EBADMSG;
+                }
+
+                if (err != 0)
+                {
+                    job->buf.truncate(0);
+                    job->cb(file, err, job->buf);
+
+                    return;
+                }
+
+                _stats.blocks_read += job->entries.size();
+
+                job->phys = std::move(phys);
+
+                auto *raw = job.release();
+
+                auto result = submit([this, raw]()
+                {
+                    raw->result = decode(*raw);
+                }, [raw, file]() mutable
+                {
+                    std::unique_ptr<read_job> job {raw};
+
+                    job->buf.truncate(job->result == 0 ? job->len : 0);
+                    job->cb(file, -job->result, job->buf);
+                });
+
+                if (result != 0)
+                {
+                    std::unique_ptr<read_job> job {raw};
+
+                    job->buf.truncate(0);
+                    job->cb(file, -result, job->buf);
+                }
+            });
+        }
+
+        int write(t_file file, t_buffer buf, off64_t off, write_cb cb) noexcept override
+        {
+            auto it = _indexes.find(file.fd());
+
+            if (it == _indexes.end())
+            {
+                return -EBADF;
+            }
+
+            auto &index = it->second;
+
+            if (index.writing)
+            {
+                return -EBUSY;
+            }
+
+            if (off >= 0 && static_cast<uint64_t>(off) != index.raw_size)
+            {
+                return -ENOTSUP;
+            }
+
+            if (buf.size() == 0)
+            {
+                cb(file, 0, buf);
+
+                return 0;
+            }
+
+            auto blocks = (buf.size() + _block_size - 1) / _block_size;
+
+            std::unique_ptr<write_job> job;
+
+            try
+            {
+                job.reset(new write_job {
+                    .buf = std::move(buf),
+                    .cb = std::move(cb),
+                    .raw_off = index.raw_size,
+                    .data_end = index.data_end,
+                    .trailer = (index.entries.size() + blocks) * sizeof(compressed_block_entry) +
+                               sizeof(compressed_block_footer),
+                    .entries = {},
+                    .out = t_buffer {},
+                    .uncompressed = 0,
+                    .result = 0
+                });
+            }
+            catch (const std::bad_alloc &)
+            {
+                return -ENOMEM;
+            }
+
+            auto *raw = job.release();
+
+            index.writing = true;
+
+            auto result = submit([this, raw]()
+            {
+                raw->result = encode(*raw);
+            }, [this, raw, file]() mutable
+            {
+                commit(file, std::unique_ptr<write_job> {raw});
+            });
+
+            if (result != 0)
+            {
+                index.writing = false;
+                delete raw;
+            }
+
+            return result;
+        }
+
+        int readv(t_file, std::vector<t_buffer>, off64_t, readv_cb) noexcept override
+        {
+            return -ENOTSUP;
+        }
+
+        int writev(t_file, std::vector<t_buffer>, off64_t, writev_cb) noexcept override
+        {
+            return -ENOTSUP;
+        }
+
+        int truncate(t_file file, uint64_t size, truncate_cb cb) noexcept override
+        {
+            auto it = _indexes.find(file.fd());
+
+            if (it == _indexes.end())
+            {
+                return -EBADF;
+            }
+
+            if (it->second.writing)
+            {
+                return -EBUSY;
+            }
+
+            if (size == it->second.raw_size)
+            {
+                cb(file, 0, size);
+
+                return 0;
+            }
+
+            if (size != 0)
+            {
+                return -ENOTSUP;
+            }
+
+            return _inner.truncate(file, 0, [this, cb = std::move(cb)](t_file &file, int err, uint64_t size) mutable
+            {
+                if (err == 0)
+                {
+                    _indexes[file.fd()] = block_index {
+                        .entries = {},
+                        .raw_size = 0,
+                        .data_end = 0,
+                        .writing = false
+                    };
+                }
+
+                cb(file, err, size);
+            });
+        }
+
+        int close(t_file file, close_cb cb) noexcept override
+        {
+            auto it = _indexes.find(file.fd());
+
+            if (it != _indexes.end())
+            {
+                if (it->second.writing)
+                {
+                    return -EBUSY;
+                }
+
+                _indexes.erase(it);
+            }
+
+            return _inner.close(file, std::move(cb));
+        }
+
+        int map(t_file, uint64_t, uint64_t, int32_t, map_cb) noexcept override
+        {
+            return -ENOTSUP;
+        }
+    };
+}
+
+#endif
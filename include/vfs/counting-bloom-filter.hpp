@@ -0,0 +1,171 @@
+#ifndef VFS_COUNTING_BLOOM_FILTER_HPP
+#define VFS_COUNTING_BLOOM_FILTER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace vfs
+{
+    struct counting_bloom_filter_stats
+    {
+        std::size_t counters;
+        unsigned hashes;
+        uint64_t inserts;
+        uint64_t erases;
+        uint64_t saturated;
+    };
+
+    class counting_bloom_filter
+    {
+      public:
+
+        static const uint8_t max_count = 15;
+
+      private:
+
+        std::vector<uint8_t> _counters;
+        std::size_t _size;
+        unsigned _hashes;
+
+        uint64_t _inserts;
+        uint64_t _erases;
+        uint64_t _saturated;
+
+        static inline uint64_t mix(uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+
+            return h;
+        }
+
+        inline uint8_t get(std::size_t i) const noexcept
+        {
+            return static_cast<uint8_t>((_counters[i >> 1] >> ((i & 1) * 4)) & 0x0f);
+        }
+
+        inline void set(std::size_t i, uint8_t value) noexcept
+        {
+            auto shift = (i & 1) * 4;
+            auto &slot = _counters[i >> 1];
+
+            slot = static_cast<uint8_t>((slot & ~(0x0f << shift)) | (value << shift));
+        }
+
+        template<typename t_fn>
+        inline void each(std::string_view key, t_fn fn) const
+        {
+            auto h1 = mix(std::hash<std::string_view> {}(key));
+            auto h2 = mix(h1 ^ 0x9e3779b97f4a7c15ull) | 1;
+
+            for (unsigned k = 0; k < _hashes; ++k)
+            {
+                fn(static_cast<std::size_t>((h1 + k * h2) % _size));
+            }
+        }
+
+      public:
+
+        counting_bloom_filter(std::size_t counters, unsigned hashes)
+            : _counters((std::max<std::size_t>(counters, 1) + 1) / 2, 0),
+              _size(std::max<std::size_t>(counters, 1)),
+              _hashes(std::max(hashes, 1u)),
+              _inserts(0), _erases(0), _saturated(0)
+        {}
+
+        static counting_bloom_filter for_capacity(std::size_t expected, double false_positive_rate)
+        {
+            auto n = static_cast<double>(std::max<std::size_t>(expected, 1));
+            auto p = std::min(std::max(false_positive_rate, 1e-9), 0.5);
+            auto ln2 = std::log(2.0);
+
+            auto m = std::ceil(-n * std::log(p) / (ln2 * ln2));
+            auto k = std::lround(m / n * ln2);
+
+            return counting_bloom_filter {static_cast<std::size_t>(m), static_cast<unsigned>(std::max(k, 1l))};
+        }
+
+        inline std::size_t counters() const noexcept
+        {
+            return _size;
+        }
+
+        inline unsigned hashes() const noexcept
+        {
+            return _hashes;
+        }
+
+        void insert(std::string_view key) noexcept
+        {
+            each(key, [this](std::size_t i)
+            {
+                auto count = get(i);
+
+                if (count < max_count)
+                {
+                    set(i, count + 1);
+
+                    if (count + 1 == max_count)
+                    {
+                        ++_saturated;
+                    }
+                }
+            });
+
+            ++_inserts;
+        }
+
+        void erase(std::string_view key) noexcept
+        {
+            each(key, [this](std::size_t i)
+            {
+                auto count = get(i);
+
+                if (count > 0 && count < max_count)
+                {
+                    set(i, count - 1);
+                }
+            });
+
+            ++_erases;
+        }
+
+        bool may_contain(std::string_view key) const noexcept
+        {
+            bool found = true;
+
+            each(key, [this, &found](std::size_t i)
+            {
+                found = found && get(i) != 0;
+            });
+
+            return found;
+        }
+
+        void clear() noexcept
+        {
+            std::fill(_counters.begin(), _counters.end(), 0);
+        }
+
+        inline counting_bloom_filter_stats stats() const noexcept
+        {
+            return counting_bloom_filter_stats {
+                .counters = _size,
+                .hashes = _hashes,
+                .inserts = _inserts,
+                .erases = _erases,
+                .saturated = _saturated
+            };
+        }
+    };
+}
+
+#endif
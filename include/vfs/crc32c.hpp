@@ -0,0 +1,131 @@
+#ifndef VFS_CRC32C_HPP
+#define VFS_CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace vfs
+{
+    inline uint32_t crc32c_sw(const void *data, std::size_t len, uint32_t crc = 0) noexcept
+    {
+        struct table
+        {
+            uint32_t values[8][256];
+
+            table() noexcept
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    auto v = i;
+
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        v = (v >> 1) ^ (0x82f63b78u & (0u - (v & 1u)));
+                    }
+
+                    values[0][i] = v;
+                }
+
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    for (int t = 1; t < 8; ++t)
+                    {
+                        auto prev = values[t - 1][i];
+
+                        values[t][i] = (prev >> 8) ^ values[0][prev & 0xff];
+                    }
+                }
+            }
+        };
+
+        static const table t;
+
+        auto p = static_cast<const uint8_t *>(data);
+        auto c = ~crc;
+
+        while (len >= 8)
+        {
+            uint32_t lo;
+            uint32_t hi;
+
+            std::memcpy(&lo, p, 4);
+            std::memcpy(&hi, p + 4, 4);
+
+            lo ^= c;
+
+            c = t.values[7][lo & 0xff] ^ t.values[6][(lo >> 8) & 0xff] ^
+                t.values[5][(lo >> 16) & 0xff] ^ t.values[4][lo >> 24] ^
+                t.values[3][hi & 0xff] ^ t.values[2][(hi >> 8) & 0xff] ^
+                t.values[1][(hi >> 16) & 0xff] ^ t.values[0][hi >> 24];
+
+            p += 8;
+            len -= 8;
+        }
+
+        while (len-- > 0)
+        {
+            c = (c >> 8) ^ t.values[0][(c ^ *p++) & 0xff];
+        }
+
+        return ~c;
+    }
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+    __attribute__((target("sse4.2")))
+    inline uint32_t crc32c_hw(const void *data, std::size_t len, uint32_t crc = 0) noexcept
+    {
+        auto p = static_cast<const uint8_t *>(data);
+        uint64_t c = ~crc;
+
+        while (len >= 8)
+        {
+            uint64_t v;
+
+            std::memcpy(&v, p, 8);
+
+            c = __builtin_ia32_crc32di(c, v);
+
+            p += 8;
+            len -= 8;
+        }
+
+        auto c32 = static_cast<uint32_t>(c);
+
+        while (len-- > 0)
+        {
+            c32 = __builtin_ia32_crc32qi(c32, *p++);
+        }
+
+        return ~c32;
+    }
+
+    inline bool crc32c_has_hw() noexcept
+    {
+        static const bool has_hw = __builtin_cpu_supports("sse4.2");
+
+        return has_hw;
+    }
+
+#else
+
+    inline uint32_t crc32c_hw(const void *data, std::size_t len, uint32_t crc = 0) noexcept
+    {
+        return crc32c_sw(data, len, crc);
+    }
+
+    inline bool crc32c_has_hw() noexcept
+    {
+        return false;
+    }
+
+#endif
+
+    inline uint32_t crc32c(const void *data, std::size_t len, uint32_t crc = 0) noexcept
+    {
+        return crc32c_has_hw() ? crc32c_hw(data, len, crc) : crc32c_sw(data, len, crc);
+    }
+}
+
+#endif
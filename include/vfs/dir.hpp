@@ -0,0 +1,242 @@
+#ifndef VFS_DIR_HPP
+#define VFS_DIR_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <vfs/buffer.hpp>
+
+namespace vfs
+{
+    struct dir_entry
+    {
+        uint64_t inode;
+        uint64_t cursor;
+        uint8_t type;
+        std::string_view name;
+
+        inline bool is_unknown() const noexcept
+        {
+            return type == DT_UNKNOWN;
+        }
+
+        inline bool is_file() const noexcept
+        {
+            return type == DT_REG;
+        }
+
+        inline bool is_link() const noexcept
+        {
+            return type == DT_LNK;
+        }
+
+        inline bool is_dir() const noexcept
+        {
+            return type == DT_DIR;
+        }
+    };
+
+    class dir_batch
+    {
+        friend class dir_reader;
+
+      private:
+
+        std::vector<dir_entry> _entries;
+        uint64_t _cursor;
+        bool _eof;
+
+      public:
+
+        dir_batch() noexcept
+            : _entries(), _cursor(0), _eof(false)
+        {}
+
+        inline std::size_t size() const noexcept
+        {
+            return _entries.size();
+        }
+
+        inline bool empty() const noexcept
+        {
+            return _entries.empty();
+        }
+
+        inline const dir_entry &operator[](std::size_t i) const noexcept
+        {
+            return _entries[i];
+        }
+
+        inline std::vector<dir_entry>::const_iterator begin() const noexcept
+        {
+            return _entries.begin();
+        }
+
+        inline std::vector<dir_entry>::const_iterator end() const noexcept
+        {
+            return _entries.end();
+        }
+
+        inline uint64_t cursor() const noexcept
+        {
+            return _cursor;
+        }
+
+        inline bool eof() const noexcept
+        {
+            return _eof;
+        }
+
+        void clear() noexcept
+        {
+            _entries.clear();
+        }
+    };
+
+    class dir_reader
+    {
+      private:
+
+        static constexpr std::size_t min_buffer_size = 4096;
+        static constexpr std::size_t max_buffer_size = 1024 * 1024;
+        static constexpr std::size_t entry_size_hint = 64;
+
+        int _fd;
+        std::size_t _batch_size;
+
+        vfs::buffer _buf;
+        uint64_t _pos;
+        uint64_t _len;
+
+        dir_batch _batch;
+
+      public:
+
+        explicit dir_reader(std::size_t batch_size) noexcept
+            : _fd(-1), _batch_size(std::max<std::size_t>(batch_size, 1)), _buf(), _pos(0), _len(0), _batch()
+        {}
+
+        dir_reader(const dir_reader &lhs) = delete;
+
+        dir_reader &operator=(const dir_reader &lhs) = delete;
+
+        ~dir_reader() noexcept
+        {
+            if (_fd >= 0)
+            {
+                ::close(_fd);
+            }
+        }
+
+        inline bool is_open() const noexcept
+        {
+            return _fd >= 0;
+        }
+
+        inline dir_batch &batch() noexcept
+        {
+            return _batch;
+        }
+
+        int open(const char *path, uint64_t cursor) noexcept
+        {
+            try
+            {
+                auto size = std::clamp(_batch_size * entry_size_hint, min_buffer_size, max_buffer_size);
+
+                _buf = vfs::buffer {size};
+                _batch._entries.reserve(_batch_size);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return -ENOMEM;
+            }
+
+            _fd = ::open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+            if (_fd < 0)
+            {
+                return -errno;
+            }
+
+            if (cursor != 0 && ::lseek64(_fd, static_cast<off64_t>(cursor), SEEK_SET) < 0)
+            {
+                return -errno;
+            }
+
+            _batch._cursor = cursor;
+
+            return 0;
+        }
+
+        int next() noexcept
+        {
+            _batch._entries.clear();
+
+            while (_batch._entries.size() < _batch_size)
+            {
+                if (_pos == _len)
+                {
+                    if (!_batch._entries.empty())
+                    {
+                        break;
+                    }
+
+                    auto n = ::syscall(SYS_getdents64, _fd, _buf.data(), _buf.capacity());
+
+                    if (n < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+
+                        return -errno;
+                    }
+
+                    if (n == 0)
+                    {
+                        _batch._eof = true;
+                        break;
+                    }
+
+                    _pos = 0;
+                    _len = static_cast<uint64_t>(n);
+                }
+
+                auto *ent = reinterpret_cast<struct dirent64 *>(_buf.data() + _pos);
+
+                _pos += ent->d_reclen;
+
+                _batch._cursor = static_cast<uint64_t>(ent->d_off);
+
+                std::string_view name {ent->d_name};
+
+                if (name == "." || name == "..")
+                {
+                    continue;
+                }
+
+                _batch._entries.push_back(dir_entry {
+                    .inode = ent->d_ino,
+                    .cursor = static_cast<uint64_t>(ent->d_off),
+                    .type = ent->d_type,
+                    .name = name
+                });
+            }
+
+            return 0;
+        }
+    };
+}
+
+#endif
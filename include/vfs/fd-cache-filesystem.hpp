@@ -0,0 +1,461 @@
+#ifndef VFS_FD_CACHE_FILESYSTEM_HPP
+#define VFS_FD_CACHE_FILESYSTEM_HPP
+
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vfs/callback.hpp>
+#include <vfs/filesystem-proxy.hpp>
+
+namespace vfs
+{
+    struct fd_cache_stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        uint64_t invalidations;
+        std::size_t open;
+        std::size_t idle;
+    };
+
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class fd_cache_filesystem :
+        public filesystem_proxy<t_path, t_stat, t_file, t_buffer>
+    {
+
+      public:
+
+        using proxy_type = filesystem_proxy<t_path, t_stat, t_file, t_buffer>;
+
+        using typename proxy_type::filesystem_type;
+        using typename proxy_type::move_cb;
+        using typename proxy_type::unlink_cb;
+
+        static const std::size_t default_budget = 1024;
+
+        class file_handle;
+
+        using acquire_cb = vfs::callback<void(t_path &, int, file_handle &)>;
+
+      private:
+
+        using key_type = std::pair<std::string, int32_t>;
+
+        struct slot
+        {
+            key_type key;
+            std::unique_ptr<t_file> file;
+            std::size_t refs;
+            bool cached;
+            bool idle;
+            typename std::list<slot *>::iterator lru;
+            std::vector<acquire_cb> waiters;
+        };
+
+        using proxy_type::_inner;
+
+        std::size_t _budget;
+        std::size_t _open;
+
+        std::map<key_type, std::unique_ptr<slot>> _slots;
+        std::list<slot *> _idle;
+
+        fd_cache_stats _stats;
+
+        static inline bool is_cacheable(int32_t flags) noexcept
+        {
+            return (flags & (O_TRUNC | O_EXCL)) == 0;
+        }
+
+        void discard(slot *s) noexcept
+        {
+            if (s->cached)
+            {
+                _slots.erase(s->key);
+            }
+            else
+            {
+                delete s;
+            }
+        }
+
+        void close_slot(slot *s) noexcept
+        {
+            if (s->idle)
+            {
+                _idle.erase(s->lru);
+                s->idle = false;
+            }
+
+            --_open;
+
+            _inner.close(*s->file, [](t_file &, int)
+            {});
+
+            discard(s);
+        }
+
+        void detach(slot *s) noexcept
+        {
+            auto it = _slots.find(s->key);
+
+            it->second.release();
+            _slots.erase(it);
+
+            s->cached = false;
+        }
+
+        void trim() noexcept
+        {
+            while (_open > _budget && !_idle.empty())
+            {
+                ++_stats.evictions;
+
+                close_slot(_idle.back());
+            }
+        }
+
+        void grab(slot *s) noexcept
+        {
+            if (s->idle)
+            {
+                _idle.erase(s->lru);
+                s->idle = false;
+            }
+
+            ++s->refs;
+        }
+
+        void release(slot *s) noexcept
+        {
+            if (--s->refs > 0)
+            {
+                return;
+            }
+
+            if (!s->cached)
+            {
+                close_slot(s);
+                return;
+            }
+
+            _idle.push_front(s);
+
+            s->lru = _idle.begin();
+            s->idle = true;
+
+            trim();
+        }
+
+        void opened(slot *s, t_path &path, int err, t_file &file) noexcept
+        {
+            auto waiters = std::move(s->waiters);
+
+            if (err == 0)
+            {
+                try
+                {
+                    s->file = std::make_unique<t_file>(file);
+                }
+                catch (...)
+                {
+                    _inner.close(file, [](t_file &, int)
+                    {});
+
+                    err = ENOMEM;
+                }
+            }
+
+            if (err != 0)
+            {
+                --_open;
+
+                discard(s);
+
+                for (auto &waiter : waiters)
+                {
+                    file_handle empty;
+
+                    waiter(path, err, empty);
+                }
+
+                return;
+            }
+
+            s->refs += waiters.size();
+
+            for (auto &waiter : waiters)
+            {
+                file_handle handle {this, s};
+
+                waiter(path, 0, handle);
+            }
+        }
+
+      public:
+
+        class file_handle
+        {
+            friend class fd_cache_filesystem;
+
+          private:
+
+            fd_cache_filesystem *_cache;
+            slot *_slot;
+
+            file_handle(fd_cache_filesystem *cache, slot *s) noexcept
+                : _cache(cache), _slot(s)
+            {}
+
+          public:
+
+            file_handle() noexcept
+                : _cache(nullptr), _slot(nullptr)
+            {}
+
+            file_handle(const file_handle &lhs) = delete;
+
+            file_handle(file_handle &&rhs) noexcept
+                : _cache(rhs._cache), _slot(rhs._slot)
+            {
+                rhs._cache = nullptr;
+                rhs._slot = nullptr;
+            }
+
+            file_handle &operator=(const file_handle &lhs) = delete;
+
+            file_handle &operator=(file_handle &&rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    reset();
+
+                    std::swap(_cache, rhs._cache);
+                    std::swap(_slot, rhs._slot);
+                }
+
+                return *this;
+            }
+
+            ~file_handle() noexcept
+            {
+                reset();
+            }
+
+            inline explicit operator bool() const noexcept
+            {
+                return _slot != nullptr;
+            }
+
+            inline t_file &file() const noexcept
+            {
+                return *_slot->file;
+            }
+
+            void reset() noexcept
+            {
+                if (_slot != nullptr)
+                {
+                    _cache->release(_slot);
+
+                    _cache = nullptr;
+                    _slot = nullptr;
+                }
+            }
+        };
+
+        explicit fd_cache_filesystem(filesystem_type &inner, std::size_t budget = default_budget) noexcept
+            : proxy_type(inner), _budget(budget), _open(0), _stats({})
+        {}
+
+        // handles and pending acquires point back into the cache, so every handle must be reset and every
+        // acquire completed before the cache is destroyed
+        ~fd_cache_filesystem() noexcept
+        {
+            clear();
+
+            assert(_open == 0);
+        }
+
+        inline std::size_t budget() const noexcept
+        {
+            return _budget;
+        }
+
+        int acquire(t_path path, int32_t flags, acquire_cb cb) noexcept
+        {
+            try
+            {
+                key_type key {std::string {path.view()}, flags};
+                bool cacheable = is_cacheable(flags);
+
+                if (cacheable)
+                {
+                    auto it = _slots.find(key);
+
+                    if (it != _slots.end())
+                    {
+                        auto s = it->second.get();
+
+                        ++_stats.hits;
+
+                        if (!s->file)
+                        {
+                            s->waiters.emplace_back(std::move(cb));
+                            return 0;
+                        }
+
+                        grab(s);
+
+                        file_handle handle {this, s};
+
+                        cb(path, 0, handle);
+                        return 0;
+                    }
+                }
+
+                auto owned = std::make_unique<slot>();
+                auto s = owned.get();
+
+                s->key = std::move(key);
+                s->refs = 0;
+                s->cached = cacheable;
+                s->idle = false;
+                s->waiters.emplace_back(std::move(cb));
+
+                if (cacheable)
+                {
+                    _slots.emplace(s->key, std::move(owned));
+                }
+                else
+                {
+                    owned.release();
+                }
+
+                ++_stats.misses;
+                ++_open;
+
+                trim();
+
+                auto result = _inner.open(path, _inner.default_file_mode(), flags,
+                                          [this, s](t_path &path, int err, t_file &file)
+                {
+                    opened(s, path, err, file);
+                });
+
+                if (result != 0)
+                {
+                    --_open;
+
+                    discard(s);
+                }
+
+                return result;
+            }
+            catch (...)
+            {
+                return -ENOMEM;
+            }
+        }
+
+        void invalidate(std::string_view path) noexcept
+        {
+            std::vector<slot *> matches;
+
+            try
+            {
+                for (auto it = _slots.lower_bound(key_type {std::string {path}, INT32_MIN});
+                     it != _slots.end() && it->first.first.compare(0, path.size(), path) == 0; ++it)
+                {
+                    auto &key = it->first.first;
+
+                    if (key.size() == path.size() || path.back() == '/' || key[path.size()] == '/')
+                    {
+                        matches.push_back(it->second.get());
+                    }
+                }
+            }
+            catch (...)
+            {
+                clear();
+                return;
+            }
+
+            for (auto s : matches)
+            {
+                ++_stats.invalidations;
+
+                if (s->refs == 0 && s->file)
+                {
+                    close_slot(s);
+                }
+                else
+                {
+                    detach(s);
+                }
+            }
+        }
+
+        void clear() noexcept
+        {
+            while (!_idle.empty())
+            {
+                close_slot(_idle.back());
+            }
+
+            while (!_slots.empty())
+            {
+                detach(_slots.begin()->second.get());
+            }
+        }
+
+        inline fd_cache_stats stats() const noexcept
+        {
+            auto stats = _stats;
+
+            stats.open = _open;
+            stats.idle = _idle.size();
+
+            return stats;
+        }
+
+        int move(t_path path, t_path move_path, move_cb cb) noexcept override
+        {
+            invalidate(path.view());
+            invalidate(move_path.view());
+
+            return _inner.move(path, move_path, [this, cb = std::move(cb)](t_path &path, t_path &move_path,
+                                                                           int err) mutable
+            {
+                invalidate(path.view());
+                invalidate(move_path.view());
+
+                cb(path, move_path, err);
+            });
+        }
+
+        int unlink(t_path path, unlink_cb cb) noexcept override
+        {
+            invalidate(path.view());
+
+            return _inner.unlink(path, [this, cb = std::move(cb)](t_path &path, int err) mutable
+            {
+                invalidate(path.view());
+
+                cb(path, err);
+            });
+        }
+    };
+}
+
+#endif
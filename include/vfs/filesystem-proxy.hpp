@@ -0,0 +1,185 @@
+#ifndef VFS_FILESYSTEM_PROXY_HPP
+#define VFS_FILESYSTEM_PROXY_HPP
+
+#include <vfs/filesystem.hpp>
+
+namespace vfs
+{
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class filesystem_proxy :
+        public filesystem<t_path, t_stat, t_file, t_buffer>
+    {
+
+      public:
+
+        using filesystem_type = filesystem<t_path, t_stat, t_file, t_buffer>;
+
+        using typename filesystem_type::exists_cb;
+        using typename filesystem_type::stat_cb;
+        using typename filesystem_type::mkdir_cb;
+        using typename filesystem_type::mkdirs_cb;
+        using typename filesystem_type::create_cb;
+        using typename filesystem_type::move_cb;
+        using typename filesystem_type::copy_cb;
+        using typename filesystem_type::link_cb;
+        using typename filesystem_type::symlink_cb;
+        using typename filesystem_type::unlink_cb;
+        using typename filesystem_type::open_cb;
+        using typename filesystem_type::fstat_cb;
+        using typename filesystem_type::read_cb;
+        using typename filesystem_type::write_cb;
+        using typename filesystem_type::readv_cb;
+        using typename filesystem_type::writev_cb;
+        using typename filesystem_type::truncate_cb;
+        using typename filesystem_type::close_cb;
+        using typename filesystem_type::map_cb;
+        using typename filesystem_type::readdir_cb;
+
+      protected:
+
+        filesystem_type &_inner;
+
+      public:
+
+        explicit filesystem_proxy(filesystem_type &inner) noexcept
+            : _inner(inner)
+        {}
+
+        filesystem_proxy(const filesystem_proxy &lhs) = delete;
+
+        filesystem_proxy &operator=(const filesystem_proxy &lhs) = delete;
+
+        inline filesystem_type &inner() const noexcept
+        {
+            return _inner;
+        }
+
+        using filesystem_type::mkdir;
+        using filesystem_type::mkdirs;
+        using filesystem_type::create;
+        using filesystem_type::open;
+        using filesystem_type::readdir;
+
+        int exists(t_path path, exists_cb cb) noexcept override
+        {
+            return _inner.exists(path, std::move(cb));
+        }
+
+        int stat(t_path path, stat_cb cb) noexcept override
+        {
+            return _inner.stat(path, std::move(cb));
+        }
+
+        int mkdir(t_path path, int32_t mode, mkdir_cb cb) noexcept override
+        {
+            return _inner.mkdir(path, mode, std::move(cb));
+        }
+
+        int mkdirs(t_path path, int32_t mode, mkdirs_cb cb) noexcept override
+        {
+            return _inner.mkdirs(path, mode, std::move(cb));
+        }
+
+        int create(t_path path, int32_t mode, create_cb cb) noexcept override
+        {
+            return _inner.create(path, mode, std::move(cb));
+        }
+
+        int move(t_path path, t_path move_path, move_cb cb) noexcept override
+        {
+            return _inner.move(path, move_path, std::move(cb));
+        }
+
+        int copy(t_path path, t_path copy_path, copy_cb cb) noexcept override
+        {
+            return _inner.copy(path, copy_path, std::move(cb));
+        }
+
+        int link(t_path path, t_path other_path, link_cb cb) noexcept override
+        {
+            return _inner.link(path, other_path, std::move(cb));
+        }
+
+        int symlink(t_path path, t_path other_path, symlink_cb cb) noexcept override
+        {
+            return _inner.symlink(path, other_path, std::move(cb));
+        }
+
+        int unlink(t_path path, unlink_cb cb) noexcept override
+        {
+            return _inner.unlink(path, std::move(cb));
+        }
+
+        int open(t_path path, int32_t mode, int32_t flags, open_cb cb) noexcept override
+        {
+            return _inner.open(path, mode, flags, std::move(cb));
+        }
+
+        int stat(t_file file, fstat_cb cb) noexcept override
+        {
+            return _inner.stat(file, std::move(cb));
+        }
+
+        int read(t_file file, t_buffer buf, off64_t off, read_cb cb) noexcept override
+        {
+            return _inner.read(file, std::move(buf), off, std::move(cb));
+        }
+
+        int write(t_file file, t_buffer buf, off64_t off, write_cb cb) noexcept override
+        {
+            return _inner.write(file, std::move(buf), off, std::move(cb));
+        }
+
+        int readv(t_file file, std::vector<t_buffer> bufs, off64_t off, readv_cb cb) noexcept override
+        {
+            return _inner.readv(file, std::move(bufs), off, std::move(cb));
+        }
+
+        int writev(t_file file, std::vector<t_buffer> bufs, off64_t off, writev_cb cb) noexcept override
+        {
+            return _inner.writev(file, std::move(bufs), off, std::move(cb));
+        }
+
+        int truncate(t_file file, uint64_t size, truncate_cb cb) noexcept override
+        {
+            return _inner.truncate(file, size, std::move(cb));
+        }
+
+        int close(t_file file, close_cb cb) noexcept override
+        {
+            return _inner.close(file, std::move(cb));
+        }
+
+        int map(t_file file, uint64_t off, uint64_t len, int32_t flags, map_cb cb) noexcept override
+        {
+            return _inner.map(file, off, len, flags, std::move(cb));
+        }
+
+        int readdir(t_path path, std::size_t batch_size, uint64_t cursor, readdir_cb cb) noexcept override
+        {
+            return _inner.readdir(path, batch_size, cursor, std::move(cb));
+        }
+
+        inline int32_t default_file_mode() const noexcept override
+        {
+            return _inner.default_file_mode();
+        }
+
+        inline int32_t default_dir_mode() const noexcept override
+        {
+            return _inner.default_dir_mode();
+        }
+
+        inline int32_t default_open_mode() const noexcept override
+        {
+            return _inner.default_open_mode();
+        }
+
+        inline std::size_t default_batch_concurrency() const noexcept override
+        {
+            return _inner.default_batch_concurrency();
+        }
+    };
+}
+
+#endif
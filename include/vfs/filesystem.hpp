@@ -2,93 +2,128 @@
 #define VFS_CPP_FILESYSTEM_H
 
 #include <fcntl.h>
-#include <functional>
+#include <vector>
 
+#include <vfs/batch.hpp>
+#include <vfs/callback.hpp>
 #include <vfs/path.hpp>
 #include <vfs/buffer.hpp>
+#include <vfs/buffer-chain.hpp>
+#include <vfs/dir.hpp>
+#include <vfs/map.hpp>
 
 namespace vfs
 {
     template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
     class filesystem
     {
+        static_assert(is_path_like<t_path>::value, "t_path must model vfs::path");
 
       public:
 
-        using exists_cb = std::function<
+        using exists_cb = vfs::callback<
             void(t_path &, int, bool)>;
 
-        using stat_cb = std::function<
+        using stat_cb = vfs::callback<
             void(t_path &, int, t_stat)>;
 
-        using mkdir_cb = std::function<
+        using mkdir_cb = vfs::callback<
             void(t_path &, int)>;
 
-        using mkdirs_cb = std::function<
+        using mkdirs_cb = vfs::callback<
             void(t_path &, int)>;
 
-        using create_cb = std::function<
+        using create_cb = vfs::callback<
             void(t_path &, int)>;
 
-        using move_cb = std::function<
+        using move_cb = vfs::callback<
             void(t_path &, t_path &, int)>;
 
-        using copy_cb = std::function<
+        using copy_cb = vfs::callback<
             void(t_path &, t_path &, int)>;
 
-        using link_cb = std::function<
+        using link_cb = vfs::callback<
             void(t_path &, t_path &, int)>;
 
-        using symlink_cb = std::function<
+        using symlink_cb = vfs::callback<
             void(t_path &, t_path &, int)>;
 
-        using unlink_cb = std::function<
+        using unlink_cb = vfs::callback<
             void(t_path &, int)>;
 
-        using open_cb = std::function<
+        using open_cb = vfs::callback<
             void(t_path &, int, t_file &)>;
 
-        using fstat_cb = std::function<
+        using fstat_cb = vfs::callback<
             void(t_file &, int, t_stat)>;
 
-        using read_cb = std::function<
+        using read_cb = vfs::callback<
             void(t_file &, int, vfs::buffer &)>;
 
-        using write_cb = std::function<
+        using write_cb = vfs::callback<
             void(t_file &, int, vfs::buffer &)>;
 
-        using truncate_cb = std::function<
+        using readv_cb = vfs::callback<
+            void(t_file &, int, std::vector<t_buffer> &)>;
+
+        using writev_cb = vfs::callback<
+            void(t_file &, int, std::vector<t_buffer> &)>;
+
+        using truncate_cb = vfs::callback<
             void(t_file &, int, uint64_t)>;
 
-        using close_cb = std::function<
+        using close_cb = vfs::callback<
             void(t_file &, int)>;
 
+        using map_cb = vfs::callback<
+            void(t_file &, int, vfs::mapped_slice &)>;
+
+        using readdir_cb = vfs::callback<
+            bool(t_path &, int, vfs::dir_batch &)>;
+
+        using batch_type = vfs::batch<t_path, t_stat, t_file, t_buffer>;
+
         virtual ~filesystem() noexcept
         {};
 
         int mkdir(t_path path, mkdir_cb cb) noexcept
         {
-            return mkdir(path, default_dir_mode(), cb);
+            return mkdir(path, default_dir_mode(), std::move(cb));
         };
 
         int mkdirs(t_path path, mkdirs_cb cb) noexcept
         {
-            return mkdirs(path, default_dir_mode(), cb);
+            return mkdirs(path, default_dir_mode(), std::move(cb));
         };
 
         int create(t_path path, create_cb cb) noexcept
         {
-            return create(path, default_file_mode(), cb);
+            return create(path, default_file_mode(), std::move(cb));
         };
 
         inline int open(t_path path, open_cb cb) noexcept
         {
-            return open(path, default_file_mode(), default_open_mode(), cb);
+            return open(path, default_file_mode(), default_open_mode(), std::move(cb));
         };
 
         inline int open(t_path path, int32_t flags, open_cb cb) noexcept
         {
-            return open(path, default_file_mode(), flags, cb);
+            return open(path, default_file_mode(), flags, std::move(cb));
+        };
+
+        inline int readdir(t_path path, std::size_t batch_size, readdir_cb cb) noexcept
+        {
+            return readdir(path, batch_size, 0, std::move(cb));
+        };
+
+        inline batch_type batch() noexcept
+        {
+            return batch_type {*this, default_batch_concurrency()};
+        };
+
+        inline batch_type batch(std::size_t concurrency) noexcept
+        {
+            return batch_type {*this, concurrency};
         };
 
         virtual int exists(t_path path, exists_cb cb) noexcept = 0;
@@ -105,9 +140,43 @@ namespace vfs
         virtual int stat(t_file file, fstat_cb cb) noexcept = 0;
         virtual int read(t_file file, t_buffer buf, off64_t off, read_cb cb) noexcept = 0;
         virtual int write(t_file file, t_buffer buf, off64_t off, write_cb cb) noexcept = 0;
+        virtual int readv(t_file file, std::vector<t_buffer> bufs, off64_t off, readv_cb cb) noexcept = 0;
+        virtual int writev(t_file file, std::vector<t_buffer> bufs, off64_t off, writev_cb cb) noexcept = 0;
         virtual int truncate(t_file file, uint64_t size, truncate_cb cb) noexcept = 0;
         virtual int close(t_file file, close_cb cb) noexcept = 0;
 
+        virtual int map(t_file file, uint64_t off, uint64_t len, int32_t flags, map_cb cb) noexcept
+        {
+            vfs::mapped_slice view;
+
+            auto result = vfs::map_fd(static_cast<int>(file.fd()), off, len, flags, view);
+
+            cb(file, -result, view);
+
+            return 0;
+        }
+
+        virtual int readdir(t_path path, std::size_t batch_size, uint64_t cursor, readdir_cb cb) noexcept
+        {
+            vfs::dir_reader reader {batch_size};
+
+            auto result = reader.open(path.c_str(), cursor);
+
+            while (result == 0)
+            {
+                result = reader.next();
+
+                if (!cb(path, -result, reader.batch()) || result != 0 || reader.batch().eof())
+                {
+                    return 0;
+                }
+            }
+
+            cb(path, -result, reader.batch());
+
+            return 0;
+        }
+
         virtual inline int32_t default_file_mode() const noexcept
         {
             return 0664;
@@ -122,6 +191,11 @@ namespace vfs
         {
             return O_RDWR | O_CREAT | O_APPEND | O_NONBLOCK;
         }
+
+        virtual inline std::size_t default_batch_concurrency() const noexcept
+        {
+            return 64;
+        }
     };
 }
 
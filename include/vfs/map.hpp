@@ -0,0 +1,186 @@
+#ifndef VFS_MAP_HPP
+#define VFS_MAP_HPP
+
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vfs/buffer.hpp>
+#include <vfs/buffer-chain.hpp>
+
+namespace vfs
+{
+    enum map_flags : int32_t
+    {
+        map_default = 0,
+        map_populate = 1 << 0,
+        map_sequential = 1 << 1,
+        map_random = 1 << 2,
+        map_willneed = 1 << 3,
+        map_hugepage = 1 << 4
+    };
+
+    class mmap_buffer_source :
+        public buffer_source
+    {
+      public:
+
+        static mmap_buffer_source &instance() noexcept
+        {
+            static mmap_buffer_source source;
+
+            return source;
+        }
+
+        void release(uint8_t *ptr, uint64_t tag) noexcept override
+        {
+            ::munmap(ptr, tag);
+        }
+    };
+
+    // a read-only view over a PROT_READ mapping; it wraps a buffer_slice so the mapping is shared and
+    // unmapped with the last view, but never hands out a writable pointer
+    class mapped_slice
+    {
+      private:
+
+        vfs::buffer_slice _slice;
+
+      public:
+
+        mapped_slice() noexcept
+            : _slice()
+        {}
+
+        explicit mapped_slice(vfs::buffer_slice &&slice) noexcept
+            : _slice(std::move(slice))
+        {}
+
+        inline uint64_t size() const noexcept
+        {
+            return _slice.size();
+        }
+
+        inline bool empty() const noexcept
+        {
+            return _slice.empty();
+        }
+
+        inline const uint8_t *data() const noexcept
+        {
+            return _slice.data();
+        }
+
+        inline const uint8_t *begin() const noexcept
+        {
+            return _slice.begin();
+        }
+
+        inline const uint8_t *end() const noexcept
+        {
+            return _slice.end();
+        }
+
+        inline long use_count() const noexcept
+        {
+            return _slice.use_count();
+        }
+
+        mapped_slice slice(uint64_t off, uint64_t len) const noexcept
+        {
+            return mapped_slice {_slice.slice(off, len)};
+        }
+
+        void truncate(uint64_t size) noexcept
+        {
+            _slice.truncate(size);
+        }
+
+        void advance(uint64_t n) noexcept
+        {
+            _slice.advance(n);
+        }
+    };
+
+    inline int map_fd(int fd, uint64_t off, uint64_t len, int32_t flags, vfs::mapped_slice &view) noexcept
+    {
+        struct stat64 stat;
+
+        if (::fstat64(fd, &stat) < 0)
+        {
+            return -errno;
+        }
+
+        auto size = static_cast<uint64_t>(stat.st_size);
+
+        if (off > size)
+        {
+            return -EINVAL;
+        }
+
+        len = len == 0 || len > size - off ? size - off : len;
+
+        if (len == 0)
+        {
+            view = vfs::mapped_slice {};
+
+            return 0;
+        }
+
+        static const auto page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+
+        auto head = off % page_size;
+        auto map_len = head + len;
+
+        auto mmap_flags = MAP_SHARED | ((flags & map_populate) != 0 ? MAP_POPULATE : 0);
+        auto ptr = ::mmap(nullptr, map_len, PROT_READ, mmap_flags, fd, static_cast<off64_t>(off - head));
+
+        if (ptr == MAP_FAILED)
+        {
+            return -errno;
+        }
+
+        if ((flags & map_sequential) != 0)
+        {
+            ::madvise(ptr, map_len, MADV_SEQUENTIAL);
+        }
+
+        if ((flags & map_random) != 0)
+        {
+            ::madvise(ptr, map_len, MADV_RANDOM);
+        }
+
+        if ((flags & map_willneed) != 0)
+        {
+            ::madvise(ptr, map_len, MADV_WILLNEED);
+        }
+
+        if ((flags & map_hugepage) != 0)
+        {
+            ::madvise(ptr, map_len, MADV_HUGEPAGE);
+        }
+
+        try
+        {
+            vfs::buffer::ptr_type owned {
+                static_cast<uint8_t *>(ptr),
+                buffer_deleter {&mmap_buffer_source::instance(), map_len}
+            };
+
+            vfs::buffer_slice mapping {vfs::buffer {std::move(owned), map_len}, map_len};
+
+            view = vfs::mapped_slice {mapping.slice(head, len)};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return -ENOMEM;
+        }
+
+        return 0;
+    }
+}
+
+#endif
@@ -0,0 +1,317 @@
+#ifndef VFS_PATH_NORMALIZE_HPP
+#define VFS_PATH_NORMALIZE_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+namespace vfs
+{
+    struct path_scan_result
+    {
+        static const std::size_t clean = SIZE_MAX;
+
+        std::size_t restart;
+        std::size_t longest;
+        bool has_nul;
+    };
+
+    struct path_masks
+    {
+        uint64_t separators;
+        uint64_t dots;
+        uint64_t nuls;
+    };
+
+    inline path_masks path_classify_sw(const char *p) noexcept
+    {
+        path_masks masks {0, 0, 0};
+
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            masks.separators |= static_cast<uint64_t>(p[i] == '/') << i;
+            masks.dots |= static_cast<uint64_t>(p[i] == '.') << i;
+            masks.nuls |= static_cast<uint64_t>(p[i] == '\0') << i;
+        }
+
+        return masks;
+    }
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+    inline path_masks path_classify_sse2(const char *p) noexcept
+    {
+        const auto separator = _mm_set1_epi8('/');
+        const auto dot = _mm_set1_epi8('.');
+        const auto nul = _mm_setzero_si128();
+
+        path_masks masks {0, 0, 0};
+
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * k));
+
+            masks.separators |= static_cast<uint64_t>(static_cast<uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(v, separator)))) << (16 * k);
+            masks.dots |= static_cast<uint64_t>(static_cast<uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(v, dot)))) << (16 * k);
+            masks.nuls |= static_cast<uint64_t>(static_cast<uint16_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(v, nul)))) << (16 * k);
+        }
+
+        return masks;
+    }
+
+    __attribute__((target("avx2")))
+    inline path_masks path_classify_avx2(const char *p) noexcept
+    {
+        const auto separator = _mm256_set1_epi8('/');
+        const auto dot = _mm256_set1_epi8('.');
+        const auto nul = _mm256_setzero_si256();
+
+        path_masks masks {0, 0, 0};
+
+        for (unsigned k = 0; k < 2; ++k)
+        {
+            auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32 * k));
+
+            masks.separators |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, separator)))) << (32 * k);
+            masks.dots |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, dot)))) << (32 * k);
+            masks.nuls |= static_cast<uint64_t>(static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nul)))) << (32 * k);
+        }
+
+        return masks;
+    }
+
+    inline bool path_has_avx2() noexcept
+    {
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+        return has_avx2;
+    }
+
+#else
+
+    inline path_masks path_classify_sse2(const char *p) noexcept
+    {
+        return path_classify_sw(p);
+    }
+
+    inline path_masks path_classify_avx2(const char *p) noexcept
+    {
+        return path_classify_sw(p);
+    }
+
+    inline bool path_has_avx2() noexcept
+    {
+        return false;
+    }
+
+#endif
+
+    template<typename t_classify>
+    inline path_scan_result path_scan_with(std::string_view path, t_classify classify) noexcept
+    {
+        path_scan_result result {path_scan_result::clean, 0, false};
+
+        auto p = path.data();
+        auto len = path.size();
+
+        uint64_t separator_carry = 0;
+        uint64_t start_carry = 1;
+        std::size_t component = 0;
+
+        for (std::size_t base = 0; base < len; base += 64)
+        {
+            auto n = std::min<std::size_t>(64, len - base);
+
+            path_masks masks;
+
+            if (n == 64)
+            {
+                masks = classify(p + base);
+            }
+            else
+            {
+                alignas(32) char tail[64];
+
+                std::memset(tail, 0, sizeof(tail));
+                std::memcpy(tail, p + base, n);
+
+                masks = classify(tail);
+
+                auto valid = (uint64_t {1} << n) - 1;
+
+                masks.separators &= valid;
+                masks.dots &= valid;
+                masks.nuls &= valid;
+            }
+
+            result.has_nul |= masks.nuls != 0;
+
+            auto after_separator = (masks.separators << 1) | separator_carry;
+            auto component_start = (masks.separators << 1) | start_carry;
+            auto dirty = (masks.separators & after_separator) | (masks.dots & component_start);
+
+            if (dirty != 0 && result.restart == path_scan_result::clean)
+            {
+                auto at = base + static_cast<std::size_t>(__builtin_ctzll(dirty));
+
+                result.restart = at > 0 ? at - 1 : 0;
+            }
+
+            for (auto separators = masks.separators; separators != 0; separators &= separators - 1)
+            {
+                auto at = base + static_cast<std::size_t>(__builtin_ctzll(separators));
+
+                result.longest = std::max(result.longest, at - component);
+                component = at + 1;
+            }
+
+            separator_carry = masks.separators >> 63;
+            start_carry = separator_carry;
+        }
+
+        result.longest = std::max(result.longest, len - component);
+
+        if (len > 1 && p[len - 1] == '/' && result.restart == path_scan_result::clean)
+        {
+            result.restart = len - 1;
+        }
+
+        return result;
+    }
+
+    inline path_scan_result path_scan_sw(std::string_view path) noexcept
+    {
+        return path_scan_with(path, path_classify_sw);
+    }
+
+    inline path_scan_result path_scan(std::string_view path) noexcept
+    {
+        return path_has_avx2()
+               ? path_scan_with(path, path_classify_avx2)
+               : path_scan_with(path, path_classify_sse2);
+    }
+
+    inline int validate_path(std::string_view path) noexcept
+    {
+        if (path.empty())
+        {
+            return -EINVAL;
+        }
+
+        if (path.size() >= PATH_MAX)
+        {
+            return -ENAMETOOLONG;
+        }
+
+        auto scan = path_scan(path);
+
+        if (scan.has_nul)
+        {
+            return -EINVAL;
+        }
+
+        return scan.longest > NAME_MAX ? -ENAMETOOLONG : 0;
+    }
+
+    inline std::size_t normalize_path_from(char *p, std::size_t len, std::size_t start) noexcept
+    {
+        const std::size_t root = len > 0 && p[0] == '/' ? 1 : 0;
+
+        auto w = std::max(start, root);
+        auto r = w;
+        auto base = root;
+
+        while (r < len)
+        {
+            while (r < len && p[r] == '/')
+            {
+                ++r;
+            }
+
+            if (r == len)
+            {
+                break;
+            }
+
+            auto end = static_cast<const char *>(std::memchr(p + r, '/', len - r));
+            auto e = end != nullptr ? static_cast<std::size_t>(end - p) : len;
+            auto n = e - r;
+
+            if (n == 1 && p[r] == '.')
+            {
+                r = e;
+                continue;
+            }
+
+            if (n == 2 && p[r] == '.' && p[r + 1] == '.')
+            {
+                if (w > base)
+                {
+                    auto i = w;
+
+                    while (i > base && p[i - 1] != '/')
+                    {
+                        --i;
+                    }
+
+                    w = i > base ? i - 1 : base;
+                }
+                else if (root == 0)
+                {
+                    if (w > 0)
+                    {
+                        p[w++] = '/';
+                    }
+
+                    p[w++] = '.';
+                    p[w++] = '.';
+
+                    base = w;
+                }
+
+                r = e;
+                continue;
+            }
+
+            if (w > root)
+            {
+                p[w++] = '/';
+            }
+
+            std::memmove(p + w, p + r, n);
+
+            w += n;
+            r = e;
+        }
+
+        if (w == 0 && len > 0)
+        {
+            p[w++] = '.';
+        }
+
+        return w;
+    }
+
+    inline std::size_t normalize_path(char *p, std::size_t len) noexcept
+    {
+        auto scan = path_scan(std::string_view {p, len});
+
+        return scan.restart == path_scan_result::clean ? len : normalize_path_from(p, len, scan.restart);
+    }
+}
+
+#endif
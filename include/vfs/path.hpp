@@ -2,7 +2,10 @@
 #define VFS_CPP_PATH_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 namespace vfs
 {
@@ -36,6 +39,19 @@ namespace vfs
     using disable_if_is_any_path = std::enable_if_t<
         !is_any_path<t_path>::value>;
 
+    template<typename t_path, typename = void>
+    struct is_path_like : std::false_type
+    {};
+
+    template<typename t_path>
+    struct is_path_like<t_path, std::void_t<
+        decltype(std::declval<const t_path &>().c_str()),
+        decltype(std::declval<const t_path &>().view()),
+        decltype(std::declval<t_path &>().append(std::string_view {})),
+        decltype(std::declval<t_path &>().prepend(std::string_view {})),
+        decltype(std::declval<t_path &>().parent())>> : is_path<t_path>
+    {};
+
     class path
     {
       public:
@@ -49,14 +65,14 @@ namespace vfs
         virtual bool is_valid() const noexcept = 0;
 
         virtual const std::string &str() const noexcept = 0;
+        virtual const char *c_str() const noexcept = 0;
+        virtual std::string_view view() const noexcept = 0;
 
         virtual path &prepend(path &path) noexcept = 0;
-        virtual path &prepend(std::string &str) noexcept = 0;
-        virtual path &prepend(std::string &&str) noexcept = 0;
+        virtual path &prepend(std::string_view str) noexcept = 0;
 
         virtual path &append(path &path) noexcept = 0;
-        virtual path &append(std::string &str) noexcept = 0;
-        virtual path &append(std::string &&str) noexcept = 0;
+        virtual path &append(std::string_view str) noexcept = 0;
 
         virtual path &parent() noexcept = 0;
         virtual path &filename() noexcept = 0;
@@ -163,13 +179,7 @@ namespace vfs
             return *this;
         };
 
-        inline any_path &prepend(std::string &val) noexcept override
-        {
-            _path.prepend(val);
-            return *this;
-        };
-
-        inline any_path &prepend(std::string &&val) noexcept override
+        inline any_path &prepend(std::string_view val) noexcept override
         {
             _path.prepend(val);
             return *this;
@@ -181,13 +191,7 @@ namespace vfs
             return *this;
         };
 
-        inline any_path &append(std::string &val) noexcept override
-        {
-            _path.append(val);
-            return *this;
-        };
-
-        inline any_path &append(std::string &&val) noexcept override
+        inline any_path &append(std::string_view val) noexcept override
         {
             _path.append(val);
             return *this;
@@ -215,6 +219,16 @@ namespace vfs
         {
             return _path.str();
         };
+
+        inline const char *c_str() const noexcept override
+        {
+            return _path.c_str();
+        };
+
+        inline std::string_view view() const noexcept override
+        {
+            return _path.view();
+        };
     };
 }
 
@@ -0,0 +1,202 @@
+#ifndef VFS_SMALL_VECTOR_HPP
+#define VFS_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace vfs
+{
+    template<typename t_value, std::size_t t_inline>
+    class small_vector
+    {
+        static_assert(std::is_trivially_copyable<t_value>::value, "small_vector holds trivially copyable values");
+
+      private:
+
+        t_value _inline[t_inline];
+        std::unique_ptr<t_value[]> _heap;
+
+        t_value *_data;
+        std::size_t _size;
+        std::size_t _capacity;
+
+      public:
+
+        small_vector() noexcept
+            : _data(_inline), _size(0), _capacity(t_inline)
+        {}
+
+        small_vector(const small_vector &lhs)
+            : small_vector()
+        {
+            assign(lhs._data, lhs._size);
+        }
+
+        small_vector &operator=(const small_vector &lhs)
+        {
+            if (this != &lhs)
+            {
+                assign(lhs._data, lhs._size);
+            }
+
+            return *this;
+        }
+
+        inline bool is_inline() const noexcept
+        {
+            return _data == _inline;
+        }
+
+        inline bool contains(const t_value *ptr) const noexcept
+        {
+            return !std::less<const t_value *> {}(ptr, _data) && std::less<const t_value *> {}(ptr, _data + _size);
+        }
+
+        inline bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        inline std::size_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        inline t_value *data() noexcept
+        {
+            return _data;
+        }
+
+        inline const t_value *data() const noexcept
+        {
+            return _data;
+        }
+
+        inline t_value &operator[](std::size_t i) noexcept
+        {
+            return _data[i];
+        }
+
+        inline const t_value &operator[](std::size_t i) const noexcept
+        {
+            return _data[i];
+        }
+
+        inline t_value &back() noexcept
+        {
+            return _data[_size - 1];
+        }
+
+        inline const t_value &back() const noexcept
+        {
+            return _data[_size - 1];
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            if (capacity <= _capacity)
+            {
+                return;
+            }
+
+            capacity = std::max(capacity, 2 * _capacity);
+
+            auto heap = std::make_unique<t_value[]>(capacity);
+
+            std::memcpy(heap.get(), _data, _size * sizeof(t_value));
+
+            _heap = std::move(heap);
+            _data = _heap.get();
+            _capacity = capacity;
+        }
+
+        void resize(std::size_t size)
+        {
+            reserve(size);
+
+            _size = size;
+        }
+
+        void clear() noexcept
+        {
+            _size = 0;
+        }
+
+        void push_back(t_value value)
+        {
+            reserve(_size + 1);
+
+            _data[_size++] = value;
+        }
+
+        void pop_back() noexcept
+        {
+            --_size;
+        }
+
+        void assign(const t_value *values, std::size_t n)
+        {
+            if (n == 0)
+            {
+                _size = 0;
+
+                return;
+            }
+
+            reserve(n);
+
+            std::memmove(_data, values, n * sizeof(t_value));
+
+            _size = n;
+        }
+
+        void insert(std::size_t pos, const t_value *values, std::size_t n)
+        {
+            if (n == 0)
+            {
+                return;
+            }
+
+            // values may point into this vector: remember its index, since reserve() can move the storage
+            // and the shift below moves whatever sits at or after pos
+            auto aliased = contains(values);
+            auto from = aliased ? static_cast<std::size_t>(values - _data) : 0;
+
+            reserve(_size + n);
+
+            std::memmove(_data + pos + n, _data + pos, (_size - pos) * sizeof(t_value));
+
+            if (!aliased)
+            {
+                std::memcpy(_data + pos, values, n * sizeof(t_value));
+            }
+            else
+            {
+                auto head = from < pos ? std::min(n, pos - from) : 0;
+
+                std::memcpy(_data + pos, _data + from, head * sizeof(t_value));
+                std::memcpy(_data + pos + head, _data + from + head + n, (n - head) * sizeof(t_value));
+            }
+
+            _size += n;
+        }
+
+        void erase(std::size_t pos, std::size_t n) noexcept
+        {
+            std::memmove(_data + pos, _data + pos + n, (_size - pos - n) * sizeof(t_value));
+
+            _size -= n;
+        }
+    };
+}
+
+#endif
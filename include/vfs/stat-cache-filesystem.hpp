@@ -0,0 +1,1036 @@
+#ifndef VFS_STAT_CACHE_FILESYSTEM_HPP
+#define VFS_STAT_CACHE_FILESYSTEM_HPP
+
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <vfs/callback.hpp>
+#include <vfs/counting-bloom-filter.hpp>
+#include <vfs/filesystem-proxy.hpp>
+#include <vfs/path-normalize.hpp>
+
+namespace vfs
+{
+    struct stat_cache_stats
+    {
+        uint64_t hits;
+        uint64_t negative_hits;
+        uint64_t filter_rejections;
+        uint64_t misses;
+        uint64_t expirations;
+        uint64_t evictions;
+        uint64_t invalidations;
+        std::size_t size;
+
+        inline double hit_rate() const noexcept
+        {
+            auto served = hits + negative_hits + filter_rejections;
+            auto lookups = served + misses;
+
+            return lookups == 0 ? 0.0 : static_cast<double>(served) / static_cast<double>(lookups);
+        }
+    };
+
+    using stat_cache_clock = vfs::callback<uint64_t()>;
+    using stat_cache_work = vfs::callback<void(), 128>;
+    using stat_cache_executor = vfs::callback<int(stat_cache_work, stat_cache_work)>;
+
+    template<typename t_path, typename t_stat, typename t_file, typename t_buffer>
+    class stat_cache_filesystem :
+        public filesystem_proxy<t_path, t_stat, t_file, t_buffer>
+    {
+
+      public:
+
+        using proxy_type = filesystem_proxy<t_path, t_stat, t_file, t_buffer>;
+
+        using typename proxy_type::filesystem_type;
+        using typename proxy_type::exists_cb;
+        using typename proxy_type::stat_cb;
+        using typename proxy_type::mkdir_cb;
+        using typename proxy_type::mkdirs_cb;
+        using typename proxy_type::create_cb;
+        using typename proxy_type::move_cb;
+        using typename proxy_type::copy_cb;
+        using typename proxy_type::link_cb;
+        using typename proxy_type::symlink_cb;
+        using typename proxy_type::unlink_cb;
+        using typename proxy_type::open_cb;
+        using typename proxy_type::write_cb;
+        using typename proxy_type::writev_cb;
+        using typename proxy_type::truncate_cb;
+        using typename proxy_type::close_cb;
+
+        static const std::size_t default_capacity = 4096;
+        static const uint64_t default_ttl = 1000;
+
+      private:
+
+        struct entry
+        {
+            int err;
+            t_stat stat;
+            uint64_t expires;
+            std::list<std::string>::iterator lru;
+        };
+
+        struct walk_job
+        {
+            std::string root;
+            std::unique_ptr<counting_bloom_filter> filter;
+            std::vector<std::string> keys;
+            uint64_t epoch;
+            int result;
+        };
+
+        using proxy_type::_inner;
+
+        std::size_t _capacity;
+        uint64_t _ttl;
+        stat_cache_clock _clock;
+        stat_cache_executor _executor;
+
+        std::map<std::string, entry, std::less<>> _entries;
+        std::list<std::string> _lru;
+
+        std::unordered_map<uint64_t, std::string> _keys;
+
+        std::string _filter_root;
+        std::unique_ptr<counting_bloom_filter> _filter;
+        std::size_t _filter_expected;
+        double _filter_rate;
+        std::size_t _retired;
+
+        uint64_t _epoch;
+        std::size_t _walks;
+        bool _rebuilding;
+        bool _stale;
+        std::vector<std::string> _backlog;
+
+        uint64_t _generation;
+        stat_cache_stats _stats;
+
+        static uint64_t steady_now() noexcept
+        {
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+        }
+
+        static bool is_clean(std::string_view path) noexcept
+        {
+            return path_scan(path).restart == path_scan_result::clean;
+        }
+
+        static bool crosses_parent(std::string_view path) noexcept
+        {
+            for (auto at = path.find(".."); at != std::string_view::npos; at = path.find("..", at + 1))
+            {
+                if ((at == 0 || path[at - 1] == '/') && (at + 2 == path.size() || path[at + 2] == '/'))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // entries and the filter are keyed byte-wise, so "//", "/./" and trailing separators are folded away;
+        // ".." cannot be folded lexically when a symlink is crossed, so such spellings get an empty key
+        static std::string_view key_of(std::string_view path, std::string &folded) noexcept
+        {
+            if (is_clean(path))
+            {
+                return path;
+            }
+
+            if (crosses_parent(path))
+            {
+                return {};
+            }
+
+            try
+            {
+                folded.assign(path);
+                folded.resize(normalize_path(&folded[0], folded.size()));
+
+                return folded;
+            }
+            catch (...)
+            {
+                return {};
+            }
+        }
+
+        bool lookup(std::string_view key, int &err, t_stat &stat) noexcept
+        {
+            // only clean spellings are answered, since "/d/x/" fails with ENOTDIR where "/d/x" may not
+            if (!is_clean(key))
+            {
+                ++_stats.misses;
+                return false;
+            }
+
+            if (_filter && _walks == 0 && is_filtered(key) && !_filter->may_contain(key))
+            {
+                err = ENOENT;
+
+                ++_stats.filter_rejections;
+                return true;
+            }
+
+            auto it = _entries.find(key);
+
+            if (it == _entries.end())
+            {
+                ++_stats.misses;
+                return false;
+            }
+
+            if (_clock() >= it->second.expires)
+            {
+                _lru.erase(it->second.lru);
+                _entries.erase(it);
+
+                ++_stats.expirations;
+                ++_stats.misses;
+                return false;
+            }
+
+            _lru.splice(_lru.begin(), _lru, it->second.lru);
+
+            err = it->second.err;
+            stat = it->second.stat;
+
+            if (err == 0)
+            {
+                ++_stats.hits;
+            }
+            else
+            {
+                ++_stats.negative_hits;
+            }
+
+            return true;
+        }
+
+        void insert(std::string_view key, int err, const t_stat &stat)
+        {
+            if (_capacity == 0)
+            {
+                return;
+            }
+
+            auto expires = _clock() + _ttl;
+            auto it = _entries.find(key);
+
+            if (it != _entries.end())
+            {
+                it->second.err = err;
+                it->second.stat = stat;
+                it->second.expires = expires;
+
+                _lru.splice(_lru.begin(), _lru, it->second.lru);
+                return;
+            }
+
+            if (_entries.size() >= _capacity)
+            {
+                _entries.erase(_lru.back());
+                _lru.pop_back();
+
+                ++_stats.evictions;
+            }
+
+            _lru.emplace_front(key);
+            _entries.emplace(_lru.front(), entry {err, stat, expires, _lru.begin()});
+        }
+
+        void erase(typename std::map<std::string, entry, std::less<>>::iterator it) noexcept
+        {
+            _lru.erase(it->second.lru);
+            _entries.erase(it);
+
+            ++_stats.invalidations;
+        }
+
+        void cache(t_path &path, uint64_t generation, int err, const t_stat &stat)
+        {
+            if (generation == _generation && (err == 0 || err == ENOENT) && is_clean(path.view()))
+            {
+                try
+                {
+                    insert(path.view(), err, stat);
+                }
+                catch (...)
+                {}
+            }
+        }
+
+        void opened(t_file &file, std::string_view path) noexcept
+        {
+            try
+            {
+                std::string folded;
+
+                // an empty key marks a file whose path could not be folded, so its writes clear the cache
+                _keys[file.fd()].assign(key_of(path, folded));
+            }
+            catch (...)
+            {
+                _keys.erase(file.fd());
+            }
+        }
+
+        void invalidate_fd(uint64_t fd) noexcept
+        {
+            auto it = _keys.find(fd);
+
+            if (it != _keys.end())
+            {
+                invalidate(it->second);
+            }
+        }
+
+        void invalidate_key(std::string_view key) noexcept
+        {
+            forget(key);
+
+            auto it = _entries.lower_bound(key);
+
+            while (it != _entries.end() && it->first.compare(0, key.size(), key) == 0)
+            {
+                if (key.back() == '/' || it->first[key.size()] == '/')
+                {
+                    erase(it++);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        inline bool is_filtered(std::string_view path) const noexcept
+        {
+            auto &root = _filter_root;
+
+            return path.size() >= root.size() && path.compare(0, root.size(), root) == 0 &&
+                   (path.size() == root.size() || root.back() == '/' || path[root.size()] == '/');
+        }
+
+        inline bool filtering() const noexcept
+        {
+            return _filter || _rebuilding;
+        }
+
+        void admit(std::string_view path) noexcept
+        {
+            if (!filtering())
+            {
+                return;
+            }
+
+            std::string folded;
+            auto key = key_of(path, folded);
+
+            if (key.empty())
+            {
+                // the created path is unknown, so only a fresh walk can cover it
+                rebuild();
+            }
+            else if (is_filtered(key))
+            {
+                admit_key(key);
+            }
+        }
+
+        void admit_key(std::string_view key) noexcept
+        {
+            if (!_rebuilding)
+            {
+                _filter->insert(key);
+                return;
+            }
+
+            // the walk may already be past this path, so it is replayed onto the new filter
+            try
+            {
+                _backlog.emplace_back(key);
+            }
+            catch (...)
+            {
+                disable_filter();
+            }
+        }
+
+        void forget(std::string_view path) noexcept
+        {
+            auto it = _entries.find(path);
+
+            if (it != _entries.end())
+            {
+                erase(it);
+            }
+        }
+
+        void created(std::string_view path, int err) noexcept
+        {
+            invalidate(path);
+
+            if (err == 0 || err == EEXIST)
+            {
+                admit(path);
+            }
+        }
+
+        void created_ancestors(std::string_view path) noexcept
+        {
+            ++_generation;
+
+            std::string folded;
+            auto key = key_of(path, folded);
+
+            if (key.empty())
+            {
+                clear();
+
+                if (filtering())
+                {
+                    rebuild();
+                }
+
+                return;
+            }
+
+            path = key;
+
+            for (auto end = path.rfind('/'); end != std::string_view::npos && end > 0; end = path.rfind('/', end - 1))
+            {
+                auto ancestor = path.substr(0, end);
+
+                forget(ancestor);
+                admit(ancestor);
+            }
+        }
+
+        void rescan(std::string_view path, int err) noexcept
+        {
+            invalidate(path);
+
+            if (err != 0 || !filtering())
+            {
+                return;
+            }
+
+            std::string folded;
+            auto key = key_of(path, folded);
+
+            if (key.empty())
+            {
+                rebuild();
+            }
+            else if (is_filtered(key) && walk(key, false) != 0)
+            {
+                disable_filter();
+            }
+        }
+
+        void retire(std::string_view path) noexcept
+        {
+            // keys are never erased from the filter, since the decorator cannot tell which paths it admitted;
+            // stale keys only cost false positives, so the filter is rebuilt once enough of them pile up
+            std::string folded;
+            auto key = key_of(path, folded);
+
+            if (!_filter || (!key.empty() && !is_filtered(key)) || ++_retired <= _filter_expected / 4)
+            {
+                return;
+            }
+
+            rebuild();
+        }
+
+        void rebuild() noexcept
+        {
+            if (_rebuilding)
+            {
+                _stale = true;
+                return;
+            }
+
+            // lookups go to the inner filesystem until the new filter is swapped in by walked()
+            _filter.reset();
+            _retired = 0;
+
+            if (walk(_filter_root, true) != 0)
+            {
+                disable_filter();
+            }
+        }
+
+        int walk(std::string_view root, bool full) noexcept
+        {
+            auto job = new(std::nothrow) walk_job {};
+
+            if (job == nullptr)
+            {
+                return -ENOMEM;
+            }
+
+            try
+            {
+                job->root.assign(root);
+                job->epoch = _epoch;
+
+                if (full)
+                {
+                    job->filter = std::make_unique<counting_bloom_filter>(
+                        counting_bloom_filter::for_capacity(_filter_expected, _filter_rate));
+                }
+            }
+            catch (...)
+            {
+                delete job;
+                return -ENOMEM;
+            }
+
+            auto result = _executor([job]()
+            {
+                job->result = scan(job->root, [job](std::string_view path)
+                {
+                    if (job->filter)
+                    {
+                        job->filter->insert(path);
+                    }
+                    else
+                    {
+                        job->keys.emplace_back(path);
+                    }
+                });
+            }, [this, job]()
+            {
+                walked(*job);
+
+                delete job;
+            });
+
+            if (result != 0)
+            {
+                delete job;
+                return result;
+            }
+
+            ++_walks;
+            _rebuilding |= full;
+
+            return 0;
+        }
+
+        void walked(walk_job &job) noexcept
+        {
+            if (job.epoch != _epoch)
+            {
+                return;
+            }
+
+            --_walks;
+
+            if (!job.filter)
+            {
+                if (job.result == -ENOMEM)
+                {
+                    rebuild();
+                    return;
+                }
+
+                // a subtree that vanished before its walk has nothing left to admit
+                for (auto &key : job.keys)
+                {
+                    admit_key(key);
+                }
+
+                return;
+            }
+
+            _rebuilding = false;
+
+            if (_stale)
+            {
+                _stale = false;
+                _backlog.clear();
+
+                rebuild();
+                return;
+            }
+
+            if (job.result != 0)
+            {
+                disable_filter();
+                return;
+            }
+
+            for (auto &key : _backlog)
+            {
+                job.filter->insert(key);
+            }
+
+            _backlog.clear();
+            _filter = std::move(job.filter);
+        }
+
+        // runs on the executor, so it touches nothing but its arguments
+        template<typename t_fn>
+        static int scan(const std::string &root, t_fn admit) noexcept
+        {
+            try
+            {
+                std::vector<std::string> pending {std::string {root}};
+
+                while (!pending.empty())
+                {
+                    auto path = std::move(pending.back());
+
+                    pending.pop_back();
+
+                    struct ::stat st {};
+
+                    if (::lstat(path.c_str(), &st) != 0)
+                    {
+                        if (path.size() == root.size())
+                        {
+                            return -errno;
+                        }
+
+                        continue;
+                    }
+
+                    admit(std::string_view {path});
+
+                    if (!S_ISDIR(st.st_mode))
+                    {
+                        continue;
+                    }
+
+                    auto dir = ::opendir(path.c_str());
+
+                    if (dir == nullptr)
+                    {
+                        continue;
+                    }
+
+                    while (auto ent = ::readdir(dir))
+                    {
+                        std::string_view name {ent->d_name};
+
+                        if (name == "." || name == "..")
+                        {
+                            continue;
+                        }
+
+                        auto &child = pending.emplace_back(path);
+
+                        if (child.empty() || child.back() != '/')
+                        {
+                            child.push_back('/');
+                        }
+
+                        child.append(name);
+                    }
+
+                    ::closedir(dir);
+                }
+
+                return 0;
+            }
+            catch (...)
+            {
+                return -ENOMEM;
+            }
+        }
+
+      public:
+
+        // filter walks run through the executor, so it must move them off the caller's loop thread
+        stat_cache_filesystem(filesystem_type &inner,
+                              stat_cache_executor executor,
+                              std::size_t capacity = default_capacity,
+                              uint64_t ttl = default_ttl,
+                              stat_cache_clock clock = nullptr) noexcept
+            : proxy_type(inner), _capacity(capacity), _ttl(ttl), _clock(std::move(clock)),
+              _executor(std::move(executor)), _filter_expected(0), _filter_rate(0), _retired(0), _epoch(0),
+              _walks(0), _rebuilding(false), _stale(false), _generation(0), _stats({})
+        {
+            assert(_executor);
+
+            if (!_clock)
+            {
+                _clock = &steady_now;
+            }
+        }
+
+        inline std::size_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        inline uint64_t ttl() const noexcept
+        {
+            return _ttl;
+        }
+
+        void invalidate(std::string_view path) noexcept
+        {
+            ++_generation;
+
+            std::string folded;
+            auto key = key_of(path, folded);
+
+            if (key.empty())
+            {
+                clear();
+                return;
+            }
+
+            invalidate_key(key);
+        }
+
+        int enable_filter(std::string_view root, std::size_t expected, double false_positive_rate = 0.01) noexcept
+        {
+            disable_filter();
+
+            std::string folded;
+            auto key = key_of(root, folded);
+
+            if (key.empty())
+            {
+                return -EINVAL;
+            }
+
+            try
+            {
+                _filter_root.assign(key);
+                _filter_expected = expected;
+                _filter_rate = false_positive_rate;
+            }
+            catch (...)
+            {
+                return -ENOMEM;
+            }
+
+            clear();
+
+            // the filter is built by a walk on the executor and only answers lookups once it lands
+            auto result = walk(_filter_root, true);
+
+            if (result != 0)
+            {
+                disable_filter();
+            }
+
+            return result;
+        }
+
+        void disable_filter() noexcept
+        {
+            ++_epoch;
+
+            _filter.reset();
+            _retired = 0;
+            _walks = 0;
+            _rebuilding = false;
+            _stale = false;
+            _backlog.clear();
+        }
+
+        inline const counting_bloom_filter *filter() const noexcept
+        {
+            return _filter.get();
+        }
+
+        void changed(std::string_view path) noexcept
+        {
+            invalidate(path);
+            admit(path);
+        }
+
+        void clear() noexcept
+        {
+            ++_generation;
+
+            _entries.clear();
+            _lru.clear();
+        }
+
+        inline stat_cache_stats stats() const noexcept
+        {
+            auto stats = _stats;
+
+            stats.size = _entries.size();
+
+            return stats;
+        }
+
+        using proxy_type::stat;
+        using proxy_type::mkdir;
+        using proxy_type::mkdirs;
+        using proxy_type::create;
+        using proxy_type::open;
+
+        int exists(t_path path, exists_cb cb) noexcept override
+        {
+            int err = 0;
+            t_stat stat;
+
+            if (lookup(path.view(), err, stat))
+            {
+                cb(path, 0, err == 0);
+                return 0;
+            }
+
+            return _inner.stat(path, [this, generation = _generation, cb = std::move(cb)](t_path &path, int err,
+                                                                                          t_stat stat) mutable
+            {
+                cache(path, generation, err, stat);
+
+                cb(path, err == ENOENT ? 0 : err, err == 0);
+            });
+        }
+
+        int stat(t_path path, stat_cb cb) noexcept override
+        {
+            int err = 0;
+            t_stat stat;
+
+            if (lookup(path.view(), err, stat))
+            {
+                cb(path, err, std::move(stat));
+                return 0;
+            }
+
+            return _inner.stat(path, [this, generation = _generation, cb = std::move(cb)](t_path &path, int err,
+                                                                                          t_stat stat) mutable
+            {
+                cache(path, generation, err, stat);
+
+                cb(path, err, std::move(stat));
+            });
+        }
+
+        int mkdir(t_path path, int32_t mode, mkdir_cb cb) noexcept override
+        {
+            return _inner.mkdir(path, mode, [this, cb = std::move(cb)](t_path &path, int err) mutable
+            {
+                created(path.view(), err);
+
+                cb(path, err);
+            });
+        }
+
+        int mkdirs(t_path path, int32_t mode, mkdirs_cb cb) noexcept override
+        {
+            return _inner.mkdirs(path, mode, [this, cb = std::move(cb)](t_path &path, int err) mutable
+            {
+                if (err == 0)
+                {
+                    created_ancestors(path.view());
+                }
+
+                created(path.view(), err);
+
+                cb(path, err);
+            });
+        }
+
+        int create(t_path path, int32_t mode, create_cb cb) noexcept override
+        {
+            return _inner.create(path, mode, [this, cb = std::move(cb)](t_path &path, int err) mutable
+            {
+                created(path.view(), err);
+
+                cb(path, err);
+            });
+        }
+
+        int move(t_path path, t_path move_path, move_cb cb) noexcept override
+        {
+            invalidate(path.view());
+            invalidate(move_path.view());
+
+            return _inner.move(path, move_path, [this, cb = std::move(cb)](t_path &path, t_path &move_path,
+                                                                           int err) mutable
+            {
+                invalidate(path.view());
+
+                if (err == 0)
+                {
+                    retire(path.view());
+                }
+
+                rescan(move_path.view(), err);
+
+                cb(path, move_path, err);
+            });
+        }
+
+        int copy(t_path path, t_path copy_path, copy_cb cb) noexcept override
+        {
+            invalidate(copy_path.view());
+
+            return _inner.copy(path, copy_path, [this, cb = std::move(cb)](t_path &path, t_path &copy_path,
+                                                                           int err) mutable
+            {
+                rescan(copy_path.view(), err);
+
+                cb(path, copy_path, err);
+            });
+        }
+
+        int link(t_path path, t_path other_path, link_cb cb) noexcept override
+        {
+            return _inner.link(path, other_path, [this, cb = std::move(cb)](t_path &path, t_path &other_path,
+                                                                            int err) mutable
+            {
+                invalidate(path.view());
+                created(other_path.view(), err);
+
+                cb(path, other_path, err);
+            });
+        }
+
+        int symlink(t_path path, t_path other_path, symlink_cb cb) noexcept override
+        {
+            return _inner.symlink(path, other_path, [this, cb = std::move(cb)](t_path &path, t_path &other_path,
+                                                                               int err) mutable
+            {
+                invalidate(path.view());
+                created(other_path.view(), err);
+
+                cb(path, other_path, err);
+            });
+        }
+
+        int unlink(t_path path, unlink_cb cb) noexcept override
+        {
+            invalidate(path.view());
+
+            return _inner.unlink(path, [this, cb = std::move(cb)](t_path &path, int err) mutable
+            {
+                invalidate(path.view());
+
+                if (err == 0)
+                {
+                    retire(path.view());
+                }
+
+                cb(path, err);
+            });
+        }
+
+        int open(t_path path, int32_t mode, int32_t flags, open_cb cb) noexcept override
+        {
+            auto creating = (flags & (O_CREAT | O_TRUNC)) != 0;
+
+            if (creating)
+            {
+                invalidate(path.view());
+            }
+
+            return _inner.open(path, mode, flags, [this, creating, cb = std::move(cb)](t_path &path, int err,
+                                                                                       t_file &file) mutable
+            {
+                if (creating)
+                {
+                    created(path.view(), err);
+                }
+
+                if (err == 0)
+                {
+                    opened(file, path.view());
+                }
+
+                cb(path, err, file);
+            });
+        }
+
+        int write(t_file file, t_buffer buf, off64_t off, write_cb cb) noexcept override
+        {
+            invalidate_fd(file.fd());
+
+            return _inner.write(file, std::move(buf), off, [this, cb = std::move(cb)](t_file &file, int err,
+                                                                                      t_buffer &buf) mutable
+            {
+                invalidate_fd(file.fd());
+
+                cb(file, err, buf);
+            });
+        }
+
+        int writev(t_file file, std::vector<t_buffer> bufs, off64_t off, writev_cb cb) noexcept override
+        {
+            invalidate_fd(file.fd());
+
+            return _inner.writev(file, std::move(bufs), off, [this, cb = std::move(cb)](
+                t_file &file, int err, std::vector<t_buffer> &bufs) mutable
+            {
+                invalidate_fd(file.fd());
+
+                cb(file, err, bufs);
+            });
+        }
+
+        int truncate(t_file file, uint64_t size, truncate_cb cb) noexcept override
+        {
+            invalidate_fd(file.fd());
+
+            return _inner.truncate(file, size, [this, cb = std::move(cb)](t_file &file, int err,
+                                                                          uint64_t size) mutable
+            {
+                invalidate_fd(file.fd());
+
+                cb(file, err, size);
+            });
+        }
+
+        int close(t_file file, close_cb cb) noexcept override
+        {
+            // the key leaves the map before the close is issued, so a reused fd cannot be clobbered
+            std::string key;
+            auto it = _keys.find(file.fd());
+            auto tracked = it != _keys.end();
+
+            if (tracked)
+            {
+                key = std::move(it->second);
+                _keys.erase(it);
+            }
+
+            return _inner.close(file, [this, tracked, key = std::move(key), cb = std::move(cb)](t_file &file,
+                                                                                               int err) mutable
+            {
+                if (tracked)
+                {
+                    invalidate(key);
+                }
+
+                cb(file, err);
+            });
+        }
+    };
+}
+
+#endif
@@ -12,6 +12,7 @@ namespace vfs
         virtual ~stat()
         {};
 
+        virtual uint64_t dev() const noexcept = 0;
         virtual uint64_t inode() const noexcept = 0;
         virtual uint64_t size() const noexcept = 0;
         virtual uint64_t atime() const noexcept = 0;
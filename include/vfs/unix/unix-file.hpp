@@ -0,0 +1,28 @@
+#ifndef VFS_UNIX_FILE_HPP
+#define VFS_UNIX_FILE_HPP
+
+#include <vfs/file.hpp>
+
+namespace vfs
+{
+    template<typename t_path>
+    class unix_file : public file_base<t_path>
+    {
+      public:
+
+        unix_file(t_path &path)
+            : file_base<t_path>(path)
+        {};
+
+        unix_file(t_path &path, int fd)
+            : file_base<t_path>(path, static_cast<uint64_t>(fd))
+        {};
+
+        inline int unix_fd() const
+        {
+            return static_cast<int>(this->fd());
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef VFS_UNIX_FILESYSTEM_HPP
+#define VFS_UNIX_FILESYSTEM_HPP
+
+#include <fcntl.h>
+#include <vector>
+
+#include <vfs/path.hpp>
+#include <vfs/filesystem.hpp>
+
+#include "unix-path.hpp"
+#include "unix-stat.hpp"
+#include "unix-file.hpp"
+
+namespace vfs
+{
+    using _unix_path_t = vfs::any_path;
+    using _unix_stat_t = vfs::unix_stat;
+    using _unix_file_t = vfs::unix_file<_unix_path_t>;
+    using _unix_buf_t = vfs::buffer;
+    using _unix_filesystem = vfs::filesystem<_unix_path_t, _unix_stat_t, _unix_file_t, _unix_buf_t>;
+
+    class unix_filesystem :
+        public _unix_filesystem
+    {
+
+      private:
+
+        int _dir_fd;
+
+      public:
+
+        unix_filesystem() noexcept
+            : _dir_fd(AT_FDCWD)
+        {};
+
+        explicit unix_filesystem(int dir_fd) noexcept
+            : _dir_fd(dir_fd)
+        {};
+
+        inline int dir_fd() const noexcept
+        {
+            return _dir_fd;
+        }
+
+        using _unix_filesystem::mkdir;
+        using _unix_filesystem::mkdirs;
+        using _unix_filesystem::create;
+        using _unix_filesystem::open;
+
+        int exists(_unix_path_t path, exists_cb cb) noexcept override;
+        int stat(_unix_path_t path, stat_cb cb) noexcept override;
+        int mkdir(_unix_path_t path, int32_t mode, mkdir_cb cb) noexcept override;
+        int mkdirs(_unix_path_t path, int32_t mode, mkdirs_cb cb) noexcept override;
+        int create(_unix_path_t path, int32_t mode, create_cb cb) noexcept override;
+        int move(_unix_path_t path, _unix_path_t move_path, move_cb cb) noexcept override;
+        int copy(_unix_path_t path, _unix_path_t copy_path, copy_cb cb) noexcept override;
+        int link(_unix_path_t path, _unix_path_t other_path, link_cb cb) noexcept override;
+        int symlink(_unix_path_t path, _unix_path_t link_path, symlink_cb cb) noexcept override;
+        int unlink(_unix_path_t path, unlink_cb cb) noexcept override;
+
+        int open(_unix_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept override;
+        int stat(_unix_file_t file, fstat_cb cb) noexcept override;
+        int read(_unix_file_t file, _unix_buf_t buf, off64_t off, read_cb cb) noexcept override;
+        int write(_unix_file_t file, _unix_buf_t buf, off64_t off, write_cb cb) noexcept override;
+        int readv(_unix_file_t file, std::vector<_unix_buf_t> bufs, off64_t off, readv_cb cb) noexcept override;
+        int writev(_unix_file_t file, std::vector<_unix_buf_t> bufs, off64_t off, writev_cb cb) noexcept override;
+        int truncate(_unix_file_t file, uint64_t size, truncate_cb cb) noexcept override;
+        int close(_unix_file_t file, close_cb cb) noexcept override;
+    };
+}
+
+#endif
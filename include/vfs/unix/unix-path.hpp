@@ -1,17 +1,27 @@
 #ifndef VFS_UNIX_PATH_H
 #define VFS_UNIX_PATH_H
 
+#include <functional>
+
 #include <vfs/path.hpp>
+#include <vfs/path-normalize.hpp>
 
 namespace vfs
 {
-    class unix_path :
+    class unix_path final :
         public base_path<unix_path>
     {
 
       private:
         std::string _value;
 
+        inline bool contains(const char *ptr) const noexcept
+        {
+            auto begin = _value.data();
+
+            return !std::less<const char *> {}(ptr, begin) && std::less<const char *> {}(ptr, begin + _value.size());
+        }
+
       public:
         unix_path() noexcept : _value("")
         {}
@@ -74,10 +84,35 @@ namespace vfs
             return !is_empty && !has_double_separator;
         }
 
-        unix_path &prepend(unix_path &path) noexcept override
+        inline int validate() const noexcept
         {
-            bool requires_sep = !has_leading_separator() && !path.has_trailing_separator();
-            bool requires_trim = has_leading_separator() && path.has_trailing_separator();
+            return validate_path(_value);
+        }
+
+        inline unix_path &normalize() noexcept
+        {
+            _value.resize(normalize_path(&_value[0], _value.size()));
+
+            return *this;
+        }
+
+        inline unix_path &prepend(unix_path &path) noexcept override
+        {
+            return prepend(std::string_view {path._value});
+        }
+
+        unix_path &prepend(std::string_view val) noexcept override
+        {
+            if (contains(val.data()))
+            {
+                std::string copy {val};
+
+                return prepend(std::string_view {copy});
+            }
+
+            bool has_val_trailing_separator = !val.empty() && val.back() == unix_path::separator_c();
+            bool requires_sep = !has_leading_separator() && !has_val_trailing_separator;
+            bool requires_trim = has_leading_separator() && has_val_trailing_separator;
 
             if (requires_sep)
             {
@@ -88,27 +123,28 @@ namespace vfs
                 _value.erase(0, 1);
             }
 
-            _value.insert(0, path._value);
+            _value.insert(0, val);
 
             return *this;
         }
 
-        inline unix_path &prepend(std::string &val) noexcept override
+        inline unix_path &append(unix_path &path) noexcept override
         {
-            unix_path path {val};
-            return prepend(path);
+            return append(std::string_view {path._value});
         }
 
-        inline unix_path &prepend(std::string &&val) noexcept override
+        unix_path &append(std::string_view val) noexcept override
         {
-            unix_path path {val};
-            return prepend(path);
-        }
+            if (contains(val.data()))
+            {
+                std::string copy {val};
 
-        unix_path &append(unix_path &path) noexcept override
-        {
-            bool requires_sep = !has_trailing_separator() && !path.has_leading_separator();
-            bool requires_trim = has_trailing_separator() && path.has_leading_separator();
+                return append(std::string_view {copy});
+            }
+
+            bool has_val_leading_separator = !val.empty() && val.front() == unix_path::separator_c();
+            bool requires_sep = !has_trailing_separator() && !has_val_leading_separator;
+            bool requires_trim = has_trailing_separator() && has_val_leading_separator;
 
             if (requires_sep)
             {
@@ -119,23 +155,11 @@ namespace vfs
                 _value.resize(_value.size() - 1);
             }
 
-            _value.append(path._value);
+            _value.append(val);
 
             return *this;
         }
 
-        inline unix_path &append(std::string &val) noexcept override
-        {
-            unix_path path {val};
-            return append(path);
-        }
-
-        inline unix_path &append(std::string &&val) noexcept override
-        {
-            unix_path path {val};
-            return append(path);
-        }
-
         unix_path &parent() noexcept override
         {
             if (!is_root())
@@ -191,6 +215,16 @@ namespace vfs
             return _value;
         }
 
+        inline const char *c_str() const noexcept override
+        {
+            return _value.c_str();
+        }
+
+        inline std::string_view view() const noexcept override
+        {
+            return _value;
+        }
+
         static inline constexpr char separator_c()
         {
             return '/';
@@ -206,12 +240,12 @@ namespace vfs
 
         inline bool has_leading_separator() const
         {
-            return *_value.begin() == unix_path::separator_c();
+            return !_value.empty() && _value.front() == unix_path::separator_c();
         }
 
         inline bool has_trailing_separator() const
         {
-            return *(--_value.end()) == unix_path::separator_c();
+            return !_value.empty() && _value.back() == unix_path::separator_c();
         }
     };
 }
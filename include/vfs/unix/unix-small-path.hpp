@@ -0,0 +1,345 @@
+#ifndef VFS_UNIX_SMALL_PATH_HPP
+#define VFS_UNIX_SMALL_PATH_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <vfs/path.hpp>
+#include <vfs/path-normalize.hpp>
+#include <vfs/small-vector.hpp>
+
+namespace vfs
+{
+    class unix_small_path final :
+        public base_path<unix_small_path>
+    {
+
+      public:
+
+        static const std::size_t inline_capacity = 256;
+        static const std::size_t inline_components = 16;
+
+      private:
+
+        small_vector<char, inline_capacity> _value;
+        small_vector<uint32_t, inline_components> _separators;
+
+        mutable std::string _str;
+
+        inline std::size_t length() const noexcept
+        {
+            return _value.size() - 1;
+        }
+
+        inline void truncate(std::size_t size) noexcept
+        {
+            _value.resize(size + 1);
+            _value[size] = '\0';
+        }
+
+        void index(std::size_t from) noexcept
+        {
+            for (auto i = from; i < length(); ++i)
+            {
+                if (_value[i] == separator_c())
+                {
+                    _separators.push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+
+        void reindex() noexcept
+        {
+            _separators.clear();
+
+            index(0);
+        }
+
+        void trim_trailing_separator() noexcept
+        {
+            if (has_trailing_separator())
+            {
+                _separators.pop_back();
+                truncate(length() - 1);
+            }
+        }
+
+      public:
+
+        unix_small_path() noexcept
+        {
+            _value.push_back('\0');
+        }
+
+        explicit unix_small_path(std::string_view value) noexcept
+            : unix_small_path()
+        {
+            _value.insert(0, value.data(), value.size());
+
+            index(0);
+        }
+
+        unix_small_path(const unix_small_path &lhs) noexcept
+            : _value(lhs._value), _separators(lhs._separators)
+        {}
+
+        inline unix_small_path &operator=(const unix_small_path &other) noexcept
+        {
+            _value = other._value;
+            _separators = other._separators;
+
+            return *this;
+        }
+
+        inline unix_small_path &operator=(const path &other) noexcept
+        {
+            auto value = other.view();
+
+            _value.assign(value.data(), value.size());
+            _value.push_back('\0');
+
+            reindex();
+
+            return *this;
+        }
+
+        inline any_path to_any() noexcept
+        {
+            auto &self = *this;
+            return vfs::any_path {self};
+        }
+
+        inline bool is_inline() const noexcept
+        {
+            return _value.is_inline() && _separators.is_inline();
+        }
+
+        inline std::size_t components() const noexcept
+        {
+            return _separators.size() + (length() > 0 && !has_trailing_separator() ? 1 : 0) -
+                   (has_leading_separator() ? 1 : 0);
+        }
+
+        inline bool is_root() const noexcept override
+        {
+            return length() == 1 && _value[0] == separator_c();
+        }
+
+        inline bool is_absolute() const noexcept override
+        {
+            return has_leading_separator();
+        }
+
+        inline bool is_relative() const noexcept override
+        {
+            return !has_leading_separator();
+        }
+
+        bool is_valid() const noexcept override
+        {
+            if (length() == 0)
+            {
+                return false;
+            }
+
+            for (std::size_t i = 1; i < _separators.size(); ++i)
+            {
+                if (_separators[i] == _separators[i - 1] + 1)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        inline int validate() const noexcept
+        {
+            return validate_path(view());
+        }
+
+        unix_small_path &normalize() noexcept
+        {
+            auto size = normalize_path(_value.data(), length());
+
+            if (size != length())
+            {
+                truncate(size);
+                reindex();
+            }
+
+            return *this;
+        }
+
+        inline unix_small_path &prepend(unix_small_path &path) noexcept override
+        {
+            if (&path == this)
+            {
+                unix_small_path copy {path};
+
+                return prepend(copy.view());
+            }
+
+            return prepend(path.view());
+        }
+
+        unix_small_path &prepend(std::string_view val) noexcept override
+        {
+            if (_value.contains(val.data()))
+            {
+                unix_small_path copy {val};
+
+                return prepend(copy.view());
+            }
+
+            bool has_val_trailing_separator = !val.empty() && val.back() == separator_c();
+            bool requires_sep = !has_leading_separator() && !has_val_trailing_separator;
+            bool requires_trim = has_leading_separator() && has_val_trailing_separator;
+
+            if (requires_sep)
+            {
+                auto sep = separator_c();
+
+                _value.insert(0, &sep, 1);
+            }
+            else if (requires_trim)
+            {
+                _value.erase(0, 1);
+            }
+
+            _value.insert(0, val.data(), val.size());
+
+            reindex();
+
+            return *this;
+        }
+
+        inline unix_small_path &append(unix_small_path &path) noexcept override
+        {
+            if (&path == this)
+            {
+                unix_small_path copy {path};
+
+                return append(copy.view());
+            }
+
+            return append(path.view());
+        }
+
+        unix_small_path &append(std::string_view val) noexcept override
+        {
+            if (_value.contains(val.data()))
+            {
+                unix_small_path copy {val};
+
+                return append(copy.view());
+            }
+
+            bool has_val_leading_separator = !val.empty() && val.front() == separator_c();
+            bool requires_sep = !has_trailing_separator() && !has_val_leading_separator;
+            bool requires_trim = has_trailing_separator() && has_val_leading_separator;
+
+            if (requires_trim)
+            {
+                trim_trailing_separator();
+            }
+
+            auto from = length();
+
+            _value.insert(from, val.data(), val.size());
+
+            if (requires_sep)
+            {
+                auto sep = separator_c();
+
+                _value.insert(from, &sep, 1);
+            }
+
+            index(from);
+
+            return *this;
+        }
+
+        unix_small_path &parent() noexcept override
+        {
+            if (!is_root())
+            {
+                trim_trailing_separator();
+
+                if (!_separators.empty())
+                {
+                    truncate(_separators.back());
+                    _separators.pop_back();
+                }
+                else
+                {
+                    prepend("..");
+                }
+            }
+
+            return *this;
+        }
+
+        inline unix_small_path &filename() noexcept override
+        {
+            if (!is_root())
+            {
+                trim_trailing_separator();
+
+                if (!_separators.empty())
+                {
+                    _value.erase(0, _separators.back());
+                    _separators.clear();
+                    _separators.push_back(0);
+                }
+            }
+
+            return *this;
+        }
+
+        inline unix_small_path &clear() noexcept override
+        {
+            truncate(0);
+            _separators.clear();
+
+            return *this;
+        }
+
+        inline const std::string &str() const noexcept override
+        {
+            _str.assign(_value.data(), length());
+
+            return _str;
+        }
+
+        inline const char *c_str() const noexcept override
+        {
+            return _value.data();
+        }
+
+        inline std::string_view view() const noexcept override
+        {
+            return std::string_view {_value.data(), length()};
+        }
+
+        static inline constexpr char separator_c()
+        {
+            return '/';
+        }
+
+      private:
+
+        inline bool has_leading_separator() const noexcept
+        {
+            return length() > 0 && _value[0] == separator_c();
+        }
+
+        inline bool has_trailing_separator() const noexcept
+        {
+            return length() > 0 && _value[length() - 1] == separator_c();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef VFS_UNIX_STAT_HPP
+#define VFS_UNIX_STAT_HPP
+
+#include <sys/stat.h>
+#include <vfs/stat.hpp>
+
+namespace vfs
+{
+    class unix_stat : public stat
+    {
+      private:
+        struct stat64 _stat;
+
+      public:
+        unix_stat() noexcept
+            : _stat({})
+        {}
+
+        unix_stat(const struct stat64 &stat) noexcept
+            : _stat(stat)
+        {}
+
+        unix_stat(const unix_stat &lhs) noexcept
+            : _stat(lhs._stat)
+        {}
+
+        inline unix_stat &operator=(const unix_stat &other) noexcept
+        {
+            _stat = other._stat;
+            return *this;
+        }
+
+        inline bool operator==(const unix_stat &other) const noexcept
+        {
+            return inode() == other.inode();
+        }
+
+        inline uint64_t dev() const noexcept override
+        {
+            return _stat.st_dev;
+        }
+
+        inline uint64_t inode() const noexcept override
+        {
+            return _stat.st_ino;
+        }
+
+        inline uint64_t size() const noexcept override
+        {
+            return static_cast<uint64_t>(_stat.st_size);
+        }
+
+        inline uint64_t atime() const noexcept override
+        {
+            return timestamp_from_timespec(_stat.st_atim);
+        }
+
+        inline uint64_t mtime() const noexcept override
+        {
+            return timestamp_from_timespec(_stat.st_mtim);
+        }
+
+        inline uint64_t ctime() const noexcept override
+        {
+            return timestamp_from_timespec(_stat.st_ctim);
+        }
+
+        inline uint32_t uid() const noexcept override
+        {
+            return static_cast<uint32_t>(_stat.st_uid);
+        }
+
+        inline uint32_t gid() const noexcept override
+        {
+            return static_cast<uint32_t>(_stat.st_gid);
+        }
+
+        inline bool is_file() const noexcept override
+        {
+            return S_ISREG(_stat.st_mode);
+        }
+
+        inline bool is_link() const noexcept override
+        {
+            return S_ISLNK(_stat.st_mode);
+        }
+
+        inline bool is_dir() const noexcept override
+        {
+            return S_ISDIR(_stat.st_mode);
+        }
+
+        inline bool is_block() const noexcept override
+        {
+            return S_ISBLK(_stat.st_mode);
+        }
+
+        inline bool is_fifo() const noexcept override
+        {
+            return S_ISFIFO(_stat.st_mode);
+        }
+
+        inline bool is_sock() const noexcept override
+        {
+            return S_ISSOCK(_stat.st_mode);
+        }
+
+      private:
+
+        inline uint64_t timestamp_from_timespec(const timespec &ts) const
+        {
+            auto sec = static_cast<uint64_t>(ts.tv_sec);
+            auto ms = static_cast<uint64_t>((ts.tv_nsec + 500000) / 1000000);
+
+            if (ms > 999)
+            {
+                ++sec;
+                ms = 0;
+            }
+
+            return (sec * 1000) + ms;
+        }
+    };
+}
+
+#endif
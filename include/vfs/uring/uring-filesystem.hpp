@@ -0,0 +1,109 @@
+#ifndef VFS_URING_FILESYSTEM_HPP
+#define VFS_URING_FILESYSTEM_HPP
+
+#include <uv.h>
+
+#include <vfs/filesystem.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+
+#include "uring.hpp"
+
+namespace vfs::uring
+{
+    using _uring_path_t = vfs::uv::_uv_path_t;
+    using _uring_stat_t = vfs::uv::_uv_stat_t;
+    using _uring_file_t = vfs::uv::_uv_file_t;
+    using _uring_buf_t = vfs::uv::_uv_buf_t;
+    using _uring_filesystem = vfs::uv::_uv_filesystem;
+
+    struct uring_req;
+
+    class uring_filesystem :
+        public _uring_filesystem
+    {
+
+      private:
+
+        vfs::uv::uv_filesystem _uv_fs;
+        vfs::uring::uring _ring;
+
+        uv_prepare_t _uv_prepare;
+        uv_poll_t _uv_poll;
+
+        uint64_t _in_flight;
+        bool _polling;
+
+        void init() noexcept;
+
+        io_uring_sqe *get_sqe() noexcept;
+        void queue(io_uring_sqe *sqe, uring_req *req) noexcept;
+        void reap() noexcept;
+
+        inline bool uses_ring(uint8_t op) const noexcept
+        {
+            return _ring.is_open() && _ring.supports(op);
+        }
+
+      public:
+
+        static const unsigned default_entries = 256;
+
+        explicit uring_filesystem(unsigned entries = default_entries);
+
+        explicit uring_filesystem(vfs::uv::unique_uv_loop &&uv_loop, unsigned entries = default_entries);
+
+        uring_filesystem(const uring_filesystem &lhs) = delete;
+
+        uring_filesystem &operator=(const uring_filesystem &lhs) = delete;
+
+        ~uring_filesystem() noexcept override;
+
+        inline vfs::uv::uv_loop &loop() const noexcept
+        {
+            return _uv_fs.loop();
+        }
+
+        inline vfs::uv::uv_filesystem &fallback() noexcept
+        {
+            return _uv_fs;
+        }
+
+        inline bool is_uring() const noexcept
+        {
+            return _ring.is_open();
+        }
+
+        int submit() noexcept;
+
+        using _uring_filesystem::mkdir;
+        using _uring_filesystem::mkdirs;
+        using _uring_filesystem::create;
+        using _uring_filesystem::open;
+        using _uring_filesystem::readdir;
+
+        int exists(_uring_path_t path, exists_cb cb) noexcept override;
+        int stat(_uring_path_t path, stat_cb cb) noexcept override;
+        int mkdir(_uring_path_t path, int32_t mode, mkdir_cb cb) noexcept override;
+        int mkdirs(_uring_path_t path, int32_t mode, mkdirs_cb cb) noexcept override;
+        int create(_uring_path_t path, int32_t mode, create_cb cb) noexcept override;
+        int move(_uring_path_t path, _uring_path_t move_path, move_cb cb) noexcept override;
+        int copy(_uring_path_t path, _uring_path_t copy_path, copy_cb cb) noexcept override;
+        int link(_uring_path_t path, _uring_path_t other_path, link_cb cb) noexcept override;
+        int symlink(_uring_path_t path, _uring_path_t link_path, symlink_cb cb) noexcept override;
+        int unlink(_uring_path_t path, unlink_cb cb) noexcept override;
+
+        int open(_uring_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept override;
+        int stat(_uring_file_t file, fstat_cb cb) noexcept override;
+        int read(_uring_file_t file, _uring_buf_t buf, off64_t off, read_cb cb) noexcept override;
+        int write(_uring_file_t file, _uring_buf_t buf, off64_t off, write_cb cb) noexcept override;
+        int readv(_uring_file_t file, std::vector<_uring_buf_t> bufs, off64_t off, readv_cb cb) noexcept override;
+        int writev(_uring_file_t file, std::vector<_uring_buf_t> bufs, off64_t off, writev_cb cb) noexcept override;
+        int truncate(_uring_file_t file, uint64_t size, truncate_cb cb) noexcept override;
+        int close(_uring_file_t file, close_cb cb) noexcept override;
+
+        int map(_uring_file_t file, uint64_t off, uint64_t len, int32_t flags, map_cb cb) noexcept override;
+        int readdir(_uring_path_t path, std::size_t batch_size, uint64_t cursor, readdir_cb cb) noexcept override;
+    };
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef VFS_URING_HPP
+#define VFS_URING_HPP
+
+#include <linux/io_uring.h>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace vfs::uring
+{
+    class uring
+    {
+      private:
+
+        int _fd;
+        int _event_fd;
+
+        void *_sq_ptr;
+        std::size_t _sq_len;
+        void *_cq_ptr;
+        std::size_t _cq_len;
+        io_uring_sqe *_sqes;
+        std::size_t _sqes_len;
+
+        unsigned *_sq_head;
+        unsigned *_sq_tail;
+        unsigned *_sq_mask;
+        unsigned *_sq_entries;
+        unsigned *_sq_array;
+
+        unsigned *_cq_head;
+        unsigned *_cq_tail;
+        unsigned *_cq_mask;
+        io_uring_cqe *_cqes;
+
+        unsigned _sqe_tail;
+        unsigned _sqe_head;
+
+        std::bitset<256> _supported;
+
+        int setup(unsigned entries) noexcept;
+        void probe() noexcept;
+        void teardown() noexcept;
+
+      public:
+
+        explicit uring(unsigned entries) noexcept;
+
+        uring(const uring &lhs) = delete;
+
+        uring &operator=(const uring &lhs) = delete;
+
+        ~uring() noexcept;
+
+        inline bool is_open() const noexcept
+        {
+            return _fd >= 0;
+        }
+
+        inline int error() const noexcept
+        {
+            return _fd < 0 ? -_fd : 0;
+        }
+
+        inline int event_fd() const noexcept
+        {
+            return _event_fd;
+        }
+
+        inline bool supports(uint8_t op) const noexcept
+        {
+            return _supported.test(op);
+        }
+
+        inline unsigned pending() const noexcept
+        {
+            return _sqe_tail - _sqe_head;
+        }
+
+        io_uring_sqe *get_sqe() noexcept;
+
+        int submit() noexcept;
+
+        int wait(unsigned min_complete) noexcept;
+
+        template<typename t_fn>
+        unsigned reap(t_fn &&fn)
+        {
+            unsigned n = 0;
+            unsigned head = *_cq_head;
+
+            while (head != __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE))
+            {
+                auto &cqe = _cqes[head & *_cq_mask];
+
+                auto user_data = cqe.user_data;
+                auto res = cqe.res;
+
+                ++head;
+                ++n;
+
+                __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+
+                fn(user_data, res);
+
+                head = *_cq_head;
+            }
+
+            return n;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef VFS_UV_COPY_HPP
+#define VFS_UV_COPY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vfs/callback.hpp>
+
+namespace vfs::uv
+{
+    enum class uv_copy_method : uint8_t
+    {
+        reflink,
+        copy_file_range,
+        sendfile,
+        read_write
+    };
+
+    using uv_copy_progress_cb = vfs::callback<void(uint64_t copied, uint64_t total)>;
+
+    struct uv_copy_options
+    {
+        static const uint64_t default_chunk_size = 64 * 1024 * 1024;
+        static const std::size_t default_parallelism = 4;
+
+        uv_copy_method method = uv_copy_method::reflink;
+        bool sparse = true;
+        uint64_t chunk_size = default_chunk_size;
+        std::size_t parallelism = default_parallelism;
+        uv_copy_progress_cb progress = nullptr;
+    };
+}
+
+#endif
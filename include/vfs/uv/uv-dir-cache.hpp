@@ -0,0 +1,119 @@
+#ifndef VFS_UV_DIR_CACHE_HPP
+#define VFS_UV_DIR_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace vfs::uv
+{
+    struct uv_dir_cache_stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        std::size_t size;
+    };
+
+    class uv_dir_cache
+    {
+      private:
+
+        std::size_t _capacity;
+        std::list<std::string> _lru;
+        std::unordered_map<std::string, std::list<std::string>::iterator> _index;
+
+        uint64_t _hits;
+        uint64_t _misses;
+        uint64_t _evictions;
+
+      public:
+
+        explicit uv_dir_cache(std::size_t capacity) noexcept
+            : _capacity(capacity), _hits(0), _misses(0), _evictions(0)
+        {}
+
+        uv_dir_cache(const uv_dir_cache &lhs) = delete;
+
+        uv_dir_cache &operator=(const uv_dir_cache &lhs) = delete;
+
+        inline std::size_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        bool contains(const std::string &dir) noexcept
+        {
+            auto it = _index.find(dir);
+
+            if (it == _index.end())
+            {
+                ++_misses;
+                return false;
+            }
+
+            _lru.splice(_lru.begin(), _lru, it->second);
+
+            ++_hits;
+            return true;
+        }
+
+        void insert(const std::string &dir)
+        {
+            if (_capacity == 0)
+            {
+                return;
+            }
+
+            auto it = _index.find(dir);
+
+            if (it != _index.end())
+            {
+                _lru.splice(_lru.begin(), _lru, it->second);
+                return;
+            }
+
+            if (_index.size() >= _capacity)
+            {
+                _index.erase(_lru.back());
+                _lru.pop_back();
+
+                ++_evictions;
+            }
+
+            _lru.push_front(dir);
+            _index.emplace(dir, _lru.begin());
+        }
+
+        void erase(const std::string &dir) noexcept
+        {
+            auto it = _index.find(dir);
+
+            if (it != _index.end())
+            {
+                _lru.erase(it->second);
+                _index.erase(it);
+            }
+        }
+
+        void clear() noexcept
+        {
+            _index.clear();
+            _lru.clear();
+        }
+
+        inline uv_dir_cache_stats stats() const noexcept
+        {
+            return uv_dir_cache_stats {
+                .hits = _hits,
+                .misses = _misses,
+                .evictions = _evictions,
+                .size = _index.size()
+            };
+        }
+    };
+}
+
+#endif
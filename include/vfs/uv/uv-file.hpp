@@ -9,20 +9,29 @@ namespace vfs::uv
     template<typename t_path>
     class uv_file : public file_base<t_path>
     {
+      private:
+
+        uint32_t _direct_alignment;
+
       public:
 
         uv_file(t_path &path)
-            : file_base<t_path>(path)
+            : file_base<t_path>(path), _direct_alignment(0)
         {};
 
-        uv_file(t_path &path, ::uv_file fd)
-            : file_base<t_path>(path, static_cast<uint64_t >(fd))
+        uv_file(t_path &path, ::uv_file fd, uint32_t direct_alignment = 0)
+            : file_base<t_path>(path, static_cast<uint64_t >(fd)), _direct_alignment(direct_alignment)
         {};
 
         inline ::uv_file uv_fd() const
         {
             return static_cast<::uv_file>(this->fd());
         }
+
+        inline uint32_t direct_alignment() const
+        {
+            return _direct_alignment;
+        }
     };
 }
 
@@ -5,12 +5,18 @@
 #include <uv.h>
 
 #include <vfs/path.hpp>
+#include <vfs/buffer-chain.hpp>
 #include <vfs/filesystem.hpp>
 
 #include <vfs/unix/unix-path.hpp>
+#include <vfs/unix/unix-small-path.hpp>
 #include <vfs/uv/uv-stat.hpp>
 #include "uv-loop.hpp"
 #include "uv-file.hpp"
+#include "uv-copy.hpp"
+#include "uv-dir-cache.hpp"
+#include "uv-req-pool.hpp"
+#include "uv-worker-pool.hpp"
 
 namespace vfs::uv
 {
@@ -30,32 +36,106 @@ namespace vfs::uv
         return static_cast<t_data *>(req->data);
     }
 
-    using _uv_path_t = vfs::any_path;
-    using _uv_stat_t = vfs::uv::uv_stat;
-    using _uv_file_t = vfs::uv::uv_file<_uv_path_t>;
-    using _uv_buf_t = vfs::buffer;
-    using _uv_filesystem = vfs::filesystem<_uv_path_t, _uv_stat_t, _uv_file_t, _uv_buf_t>;
+    template<typename t_path>
+    struct uv_copy_job;
+
+    template<typename t_path>
+    struct uv_readdir_job;
 
-    class uv_filesystem :
-        public _uv_filesystem
+    template<typename t_path>
+    class basic_uv_filesystem :
+        public vfs::filesystem<t_path, vfs::uv::uv_stat, vfs::uv::uv_file<t_path>, vfs::buffer>
     {
 
+      public:
+
+        using path_type = t_path;
+        using stat_type = vfs::uv::uv_stat;
+        using file_type = vfs::uv::uv_file<t_path>;
+        using buffer_type = vfs::buffer;
+        using filesystem_type = vfs::filesystem<path_type, stat_type, file_type, buffer_type>;
+
+        using typename filesystem_type::exists_cb;
+        using typename filesystem_type::stat_cb;
+        using typename filesystem_type::mkdir_cb;
+        using typename filesystem_type::mkdirs_cb;
+        using typename filesystem_type::create_cb;
+        using typename filesystem_type::move_cb;
+        using typename filesystem_type::copy_cb;
+        using typename filesystem_type::link_cb;
+        using typename filesystem_type::symlink_cb;
+        using typename filesystem_type::unlink_cb;
+        using typename filesystem_type::open_cb;
+        using typename filesystem_type::fstat_cb;
+        using typename filesystem_type::read_cb;
+        using typename filesystem_type::write_cb;
+        using typename filesystem_type::readv_cb;
+        using typename filesystem_type::writev_cb;
+        using typename filesystem_type::truncate_cb;
+        using typename filesystem_type::close_cb;
+        using typename filesystem_type::map_cb;
+        using typename filesystem_type::readdir_cb;
+
       private:
 
         std::unique_ptr<vfs::uv::uv_loop> _uv_loop;
+        vfs::uv::uv_req_pool _req_pool;
+        std::unique_ptr<vfs::uv::uv_work_port> _work_port;
+        vfs::uv::uv_dir_cache _dir_cache;
+        uint32_t _direct_alignment = default_direct_alignment;
+
+        static std::size_t req_data_size() noexcept;
+
+        template<typename t_call, typename... t_paths>
+        int fs_call(uv_fs_t *req, uv_work_class cls, t_call call, uv_fs_cb cb, const t_paths &... paths) noexcept;
+
+        template<typename t_work, typename t_after>
+        int work_call(uv_work_class cls, t_work work, t_after after) noexcept;
+
+        static int mkdirs_issue(uv_fs_t *req) noexcept;
+        static void mkdirs_complete(uv_fs_t *req) noexcept;
+
+        static void copy_pump(uv_copy_job<t_path> *job) noexcept;
+        static void copy_finish(uv_copy_job<t_path> *job) noexcept;
+
+        int readdir_pump(uv_readdir_job<t_path> *job) noexcept;
 
       public:
 
-        explicit uv_filesystem()
-            : _uv_loop(new vfs::uv::unique_uv_loop)
+        using read_chain_cb = vfs::callback<
+            void(file_type &, int, vfs::buffer_chain &)>;
+
+        using write_chain_cb = vfs::callback<
+            void(file_type &, int, vfs::buffer_chain &)>;
+
+        using read_checked_cb = vfs::callback<
+            void(file_type &, int, vfs::buffer &, uint32_t)>;
+
+        using write_checked_cb = vfs::callback<
+            void(file_type &, int, vfs::buffer &, uint32_t)>;
+
+        static const std::size_t default_req_pool_capacity = 256;
+        static const std::size_t default_dir_cache_capacity = 1024;
+        static const uint32_t default_direct_alignment = 4096;
+
+        explicit basic_uv_filesystem(std::size_t req_pool_capacity = default_req_pool_capacity)
+            : _uv_loop(new vfs::uv::unique_uv_loop),
+              _req_pool(req_data_size(), req_pool_capacity),
+              _dir_cache(default_dir_cache_capacity)
         {};
 
-        explicit uv_filesystem(vfs::uv::shared_uv_loop &uv_loop) noexcept
-            : _uv_loop(&uv_loop)
+        explicit basic_uv_filesystem(vfs::uv::shared_uv_loop &uv_loop,
+                               std::size_t req_pool_capacity = default_req_pool_capacity)
+            : _uv_loop(&uv_loop),
+              _req_pool(req_data_size(), req_pool_capacity),
+              _dir_cache(default_dir_cache_capacity)
         {};
 
-        explicit uv_filesystem(vfs::uv::unique_uv_loop &&uv_loop) noexcept
-            : _uv_loop(new vfs::uv::unique_uv_loop {std::forward<vfs::uv::unique_uv_loop>(uv_loop)})
+        explicit basic_uv_filesystem(vfs::uv::unique_uv_loop &&uv_loop,
+                               std::size_t req_pool_capacity = default_req_pool_capacity)
+            : _uv_loop(new vfs::uv::unique_uv_loop {std::forward<vfs::uv::unique_uv_loop>(uv_loop)}),
+              _req_pool(req_data_size(), req_pool_capacity),
+              _dir_cache(default_dir_cache_capacity)
         {};
 
         inline vfs::uv::uv_loop &loop() const noexcept
@@ -63,29 +143,89 @@ namespace vfs::uv
             return *_uv_loop.get();
         }
 
-        using _uv_filesystem::mkdir;
-        using _uv_filesystem::mkdirs;
-        using _uv_filesystem::create;
-        using _uv_filesystem::open;
-
-        int exists(_uv_path_t path, exists_cb cb) noexcept override;
-        int stat(_uv_path_t path, stat_cb cb) noexcept override;
-        int mkdir(_uv_path_t path, int32_t mode, mkdir_cb cb) noexcept override;
-        int mkdirs(_uv_path_t path, int32_t mode, mkdirs_cb cb) noexcept override;
-        int create(_uv_path_t path, int32_t mode, create_cb cb) noexcept override;
-        int move(_uv_path_t path, _uv_path_t move_path, move_cb cb) noexcept override;
-        int copy(_uv_path_t path, _uv_path_t copy_path, copy_cb cb) noexcept override;
-        int link(_uv_path_t path, _uv_path_t other_path, link_cb cb) noexcept override;
-        int symlink(_uv_path_t path, _uv_path_t link_path, symlink_cb cb) noexcept override;
-        int unlink(_uv_path_t path, unlink_cb cb) noexcept override;
-
-        int open(_uv_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept override;
-        int stat(_uv_file_t file, fstat_cb cb) noexcept override;
-        int read(_uv_file_t file, _uv_buf_t buf, off64_t off, read_cb cb) noexcept override;
-        int write(_uv_file_t file, _uv_buf_t buf, off64_t off, write_cb cb) noexcept override;
-        int truncate(_uv_file_t file, uint64_t size, truncate_cb cb) noexcept override;
-        int close(_uv_file_t file, close_cb cb) noexcept override;
+        inline const vfs::uv::uv_req_pool_stats &req_pool_stats() const noexcept
+        {
+            return _req_pool.stats();
+        }
+
+        inline vfs::uv::uv_dir_cache &dir_cache() noexcept
+        {
+            return _dir_cache;
+        }
+
+        inline vfs::uv::uv_worker_pool *worker_pool() const noexcept
+        {
+            return _work_port ? &_work_port->pool() : nullptr;
+        }
+
+        void use_worker_pool(vfs::uv::uv_worker_pool &pool) noexcept;
+
+        int submit_work(uv_work_class cls, vfs::uv::uv_worker_pool::work work,
+                        vfs::uv::uv_worker_pool::work done) noexcept;
+
+        inline uint32_t direct_alignment() const noexcept
+        {
+            return _direct_alignment;
+        }
+
+        inline void use_direct_alignment(uint32_t alignment) noexcept
+        {
+            _direct_alignment = alignment;
+        }
+
+        using filesystem_type::mkdir;
+        using filesystem_type::mkdirs;
+        using filesystem_type::create;
+        using filesystem_type::open;
+        using filesystem_type::readdir;
+
+        int exists(t_path path, exists_cb cb) noexcept override;
+        int stat(t_path path, stat_cb cb) noexcept override;
+        int mkdir(t_path path, int32_t mode, mkdir_cb cb) noexcept override;
+        int mkdirs(t_path path, int32_t mode, mkdirs_cb cb) noexcept override;
+        int create(t_path path, int32_t mode, create_cb cb) noexcept override;
+        int move(t_path path, t_path move_path, move_cb cb) noexcept override;
+        int copy(t_path path, t_path copy_path, copy_cb cb) noexcept override;
+        int copy(t_path path, t_path copy_path, uv_copy_options options, copy_cb cb) noexcept;
+        int link(t_path path, t_path other_path, link_cb cb) noexcept override;
+        int symlink(t_path path, t_path link_path, symlink_cb cb) noexcept override;
+        int unlink(t_path path, unlink_cb cb) noexcept override;
+
+        int open(t_path path, int32_t mode, int32_t flags, open_cb cb) noexcept override;
+        int stat(file_type file, fstat_cb cb) noexcept override;
+        int read(file_type file, buffer_type buf, off64_t off, read_cb cb) noexcept override;
+        int write(file_type file, buffer_type buf, off64_t off, write_cb cb) noexcept override;
+        int read(file_type file, vfs::buffer_chain chain, off64_t off, read_chain_cb cb) noexcept;
+        int write(file_type file, vfs::buffer_chain chain, off64_t off, write_chain_cb cb) noexcept;
+        int read_checked(file_type file, buffer_type buf, off64_t off, read_checked_cb cb) noexcept;
+        int read_checked(file_type file, buffer_type buf, off64_t off, uint32_t expected, read_checked_cb cb) noexcept;
+        int write_checked(file_type file, buffer_type buf, off64_t off, write_checked_cb cb) noexcept;
+        int readv(file_type file, std::vector<buffer_type> bufs, off64_t off, readv_cb cb) noexcept override;
+        int writev(file_type file, std::vector<buffer_type> bufs, off64_t off, writev_cb cb) noexcept override;
+        int truncate(file_type file, uint64_t size, truncate_cb cb) noexcept override;
+        int close(file_type file, close_cb cb) noexcept override;
+        int map(file_type file, uint64_t off, uint64_t len, int32_t flags, map_cb cb) noexcept override;
+        int readdir(t_path path, std::size_t batch_size, uint64_t cursor, readdir_cb cb) noexcept override;
+
+      private:
+
+        int read_checked(file_type file, buffer_type buf, off64_t off, bool verify, uint32_t expected,
+                         read_checked_cb cb) noexcept;
     };
+
+    using _uv_path_t = vfs::any_path;
+    using _uv_stat_t = vfs::uv::uv_stat;
+    using _uv_file_t = vfs::uv::uv_file<_uv_path_t>;
+    using _uv_buf_t = vfs::buffer;
+    using _uv_filesystem = vfs::filesystem<_uv_path_t, _uv_stat_t, _uv_file_t, _uv_buf_t>;
+
+    using uv_filesystem = basic_uv_filesystem<vfs::any_path>;
+    using uv_unix_filesystem = basic_uv_filesystem<vfs::unix_path>;
+    using uv_small_path_filesystem = basic_uv_filesystem<vfs::unix_small_path>;
+
+    extern template class basic_uv_filesystem<vfs::any_path>;
+    extern template class basic_uv_filesystem<vfs::unix_path>;
+    extern template class basic_uv_filesystem<vfs::unix_small_path>;
 }
 
 #endif
\ No newline at end of file
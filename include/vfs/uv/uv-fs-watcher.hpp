@@ -0,0 +1,70 @@
+#ifndef VFS_UV_FS_WATCHER_HPP
+#define VFS_UV_FS_WATCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <uv.h>
+
+#include <vfs/callback.hpp>
+
+#include "uv-loop.hpp"
+
+namespace vfs::uv
+{
+    struct uv_fs_watcher_stats
+    {
+        uint64_t events;
+        uint64_t overflows;
+        std::size_t watched;
+    };
+
+    class uv_fs_watcher
+    {
+      public:
+
+        using changed_cb = vfs::callback<void(std::string_view)>;
+
+      private:
+
+        struct watch
+        {
+            uv_fs_event_t handle;
+            uv_fs_watcher *owner;
+            std::string dir;
+        };
+
+        uv_loop &_uv_loop;
+        changed_cb _cb;
+
+        std::unordered_map<std::string, watch *> _watches;
+
+        uint64_t _events;
+        uint64_t _overflows;
+
+        static void on_event(uv_fs_event_t *handle, const char *filename, int events, int status) noexcept;
+
+        static void close(watch *w) noexcept;
+
+      public:
+
+        uv_fs_watcher(uv_loop &uv_loop, changed_cb cb) noexcept;
+
+        uv_fs_watcher(const uv_fs_watcher &lhs) = delete;
+
+        uv_fs_watcher &operator=(const uv_fs_watcher &lhs) = delete;
+
+        ~uv_fs_watcher() noexcept;
+
+        int watch_dir(std::string_view dir) noexcept;
+
+        int unwatch_dir(std::string_view dir) noexcept;
+
+        uv_fs_watcher_stats stats() const noexcept;
+    };
+}
+
+#endif
@@ -72,6 +72,16 @@ namespace vfs::uv
         static void delete_uv_loop(uv_loop_t *uv_loop) noexcept
         {
             auto result = uv_loop_close(uv_loop);
+
+            // handles closed while tearing down the loop's owners still need their close callbacks; nothing else
+            // can be running a loop that is being destroyed, so finish them here
+            if (result == UV_EBUSY)
+            {
+                uv_run(uv_loop, UV_RUN_NOWAIT);
+
+                result = uv_loop_close(uv_loop);
+            }
+
             assert(0 == result);
 
             free(uv_loop);
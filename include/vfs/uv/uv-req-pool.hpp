@@ -0,0 +1,156 @@
+#ifndef VFS_UV_REQ_POOL_HPP
+#define VFS_UV_REQ_POOL_HPP
+
+#include <uv.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace vfs::uv
+{
+    struct uv_req_pool_stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t grows;
+        uint64_t capacity;
+        uint64_t in_use;
+    };
+
+    class uv_req_pool
+    {
+      private:
+
+        struct slot
+        {
+            uv_fs_t req;
+            uv_req_pool *pool;
+            slot *next;
+        };
+
+        static constexpr std::size_t data_offset()
+        {
+            return (sizeof(slot) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        }
+
+        std::size_t _data_size;
+        std::size_t _slot_size;
+        std::size_t _grow_size;
+
+        std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+        slot *_free;
+
+        uv_req_pool_stats _stats;
+
+        void grow(std::size_t n)
+        {
+            auto chunk = std::make_unique<uint8_t[]>(_slot_size * n);
+
+            for (std::size_t i = n; i > 0; --i)
+            {
+                auto s = reinterpret_cast<slot *>(chunk.get() + (i - 1) * _slot_size);
+
+                s->pool = this;
+                s->next = _free;
+
+                _free = s;
+            }
+
+            _chunks.push_back(std::move(chunk));
+            _stats.capacity += n;
+        }
+
+        static inline void *data_ptr(slot *s) noexcept
+        {
+            return reinterpret_cast<uint8_t *>(s) + data_offset();
+        }
+
+      public:
+
+        explicit uv_req_pool(std::size_t data_size, std::size_t capacity)
+            : _data_size(data_size),
+              _slot_size((data_offset() + data_size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1)),
+              _grow_size(capacity > 0 ? capacity : 1),
+              _free(nullptr),
+              _stats({})
+        {
+            if (capacity > 0)
+            {
+                grow(capacity);
+            }
+        }
+
+        uv_req_pool(const uv_req_pool &lhs) = delete;
+
+        uv_req_pool &operator=(const uv_req_pool &lhs) = delete;
+
+        template<typename t_data>
+        uv_fs_t *acquire(t_data &&data)
+        {
+            using data_t = std::remove_reference_t<t_data>;
+
+            slot *s;
+
+            if (sizeof(data_t) > _data_size)
+            {
+                s = static_cast<slot *>(::operator new(data_offset() + sizeof(data_t)));
+                s->pool = nullptr;
+
+                ++_stats.misses;
+            }
+            else
+            {
+                if (_free == nullptr)
+                {
+                    grow(_grow_size);
+
+                    ++_stats.misses;
+                    ++_stats.grows;
+                }
+                else
+                {
+                    ++_stats.hits;
+                }
+
+                s = _free;
+                _free = s->next;
+
+                ++_stats.in_use;
+            }
+
+            s->req.data = new(data_ptr(s)) data_t {std::forward<t_data>(data)};
+
+            return &s->req;
+        }
+
+        template<typename t_data>
+        static void release(uv_fs_t *req) noexcept
+        {
+            static_cast<t_data *>(req->data)->~t_data();
+
+            auto s = reinterpret_cast<slot *>(req);
+            auto pool = s->pool;
+
+            if (pool == nullptr)
+            {
+                ::operator delete(s);
+                return;
+            }
+
+            s->next = pool->_free;
+            pool->_free = s;
+
+            --pool->_stats.in_use;
+        }
+
+        inline const uv_req_pool_stats &stats() const noexcept
+        {
+            return _stats;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef VFS_UV_SHARDED_FILESYSTEM_HPP
+#define VFS_UV_SHARDED_FILESYSTEM_HPP
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <vfs/callback.hpp>
+#include <vfs/filesystem.hpp>
+
+#include "uv-filesystem.hpp"
+
+namespace vfs::uv
+{
+    struct uv_shard_stats
+    {
+        uint64_t submitted;
+        uint64_t dispatched;
+        uint64_t rejected;
+        uint64_t wakeups;
+        uint64_t queued;
+    };
+
+    class sharded_filesystem :
+        public _uv_filesystem
+    {
+
+      public:
+
+        using shard_task = vfs::callback<int(vfs::uv::uv_filesystem &), 192>;
+
+      private:
+
+        struct shard;
+
+        std::vector<std::unique_ptr<shard>> _shards;
+
+        shard &shard_for(_uv_path_t &path) const noexcept;
+        shard &shard_for(_uv_file_t &file) const noexcept;
+
+        int dispatch(shard &s, shard_task task) noexcept;
+
+      public:
+
+        static std::size_t default_shards() noexcept
+        {
+            auto n = std::thread::hardware_concurrency();
+            return n > 0 ? n : 1;
+        }
+
+        explicit sharded_filesystem(std::size_t n_shards = default_shards(), bool pin_threads = true);
+
+        sharded_filesystem(const sharded_filesystem &lhs) = delete;
+
+        sharded_filesystem &operator=(const sharded_filesystem &lhs) = delete;
+
+        ~sharded_filesystem() noexcept override;
+
+        inline std::size_t shards() const noexcept
+        {
+            return _shards.size();
+        }
+
+        std::size_t shard_of(_uv_path_t path) const noexcept;
+        std::size_t shard_of(_uv_file_t file) const noexcept;
+
+        uv_shard_stats shard_stats(std::size_t i) const noexcept;
+
+        int post(std::size_t i, shard_task task) noexcept;
+
+        using _uv_filesystem::mkdir;
+        using _uv_filesystem::mkdirs;
+        using _uv_filesystem::create;
+        using _uv_filesystem::open;
+        using _uv_filesystem::readdir;
+
+        int exists(_uv_path_t path, exists_cb cb) noexcept override;
+        int stat(_uv_path_t path, stat_cb cb) noexcept override;
+        int mkdir(_uv_path_t path, int32_t mode, mkdir_cb cb) noexcept override;
+        int mkdirs(_uv_path_t path, int32_t mode, mkdirs_cb cb) noexcept override;
+        int create(_uv_path_t path, int32_t mode, create_cb cb) noexcept override;
+        int move(_uv_path_t path, _uv_path_t move_path, move_cb cb) noexcept override;
+        int copy(_uv_path_t path, _uv_path_t copy_path, copy_cb cb) noexcept override;
+        int link(_uv_path_t path, _uv_path_t other_path, link_cb cb) noexcept override;
+        int symlink(_uv_path_t path, _uv_path_t link_path, symlink_cb cb) noexcept override;
+        int unlink(_uv_path_t path, unlink_cb cb) noexcept override;
+
+        int open(_uv_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept override;
+        int stat(_uv_file_t file, fstat_cb cb) noexcept override;
+        int read(_uv_file_t file, _uv_buf_t buf, off64_t off, read_cb cb) noexcept override;
+        int write(_uv_file_t file, _uv_buf_t buf, off64_t off, write_cb cb) noexcept override;
+        int readv(_uv_file_t file, std::vector<_uv_buf_t> bufs, off64_t off, readv_cb cb) noexcept override;
+        int writev(_uv_file_t file, std::vector<_uv_buf_t> bufs, off64_t off, writev_cb cb) noexcept override;
+        int truncate(_uv_file_t file, uint64_t size, truncate_cb cb) noexcept override;
+        int close(_uv_file_t file, close_cb cb) noexcept override;
+
+        int map(_uv_file_t file, uint64_t off, uint64_t len, int32_t flags, map_cb cb) noexcept override;
+        int readdir(_uv_path_t path, std::size_t batch_size, uint64_t cursor, readdir_cb cb) noexcept override;
+    };
+}
+
+#endif
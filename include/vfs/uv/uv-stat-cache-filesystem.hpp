@@ -0,0 +1,62 @@
+#ifndef VFS_UV_STAT_CACHE_FILESYSTEM_HPP
+#define VFS_UV_STAT_CACHE_FILESYSTEM_HPP
+
+#include <string_view>
+
+#include <vfs/stat-cache-filesystem.hpp>
+
+#include "uv-filesystem.hpp"
+#include "uv-fs-watcher.hpp"
+
+namespace vfs::uv
+{
+    template<typename t_path>
+    class basic_uv_stat_cache_filesystem :
+        public vfs::stat_cache_filesystem<t_path, vfs::uv::uv_stat, vfs::uv::uv_file<t_path>, vfs::buffer>
+    {
+
+      public:
+
+        using cache_type = vfs::stat_cache_filesystem<t_path, vfs::uv::uv_stat, vfs::uv::uv_file<t_path>,
+                                                      vfs::buffer>;
+
+      private:
+
+        uv_fs_watcher _watcher;
+
+      public:
+
+        explicit basic_uv_stat_cache_filesystem(basic_uv_filesystem<t_path> &inner,
+                                                std::size_t capacity = cache_type::default_capacity,
+                                                uint64_t ttl = cache_type::default_ttl,
+                                                stat_cache_clock clock = nullptr) noexcept
+            : cache_type(inner, [&inner](stat_cache_work work, stat_cache_work done)
+              {
+                  return inner.submit_work(uv_work_class::metadata, std::move(work), std::move(done));
+              }, capacity, ttl, std::move(clock)),
+              _watcher(inner.loop(), [this](std::string_view path)
+              {
+                  this->changed(path);
+              })
+        {}
+
+        inline int watch(const t_path &dir) noexcept
+        {
+            return _watcher.watch_dir(dir.view());
+        }
+
+        inline int unwatch(const t_path &dir) noexcept
+        {
+            return _watcher.unwatch_dir(dir.view());
+        }
+
+        inline uv_fs_watcher_stats watcher_stats() const noexcept
+        {
+            return _watcher.stats();
+        }
+    };
+
+    using uv_stat_cache_filesystem = basic_uv_stat_cache_filesystem<vfs::any_path>;
+}
+
+#endif
@@ -47,6 +47,11 @@ namespace vfs::uv
             return inode() == other.inode();
         }
 
+        inline uint64_t dev() const noexcept override
+        {
+            return _uv_stat.st_dev;
+        }
+
         inline uint64_t inode() const noexcept override
         {
             return _uv_stat.st_ino;
@@ -0,0 +1,172 @@
+#ifndef VFS_UV_WORKER_POOL_HPP
+#define VFS_UV_WORKER_POOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <uv.h>
+
+#include <vfs/callback.hpp>
+
+#include "uv-loop.hpp"
+
+namespace vfs::uv
+{
+    enum class uv_work_class : uint8_t
+    {
+        metadata,
+        data
+    };
+
+    struct uv_worker_pool_stats
+    {
+        std::size_t threads;
+        std::size_t idle;
+        uint64_t spawned;
+        uint64_t retired;
+        uint64_t metadata_queued;
+        uint64_t data_queued;
+        uint64_t metadata_done;
+        uint64_t data_done;
+    };
+
+    class uv_worker_pool
+    {
+      public:
+
+        using work = vfs::callback<void(), 128>;
+
+      private:
+
+        std::size_t _min_threads;
+        std::size_t _max_threads;
+        unsigned _metadata_weight;
+        unsigned _data_weight;
+        std::chrono::milliseconds _idle_timeout;
+
+        std::mutex _mutex;
+        std::condition_variable _work_cv;
+        std::condition_variable _exit_cv;
+
+        std::deque<work> _metadata_queue;
+        std::deque<work> _data_queue;
+
+        unsigned _turn;
+        bool _stopping;
+
+        std::size_t _threads;
+        std::size_t _idle;
+        uint64_t _spawned;
+        uint64_t _retired;
+        uint64_t _metadata_done;
+        uint64_t _data_done;
+
+        bool spawn() noexcept;
+        void run() noexcept;
+        bool take(work &task, uv_work_class &cls) noexcept;
+
+      public:
+
+        static const std::size_t default_min_threads = 2;
+        static const std::size_t default_max_threads = 8;
+        static const unsigned default_metadata_weight = 4;
+        static const unsigned default_data_weight = 1;
+
+        explicit uv_worker_pool(std::size_t min_threads = default_min_threads,
+                                std::size_t max_threads = default_max_threads,
+                                unsigned metadata_weight = default_metadata_weight,
+                                unsigned data_weight = default_data_weight,
+                                std::chrono::milliseconds idle_timeout = std::chrono::seconds {5});
+
+        uv_worker_pool(const uv_worker_pool &lhs) = delete;
+
+        uv_worker_pool &operator=(const uv_worker_pool &lhs) = delete;
+
+        ~uv_worker_pool() noexcept;
+
+        int submit(uv_work_class cls, work task) noexcept;
+
+        uv_worker_pool_stats stats() noexcept;
+    };
+
+    class uv_work_port
+    {
+      public:
+
+        using done = vfs::callback<void()>;
+
+      private:
+
+        // owned by the port and by every in-flight completion; freed by the async handle's close callback once
+        // the port is gone and the last completion has been drained
+        struct state
+        {
+            uv_async_t uv_async;
+
+            std::mutex mutex;
+            std::vector<done> completed;
+            std::vector<done> draining;
+
+            std::size_t in_flight;
+            bool detached;
+        };
+
+        uv_worker_pool &_pool;
+        state *_state;
+
+        static void acquire(state *s) noexcept;
+        static void release(state *s) noexcept;
+        static void post(state *s, done fn) noexcept;
+        static void drain(state *s) noexcept;
+        static void close(state *s) noexcept;
+
+      public:
+
+        uv_work_port(uv_worker_pool &pool, uv_loop &uv_loop) noexcept;
+
+        uv_work_port(const uv_work_port &lhs) = delete;
+
+        uv_work_port &operator=(const uv_work_port &lhs) = delete;
+
+        ~uv_work_port() noexcept;
+
+        inline uv_worker_pool &pool() const noexcept
+        {
+            return _pool;
+        }
+
+        inline std::size_t in_flight() const noexcept
+        {
+            return _state->in_flight;
+        }
+
+        template<typename t_fn, typename t_after>
+        int submit(uv_work_class cls, t_fn &&fn, t_after &&after) noexcept
+        {
+            auto s = _state;
+
+            acquire(s);
+
+            auto result = _pool.submit(cls, [s, fn = std::forward<t_fn>(fn),
+                                             after = std::forward<t_after>(after)]() mutable
+            {
+                fn();
+                post(s, done {std::move(after)});
+            });
+
+            if (result != 0)
+            {
+                release(s);
+            }
+
+            return result;
+        }
+    };
+}
+
+#endif
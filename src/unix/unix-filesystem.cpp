@@ -0,0 +1,644 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <vfs/path.hpp>
+#include <vfs/filesystem.hpp>
+
+#include <vfs/unix/unix-filesystem.hpp>
+
+// <editor-fold desc="helpers">
+
+static inline int errno_or(int result)
+{
+    return result < 0 ? errno : 0;
+}
+
+static int stat_at(int dir_fd, const char *path, struct stat64 &st)
+{
+    return errno_or(fstatat64(dir_fd, path, &st, 0));
+}
+
+static int open_at(int dir_fd, const char *path, int flags, int32_t mode)
+{
+    int fd;
+
+    do
+    {
+        fd = openat(dir_fd, path, flags | O_CLOEXEC, static_cast<mode_t>(mode));
+    }
+    while (fd < 0 && errno == EINTR);
+
+    return fd;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="exists">
+
+int vfs::unix_filesystem::exists(vfs::_unix_path_t path, exists_cb cb) noexcept
+{
+    struct stat64 st {};
+
+    auto err = stat_at(_dir_fd, path.c_str(), st);
+
+    if (err == ENOENT)
+    {
+        cb(path, 0, false);
+    }
+    else
+    {
+        cb(path, err, err == 0);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="stat">
+
+int vfs::unix_filesystem::stat(vfs::_unix_path_t path, stat_cb cb) noexcept
+{
+    struct stat64 st {};
+
+    auto err = stat_at(_dir_fd, path.c_str(), st);
+
+    if (err != 0)
+    {
+        cb(path, err, vfs::unix_stat {});
+    }
+    else
+    {
+        cb(path, 0, vfs::unix_stat {st});
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="mkdir">
+
+int vfs::unix_filesystem::mkdir(vfs::_unix_path_t path, int32_t mode, mkdir_cb cb) noexcept
+{
+    auto err = errno_or(mkdirat(_dir_fd, path.c_str(), static_cast<mode_t>(mode)));
+
+    cb(path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="mkdirs">
+
+static int mkdirs_at(int dir_fd, std::string_view path, const char *c_path, mode_t mode)
+{
+    if (mkdirat(dir_fd, c_path, mode) == 0)
+    {
+        return 0;
+    }
+
+    auto err = errno;
+
+    if (err == EEXIST)
+    {
+        struct stat64 st {};
+
+        if (fstatat64(dir_fd, c_path, &st, 0) == 0 && S_ISDIR(st.st_mode))
+        {
+            return 0;
+        }
+
+        return EEXIST;
+    }
+
+    if (err != ENOENT)
+    {
+        return err;
+    }
+
+    auto end = path.find_last_not_of('/');
+    auto pos = end == std::string_view::npos ? end : path.find_last_of('/', end);
+
+    if (pos == std::string_view::npos || pos == 0)
+    {
+        return ENOENT;
+    }
+
+    // only a missing parent pays for a NUL-terminated copy of the prefix
+    std::string parent;
+
+    try
+    {
+        parent.assign(path.substr(0, pos));
+    }
+    catch (const std::bad_alloc &)
+    {
+        return ENOMEM;
+    }
+
+    err = mkdirs_at(dir_fd, parent, parent.c_str(), mode);
+
+    if (err != 0)
+    {
+        return err;
+    }
+
+    if (mkdirat(dir_fd, c_path, mode) == 0 || errno == EEXIST)
+    {
+        return 0;
+    }
+
+    return errno;
+}
+
+int vfs::unix_filesystem::mkdirs(vfs::_unix_path_t path, int32_t mode, mkdirs_cb cb) noexcept
+{
+    auto err = mkdirs_at(_dir_fd, path.view(), path.c_str(), static_cast<mode_t>(mode));
+
+    cb(path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="create">
+
+int vfs::unix_filesystem::create(vfs::_unix_path_t path, int32_t mode, create_cb cb) noexcept
+{
+    auto fd = open_at(_dir_fd, path.c_str(), O_WRONLY | O_CREAT | O_EXCL, mode);
+
+    if (fd < 0)
+    {
+        cb(path, errno);
+    }
+    else
+    {
+        ::close(fd);
+
+        cb(path, 0);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="move">
+
+int vfs::unix_filesystem::move(vfs::_unix_path_t path, vfs::_unix_path_t move_path, move_cb cb) noexcept
+{
+    auto err = errno_or(renameat(_dir_fd, path.c_str(), _dir_fd, move_path.c_str()));
+
+    cb(path, move_path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="copy">
+
+static const std::size_t copy_chunk_size = 64 * 1024;
+
+static int copy_fd(int in_fd, int out_fd, uint64_t size)
+{
+    uint64_t done = 0;
+
+    while (done < size)
+    {
+        auto n = copy_file_range(in_fd, nullptr, out_fd, nullptr, size - done, 0);
+
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)
+            {
+                break;
+            }
+
+            return errno;
+        }
+
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        done += static_cast<uint64_t>(n);
+    }
+
+    if (done >= size)
+    {
+        return 0;
+    }
+
+    auto chunk = std::make_unique<uint8_t[]>(copy_chunk_size);
+
+    while (true)
+    {
+        auto n_read = ::read(in_fd, chunk.get(), copy_chunk_size);
+
+        if (n_read < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return errno;
+        }
+
+        if (n_read == 0)
+        {
+            return 0;
+        }
+
+        ssize_t n_write = 0;
+
+        while (n_write < n_read)
+        {
+            auto n = ::write(out_fd, chunk.get() + n_write, static_cast<std::size_t>(n_read - n_write));
+
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return errno;
+            }
+
+            n_write += n;
+        }
+    }
+}
+
+int vfs::unix_filesystem::copy(vfs::_unix_path_t path, vfs::_unix_path_t copy_path, copy_cb cb) noexcept
+{
+    auto in_fd = open_at(_dir_fd, path.c_str(), O_RDONLY, 0);
+
+    if (in_fd < 0)
+    {
+        cb(path, copy_path, errno);
+
+        return 0;
+    }
+
+    struct stat64 st {};
+
+    if (fstat64(in_fd, &st) != 0)
+    {
+        auto err = errno;
+
+        ::close(in_fd);
+
+        cb(path, copy_path, err);
+
+        return 0;
+    }
+
+    auto mode = static_cast<int32_t>(st.st_mode & 07777);
+    auto out_fd = open_at(_dir_fd, copy_path.c_str(), O_WRONLY | O_CREAT, mode);
+
+    if (out_fd < 0)
+    {
+        auto err = errno;
+
+        ::close(in_fd);
+
+        cb(path, copy_path, err);
+
+        return 0;
+    }
+
+    struct stat64 out_st {};
+
+    auto err = errno_or(fstat64(out_fd, &out_st));
+
+    if (err == 0 && out_st.st_dev == st.st_dev && out_st.st_ino == st.st_ino)
+    {
+        ::close(in_fd);
+        ::close(out_fd);
+
+        cb(path, copy_path, 0);
+
+        return 0;
+    }
+
+    if (err == 0)
+    {
+        err = errno_or(ftruncate64(out_fd, 0));
+    }
+
+    if (err == 0)
+    {
+        err = copy_fd(in_fd, out_fd, static_cast<uint64_t>(st.st_size));
+    }
+
+    ::close(in_fd);
+
+    if (::close(out_fd) != 0 && err == 0)
+    {
+        err = errno;
+    }
+
+    cb(path, copy_path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="link">
+
+int vfs::unix_filesystem::link(vfs::_unix_path_t path, vfs::_unix_path_t other_path, link_cb cb) noexcept
+{
+    auto err = errno_or(linkat(_dir_fd, path.c_str(), _dir_fd, other_path.c_str(), 0));
+
+    cb(path, other_path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="symlink">
+
+int vfs::unix_filesystem::symlink(vfs::_unix_path_t path, vfs::_unix_path_t link_path, symlink_cb cb) noexcept
+{
+    auto err = errno_or(symlinkat(path.c_str(), _dir_fd, link_path.c_str()));
+
+    cb(path, link_path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="unlink">
+
+int vfs::unix_filesystem::unlink(vfs::_unix_path_t path, unlink_cb cb) noexcept
+{
+    auto err = errno_or(unlinkat(_dir_fd, path.c_str(), 0));
+
+    cb(path, err);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="open">
+
+int vfs::unix_filesystem::open(vfs::_unix_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept
+{
+    auto fd = open_at(_dir_fd, path.c_str(), flags, mode);
+
+    if (fd < 0)
+    {
+        auto err = errno;
+
+        vfs::_unix_file_t file {path};
+
+        cb(path, err, file);
+    }
+    else
+    {
+        vfs::_unix_file_t file {path, fd};
+
+        cb(path, 0, file);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="fstat">
+
+int vfs::unix_filesystem::stat(vfs::_unix_file_t file, fstat_cb cb) noexcept
+{
+    struct stat64 st {};
+
+    if (fstat64(file.unix_fd(), &st) != 0)
+    {
+        cb(file, errno, vfs::unix_stat {});
+    }
+    else
+    {
+        cb(file, 0, vfs::unix_stat {st});
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="read">
+
+int vfs::unix_filesystem::read(vfs::_unix_file_t file, vfs::_unix_buf_t buf, off64_t off, read_cb cb) noexcept
+{
+    ssize_t n_read;
+
+    do
+    {
+        n_read = off < 0
+                 ? ::read(file.unix_fd(), buf.data(), buf.capacity())
+                 : pread64(file.unix_fd(), buf.data(), buf.capacity(), off);
+    }
+    while (n_read < 0 && errno == EINTR);
+
+    if (n_read < 0)
+    {
+        cb(file, errno, buf);
+    }
+    else
+    {
+        buf.truncate(static_cast<uint64_t>(n_read));
+
+        cb(file, 0, buf);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="write">
+
+int vfs::unix_filesystem::write(vfs::_unix_file_t file, vfs::_unix_buf_t buf, off64_t off, write_cb cb) noexcept
+{
+    ssize_t n_write;
+
+    do
+    {
+        n_write = off < 0
+                  ? ::write(file.unix_fd(), buf.data(), buf.size())
+                  : pwrite64(file.unix_fd(), buf.data(), buf.size(), off);
+    }
+    while (n_write < 0 && errno == EINTR);
+
+    if (n_write < 0)
+    {
+        cb(file, errno, buf);
+    }
+    else
+    {
+        buf.truncate(static_cast<uint64_t>(n_write));
+
+        cb(file, 0, buf);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="readv">
+
+static const std::size_t iovecs_inline = 8;
+
+template<typename t_fn>
+static ssize_t with_iovecs(std::vector<vfs::_unix_buf_t> &bufs, bool use_capacity, t_fn &&fn)
+{
+    iovec inline_iovecs[iovecs_inline];
+    std::unique_ptr<iovec[]> heap_iovecs;
+
+    auto n_bufs = std::min<std::size_t>(bufs.size(), IOV_MAX);
+    auto iovecs = inline_iovecs;
+
+    if (n_bufs > iovecs_inline)
+    {
+        heap_iovecs = std::make_unique<iovec[]>(n_bufs);
+        iovecs = heap_iovecs.get();
+    }
+
+    for (std::size_t i = 0; i < n_bufs; ++i)
+    {
+        auto &buf = bufs[i];
+
+        iovecs[i].iov_base = buf.data();
+        iovecs[i].iov_len = use_capacity ? buf.capacity() : buf.size();
+    }
+
+    ssize_t result;
+
+    do
+    {
+        result = fn(iovecs, static_cast<int>(n_bufs));
+    }
+    while (result < 0 && errno == EINTR);
+
+    return result;
+}
+
+static void fill_iovecs(std::vector<vfs::_unix_buf_t> &bufs, bool use_capacity, uint64_t n)
+{
+    for (auto &buf : bufs)
+    {
+        auto len = use_capacity ? buf.capacity() : buf.size();
+        auto fill = std::min(len, n);
+
+        buf.truncate(fill);
+
+        n -= fill;
+    }
+}
+
+int vfs::unix_filesystem::readv(vfs::_unix_file_t file, std::vector<vfs::_unix_buf_t> bufs, off64_t off,
+                                readv_cb cb) noexcept
+{
+    auto n_read = with_iovecs(bufs, true, [&](iovec *iovecs, int n_iovecs)
+    {
+        return off < 0
+               ? ::readv(file.unix_fd(), iovecs, n_iovecs)
+               : preadv64(file.unix_fd(), iovecs, n_iovecs, off);
+    });
+
+    if (n_read < 0)
+    {
+        cb(file, errno, bufs);
+    }
+    else
+    {
+        fill_iovecs(bufs, true, static_cast<uint64_t>(n_read));
+
+        cb(file, 0, bufs);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="writev">
+
+int vfs::unix_filesystem::writev(vfs::_unix_file_t file, std::vector<vfs::_unix_buf_t> bufs, off64_t off,
+                                 writev_cb cb) noexcept
+{
+    auto n_write = with_iovecs(bufs, false, [&](iovec *iovecs, int n_iovecs)
+    {
+        return off < 0
+               ? ::writev(file.unix_fd(), iovecs, n_iovecs)
+               : pwritev64(file.unix_fd(), iovecs, n_iovecs, off);
+    });
+
+    if (n_write < 0)
+    {
+        cb(file, errno, bufs);
+    }
+    else
+    {
+        fill_iovecs(bufs, false, static_cast<uint64_t>(n_write));
+
+        cb(file, 0, bufs);
+    }
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="truncate">
+
+int vfs::unix_filesystem::truncate(vfs::_unix_file_t file, uint64_t size, truncate_cb cb) noexcept
+{
+    auto err = errno_or(ftruncate64(file.unix_fd(), static_cast<off64_t>(size)));
+
+    cb(file, err, size);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="close">
+
+int vfs::unix_filesystem::close(vfs::_unix_file_t file, close_cb cb) noexcept
+{
+    auto err = errno_or(::close(file.unix_fd()));
+
+    cb(file, err);
+
+    return 0;
+}
+
+// </editor-fold>
@@ -0,0 +1,1107 @@
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <vfs/uring/uring-filesystem.hpp>
+
+// <editor-fold desc="using">
+
+using exists_cb = typename vfs::uring::uring_filesystem::exists_cb;
+using stat_cb = typename vfs::uring::uring_filesystem::stat_cb;
+using mkdir_cb = typename vfs::uring::uring_filesystem::mkdir_cb;
+using mkdirs_cb = typename vfs::uring::uring_filesystem::mkdirs_cb;
+using create_cb = typename vfs::uring::uring_filesystem::create_cb;
+using move_cb = typename vfs::uring::uring_filesystem::move_cb;
+using copy_cb = typename vfs::uring::uring_filesystem::copy_cb;
+using link_cb = typename vfs::uring::uring_filesystem::link_cb;
+using symlink_cb = typename vfs::uring::uring_filesystem::symlink_cb;
+using unlink_cb = typename vfs::uring::uring_filesystem::unlink_cb;
+using open_cb = typename vfs::uring::uring_filesystem::open_cb;
+using fstat_cb = typename vfs::uring::uring_filesystem::fstat_cb;
+using read_cb = typename vfs::uring::uring_filesystem::read_cb;
+using write_cb = typename vfs::uring::uring_filesystem::write_cb;
+using readv_cb = typename vfs::uring::uring_filesystem::readv_cb;
+using writev_cb = typename vfs::uring::uring_filesystem::writev_cb;
+using truncate_cb = typename vfs::uring::uring_filesystem::truncate_cb;
+using close_cb = typename vfs::uring::uring_filesystem::close_cb;
+using map_cb = typename vfs::uring::uring_filesystem::map_cb;
+using readdir_cb = typename vfs::uring::uring_filesystem::readdir_cb;
+
+// </editor-fold>
+
+// <editor-fold desc="req">
+
+struct vfs::uring::uring_req
+{
+    virtual ~uring_req() noexcept
+    {};
+
+    virtual void complete(int32_t res) noexcept = 0;
+};
+
+static inline int get_uring_error(int32_t res)
+{
+    return res < 0 ? -res : 0;
+}
+
+static inline uint64_t get_uring_off(off64_t off)
+{
+    return off < 0 ? static_cast<uint64_t>(-1) : static_cast<uint64_t>(off);
+}
+
+static inline uv_timespec_t to_uv_timespec(const statx_timestamp &ts)
+{
+    return uv_timespec_t {
+        .tv_sec = ts.tv_sec,
+        .tv_nsec = ts.tv_nsec
+    };
+}
+
+static uv_stat_t to_uv_stat(const struct statx &stx)
+{
+    uv_stat_t s {};
+
+    s.st_dev = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    s.st_mode = stx.stx_mode;
+    s.st_nlink = stx.stx_nlink;
+    s.st_uid = stx.stx_uid;
+    s.st_gid = stx.stx_gid;
+    s.st_rdev = makedev(stx.stx_rdev_major, stx.stx_rdev_minor);
+    s.st_ino = stx.stx_ino;
+    s.st_size = stx.stx_size;
+    s.st_blksize = stx.stx_blksize;
+    s.st_blocks = stx.stx_blocks;
+    s.st_flags = stx.stx_attributes;
+    s.st_atim = to_uv_timespec(stx.stx_atime);
+    s.st_mtim = to_uv_timespec(stx.stx_mtime);
+    s.st_ctim = to_uv_timespec(stx.stx_ctime);
+    s.st_birthtim = to_uv_timespec(stx.stx_btime);
+
+    return s;
+}
+
+static void prep_statx(io_uring_sqe *sqe, int fd, const char *path, int flags, struct statx *stx)
+{
+    sqe->opcode = IORING_OP_STATX;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(path);
+    sqe->len = STATX_BASIC_STATS | STATX_BTIME;
+    sqe->off = reinterpret_cast<uint64_t>(stx);
+    sqe->statx_flags = static_cast<uint32_t>(flags);
+}
+
+static void prep_rw(io_uring_sqe *sqe, uint8_t op, int fd, const void *addr, uint32_t len, uint64_t off)
+{
+    sqe->opcode = op;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(addr);
+    sqe->len = len;
+    sqe->off = off;
+}
+
+template<typename t_req, typename... t_args>
+static t_req *make_req(t_args &&... args) noexcept
+{
+    try
+    {
+        return new(std::nothrow) t_req(std::forward<t_args>(args)...);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold desc="ctor">
+
+vfs::uring::uring_filesystem::uring_filesystem(unsigned entries)
+    : _uv_fs(), _ring(entries), _uv_prepare({}), _uv_poll({}), _in_flight(0), _polling(false)
+{
+    init();
+}
+
+vfs::uring::uring_filesystem::uring_filesystem(vfs::uv::unique_uv_loop &&uv_loop, unsigned entries)
+    : _uv_fs(std::forward<vfs::uv::unique_uv_loop>(uv_loop)), _ring(entries),
+      _uv_prepare({}), _uv_poll({}), _in_flight(0), _polling(false)
+{
+    init();
+}
+
+vfs::uring::uring_filesystem::~uring_filesystem() noexcept
+{
+    if (!_ring.is_open())
+    {
+        return;
+    }
+
+    _ring.submit();
+
+    while (_in_flight > 0 && _ring.wait(1) >= 0)
+    {
+        _ring.reap([this](uint64_t user_data, int32_t)
+        {
+            delete reinterpret_cast<uring_req *>(user_data);
+            --_in_flight;
+        });
+    }
+
+    uv_close(reinterpret_cast<uv_handle_t *>(&_uv_prepare), nullptr);
+    uv_close(reinterpret_cast<uv_handle_t *>(&_uv_poll), nullptr);
+
+    uv_run(loop(), UV_RUN_NOWAIT);
+}
+
+void vfs::uring::uring_filesystem::init() noexcept
+{
+    if (!_ring.is_open())
+    {
+        return;
+    }
+
+    uv_prepare_init(loop(), &_uv_prepare);
+    uv_poll_init(loop(), &_uv_poll, _ring.event_fd());
+
+    _uv_prepare.data = this;
+    _uv_poll.data = this;
+
+    uv_prepare_start(&_uv_prepare, [](uv_prepare_t *handle)
+    {
+        static_cast<uring_filesystem *>(handle->data)->submit();
+    });
+
+    uv_unref(reinterpret_cast<uv_handle_t *>(&_uv_prepare));
+}
+
+// </editor-fold>
+
+// <editor-fold desc="queue">
+
+io_uring_sqe *vfs::uring::uring_filesystem::get_sqe() noexcept
+{
+    auto sqe = _ring.get_sqe();
+
+    if (sqe == nullptr)
+    {
+        _ring.submit();
+        sqe = _ring.get_sqe();
+    }
+
+    return sqe;
+}
+
+void vfs::uring::uring_filesystem::queue(io_uring_sqe *sqe, uring_req *req) noexcept
+{
+    sqe->user_data = reinterpret_cast<uint64_t>(req);
+
+    ++_in_flight;
+
+    if (!_polling)
+    {
+        uv_poll_start(&_uv_poll, UV_READABLE, [](uv_poll_t *handle, int, int)
+        {
+            static_cast<uring_filesystem *>(handle->data)->reap();
+        });
+
+        _polling = true;
+    }
+}
+
+int vfs::uring::uring_filesystem::submit() noexcept
+{
+    if (!_ring.is_open())
+    {
+        return 0;
+    }
+
+    return _ring.submit();
+}
+
+void vfs::uring::uring_filesystem::reap() noexcept
+{
+    uint64_t events;
+
+    while (::read(_ring.event_fd(), &events, sizeof(events)) > 0)
+    {}
+
+    _ring.reap([this](uint64_t user_data, int32_t res)
+    {
+        auto req = reinterpret_cast<uring_req *>(user_data);
+
+        --_in_flight;
+
+        req->complete(res);
+
+        delete req;
+    });
+
+    if (_in_flight == 0 && _ring.pending() == 0)
+    {
+        uv_poll_stop(&_uv_poll);
+        _polling = false;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold desc="exists">
+
+struct exists_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    std::string path;
+    struct statx stx;
+    exists_cb cb;
+
+    exists_req(vfs::uring::_uring_path_t &p, exists_cb &&cb)
+        : p(p), path(p.view()), stx({}), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        auto err = get_uring_error(res);
+
+        if (err == ENOENT)
+        {
+            cb(p, 0, false);
+        }
+        else
+        {
+            cb(p, err, err == 0);
+        }
+    }
+};
+
+int vfs::uring::uring_filesystem::exists(vfs::uring::_uring_path_t path, exists_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_STATX))
+    {
+        return _uv_fs.exists(path, std::move(cb));
+    }
+
+    auto req = make_req<exists_req>(path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_statx(sqe, AT_FDCWD, req->path.c_str(), 0, &req->stx);
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="stat">
+
+struct stat_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    std::string path;
+    struct statx stx;
+    stat_cb cb;
+
+    stat_req(vfs::uring::_uring_path_t &p, stat_cb &&cb)
+        : p(p), path(p.view()), stx({}), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        if (res < 0)
+        {
+            cb(p, get_uring_error(res), {});
+        }
+        else
+        {
+            vfs::uring::_uring_stat_t uv_stat {to_uv_stat(stx)};
+
+            cb(p, 0, uv_stat);
+        }
+    }
+};
+
+int vfs::uring::uring_filesystem::stat(vfs::uring::_uring_path_t path, stat_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_STATX))
+    {
+        return _uv_fs.stat(path, std::move(cb));
+    }
+
+    auto req = make_req<stat_req>(path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_statx(sqe, AT_FDCWD, req->path.c_str(), 0, &req->stx);
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="mkdir">
+
+struct mkdir_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    std::string path;
+    mkdir_cb cb;
+
+    mkdir_req(vfs::uring::_uring_path_t &p, mkdir_cb &&cb)
+        : p(p), path(p.view()), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        cb(p, get_uring_error(res));
+    }
+};
+
+int vfs::uring::uring_filesystem::mkdir(vfs::uring::_uring_path_t path, int32_t mode, mkdir_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_MKDIRAT))
+    {
+        return _uv_fs.mkdir(path, mode, std::move(cb));
+    }
+
+    auto req = make_req<mkdir_req>(path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_MKDIRAT, AT_FDCWD, req->path.c_str(), static_cast<uint32_t>(mode), 0);
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="mkdirs">
+
+int vfs::uring::uring_filesystem::mkdirs(vfs::uring::_uring_path_t path, int32_t mode, mkdirs_cb cb) noexcept
+{
+    return _uv_fs.mkdirs(path, mode, std::move(cb));
+}
+
+// </editor-fold>
+
+// <editor-fold desc="create">
+
+struct create_req : vfs::uring::uring_req
+{
+    vfs::uring::uring_filesystem &fs;
+    vfs::uring::_uring_path_t p;
+    std::string path;
+    create_cb cb;
+
+    create_req(vfs::uring::uring_filesystem &fs, vfs::uring::_uring_path_t &p, create_cb &&cb)
+        : fs(fs), p(p), path(p.view()), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        cb(p, get_uring_error(res));
+
+        if (res >= 0)
+        {
+            fs.close(vfs::uring::_uring_file_t {p, res}, [](vfs::uring::_uring_file_t &, int)
+            {});
+        }
+    }
+};
+
+int vfs::uring::uring_filesystem::create(vfs::uring::_uring_path_t path, int32_t mode, create_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_OPENAT) || !uses_ring(IORING_OP_CLOSE))
+    {
+        return _uv_fs.create(path, mode, std::move(cb));
+    }
+
+    auto req = make_req<create_req>(*this, path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_OPENAT, AT_FDCWD, req->path.c_str(), static_cast<uint32_t>(mode), 0);
+    sqe->open_flags = O_CREAT | O_EXCL | O_CLOEXEC;
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="move">
+
+struct move_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    vfs::uring::_uring_path_t move_p;
+    std::string path;
+    std::string move_path;
+    move_cb cb;
+
+    move_req(vfs::uring::_uring_path_t &p, vfs::uring::_uring_path_t &move_p, move_cb &&cb)
+        : p(p), move_p(move_p), path(p.view()), move_path(move_p.view()), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        cb(p, move_p, get_uring_error(res));
+    }
+};
+
+int vfs::uring::uring_filesystem::move(vfs::uring::_uring_path_t path, vfs::uring::_uring_path_t move_path,
+                                       move_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_RENAMEAT))
+    {
+        return _uv_fs.move(path, move_path, std::move(cb));
+    }
+
+    auto req = make_req<move_req>(path, move_path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_RENAMEAT, AT_FDCWD, req->path.c_str(), static_cast<uint32_t>(AT_FDCWD),
+            reinterpret_cast<uint64_t>(req->move_path.c_str()));
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="copy">
+
+int vfs::uring::uring_filesystem::copy(vfs::uring::_uring_path_t path, vfs::uring::_uring_path_t copy_path,
+                                       copy_cb cb) noexcept
+{
+    return _uv_fs.copy(path, copy_path, std::move(cb));
+}
+
+// </editor-fold>
+
+// <editor-fold desc="link">
+
+struct link_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    vfs::uring::_uring_path_t link_p;
+    std::string path;
+    std::string link_path;
+    link_cb cb;
+
+    link_req(vfs::uring::_uring_path_t &p, vfs::uring::_uring_path_t &link_p, link_cb &&cb)
+        : p(p), link_p(link_p), path(p.view()), link_path(link_p.view()), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        cb(p, link_p, get_uring_error(res));
+    }
+};
+
+int vfs::uring::uring_filesystem::link(vfs::uring::_uring_path_t path, vfs::uring::_uring_path_t link_path,
+                                       link_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_LINKAT))
+    {
+        return _uv_fs.link(path, link_path, std::move(cb));
+    }
+
+    auto req = make_req<link_req>(path, link_path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_LINKAT, AT_FDCWD, req->path.c_str(), static_cast<uint32_t>(AT_FDCWD),
+            reinterpret_cast<uint64_t>(req->link_path.c_str()));
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="symlink">
+
+int vfs::uring::uring_filesystem::symlink(vfs::uring::_uring_path_t path, vfs::uring::_uring_path_t link_path,
+                                          symlink_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_SYMLINKAT))
+    {
+        return _uv_fs.symlink(path, link_path, std::move(cb));
+    }
+
+    auto req = make_req<link_req>(path, link_path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_SYMLINKAT, AT_FDCWD, req->path.c_str(), 0,
+            reinterpret_cast<uint64_t>(req->link_path.c_str()));
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="unlink">
+
+struct unlink_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    std::string path;
+    unlink_cb cb;
+
+    unlink_req(vfs::uring::_uring_path_t &p, unlink_cb &&cb)
+        : p(p), path(p.view()), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        cb(p, get_uring_error(res));
+    }
+};
+
+int vfs::uring::uring_filesystem::unlink(vfs::uring::_uring_path_t path, unlink_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_UNLINKAT))
+    {
+        return _uv_fs.unlink(path, std::move(cb));
+    }
+
+    auto req = make_req<unlink_req>(path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_UNLINKAT, AT_FDCWD, req->path.c_str(), 0, 0);
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="open">
+
+struct open_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_path_t p;
+    std::string path;
+    open_cb cb;
+
+    open_req(vfs::uring::_uring_path_t &p, open_cb &&cb)
+        : p(p), path(p.view()), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        if (res < 0)
+        {
+            vfs::uring::_uring_file_t file {p};
+
+            cb(p, get_uring_error(res), file);
+        }
+        else
+        {
+            vfs::uring::_uring_file_t file {p, res};
+
+            cb(p, 0, file);
+        }
+    }
+};
+
+int vfs::uring::uring_filesystem::open(vfs::uring::_uring_path_t path, int32_t mode, int32_t flags,
+                                       open_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_OPENAT))
+    {
+        return _uv_fs.open(path, mode, flags, std::move(cb));
+    }
+
+    auto req = make_req<open_req>(path, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_OPENAT, AT_FDCWD, req->path.c_str(), static_cast<uint32_t>(mode), 0);
+    sqe->open_flags = static_cast<uint32_t>(flags) | O_CLOEXEC;
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="fstat">
+
+struct fstat_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_file_t file;
+    struct statx stx;
+    fstat_cb cb;
+
+    fstat_req(vfs::uring::_uring_file_t &file, fstat_cb &&cb)
+        : file(file), stx({}), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        if (res < 0)
+        {
+            vfs::uring::_uring_stat_t uv_stat;
+
+            cb(file, get_uring_error(res), uv_stat);
+        }
+        else
+        {
+            vfs::uring::_uring_stat_t uv_stat {to_uv_stat(stx)};
+
+            cb(file, 0, uv_stat);
+        }
+    }
+};
+
+int vfs::uring::uring_filesystem::stat(vfs::uring::_uring_file_t file, fstat_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_STATX))
+    {
+        return _uv_fs.stat(file, std::move(cb));
+    }
+
+    auto req = make_req<fstat_req>(file, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_statx(sqe, file.uv_fd(), "", AT_EMPTY_PATH, &req->stx);
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="read">
+
+struct read_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_buf_t buf;
+    vfs::uring::_uring_file_t file;
+    iovec iov;
+    read_cb cb;
+
+    read_req(vfs::uring::_uring_buf_t &&buf, vfs::uring::_uring_file_t &file, read_cb &&cb)
+        : buf(std::move(buf)), file(file), iov({}), cb(std::move(cb))
+    {
+        iov.iov_base = this->buf.data();
+        iov.iov_len = this->buf.capacity();
+    }
+
+    void complete(int32_t res) noexcept override
+    {
+        if (res >= 0)
+        {
+            buf.truncate(static_cast<uint64_t>(res));
+        }
+
+        cb(file, get_uring_error(res), buf);
+    }
+};
+
+int vfs::uring::uring_filesystem::read(vfs::uring::_uring_file_t file, vfs::uring::_uring_buf_t buf, off64_t off,
+                                       read_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_READV))
+    {
+        return _uv_fs.read(file, std::move(buf), off, std::move(cb));
+    }
+
+    auto req = make_req<read_req>(std::move(buf), file, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_READV, file.uv_fd(), &req->iov, 1, get_uring_off(off));
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="write">
+
+struct write_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_buf_t buf;
+    vfs::uring::_uring_file_t file;
+    iovec iov;
+    write_cb cb;
+
+    write_req(vfs::uring::_uring_buf_t &&buf, vfs::uring::_uring_file_t &file, write_cb &&cb)
+        : buf(std::move(buf)), file(file), iov({}), cb(std::move(cb))
+    {
+        iov.iov_base = this->buf.data();
+        iov.iov_len = this->buf.size();
+    }
+
+    void complete(int32_t res) noexcept override
+    {
+        if (res >= 0)
+        {
+            buf.truncate(static_cast<uint64_t>(res));
+        }
+
+        cb(file, get_uring_error(res), buf);
+    }
+};
+
+int vfs::uring::uring_filesystem::write(vfs::uring::_uring_file_t file, vfs::uring::_uring_buf_t buf, off64_t off,
+                                        write_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_WRITEV))
+    {
+        return _uv_fs.write(file, std::move(buf), off, std::move(cb));
+    }
+
+    auto req = make_req<write_req>(std::move(buf), file, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_WRITEV, file.uv_fd(), &req->iov, 1, get_uring_off(off));
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="readv">
+
+struct rwv_req : vfs::uring::uring_req
+{
+    std::vector<vfs::uring::_uring_buf_t> bufs;
+    vfs::uring::_uring_file_t file;
+    std::vector<iovec> iovs;
+    bool use_capacity;
+    readv_cb cb;
+
+    rwv_req(std::vector<vfs::uring::_uring_buf_t> &&bufs, vfs::uring::_uring_file_t &file, bool use_capacity,
+            readv_cb &&cb)
+        : bufs(std::move(bufs)), file(file), iovs(this->bufs.size()), use_capacity(use_capacity), cb(std::move(cb))
+    {
+        for (std::size_t i = 0; i < this->bufs.size(); ++i)
+        {
+            auto &buf = this->bufs[i];
+
+            iovs[i].iov_base = buf.data();
+            iovs[i].iov_len = use_capacity ? buf.capacity() : buf.size();
+        }
+    }
+
+    void complete(int32_t res) noexcept override
+    {
+        if (res >= 0)
+        {
+            auto n = static_cast<uint64_t>(res);
+
+            for (std::size_t i = 0; i < bufs.size(); ++i)
+            {
+                auto fill = std::min(static_cast<uint64_t>(iovs[i].iov_len), n);
+
+                bufs[i].truncate(fill);
+
+                n -= fill;
+            }
+        }
+
+        cb(file, get_uring_error(res), bufs);
+    }
+};
+
+int vfs::uring::uring_filesystem::readv(vfs::uring::_uring_file_t file, std::vector<vfs::uring::_uring_buf_t> bufs,
+                                        off64_t off, readv_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_READV))
+    {
+        return _uv_fs.readv(file, std::move(bufs), off, std::move(cb));
+    }
+
+    auto req = make_req<rwv_req>(std::move(bufs), file, true, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_READV, file.uv_fd(), req->iovs.data(), static_cast<uint32_t>(req->iovs.size()),
+            get_uring_off(off));
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="writev">
+
+int vfs::uring::uring_filesystem::writev(vfs::uring::_uring_file_t file, std::vector<vfs::uring::_uring_buf_t> bufs,
+                                         off64_t off, writev_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_WRITEV))
+    {
+        return _uv_fs.writev(file, std::move(bufs), off, std::move(cb));
+    }
+
+    auto req = make_req<rwv_req>(std::move(bufs), file, false, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_WRITEV, file.uv_fd(), req->iovs.data(), static_cast<uint32_t>(req->iovs.size()),
+            get_uring_off(off));
+
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="truncate">
+
+int vfs::uring::uring_filesystem::truncate(vfs::uring::_uring_file_t file, uint64_t size, truncate_cb cb) noexcept
+{
+    return _uv_fs.truncate(file, size, std::move(cb));
+}
+
+// </editor-fold>
+
+// <editor-fold desc="close">
+
+struct close_req : vfs::uring::uring_req
+{
+    vfs::uring::_uring_file_t file;
+    close_cb cb;
+
+    close_req(vfs::uring::_uring_file_t &file, close_cb &&cb)
+        : file(file), cb(std::move(cb))
+    {}
+
+    void complete(int32_t res) noexcept override
+    {
+        cb(file, get_uring_error(res));
+    }
+};
+
+int vfs::uring::uring_filesystem::close(vfs::uring::_uring_file_t file, close_cb cb) noexcept
+{
+    if (!uses_ring(IORING_OP_CLOSE))
+    {
+        return _uv_fs.close(file, std::move(cb));
+    }
+
+    auto req = make_req<close_req>(file, std::move(cb));
+
+    if (req == nullptr)
+    {
+        return -ENOMEM;
+    }
+
+    auto sqe = get_sqe();
+
+    if (sqe == nullptr)
+    {
+        delete req;
+        return -EBUSY;
+    }
+
+    prep_rw(sqe, IORING_OP_CLOSE, file.uv_fd(), nullptr, 0, 0);
+    queue(sqe, req);
+
+    return 0;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="map">
+
+int vfs::uring::uring_filesystem::map(vfs::uring::_uring_file_t file, uint64_t off, uint64_t len, int32_t flags,
+                                      map_cb cb) noexcept
+{
+    return _uv_fs.map(file, off, len, flags, std::move(cb));
+}
+
+// </editor-fold>
+
+// <editor-fold desc="readdir">
+
+int vfs::uring::uring_filesystem::readdir(vfs::uring::_uring_path_t path, std::size_t batch_size, uint64_t cursor,
+                                          readdir_cb cb) noexcept
+{
+    return _uv_fs.readdir(path, batch_size, cursor, std::move(cb));
+}
+
+// </editor-fold>
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <vfs/uring/uring.hpp>
+
+static int io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+template<typename t_ptr>
+static inline t_ptr *offset_ptr(void *base, uint32_t off)
+{
+    return reinterpret_cast<t_ptr *>(static_cast<uint8_t *>(base) + off);
+}
+
+vfs::uring::uring::uring(unsigned entries) noexcept
+    : _fd(-1), _event_fd(-1),
+      _sq_ptr(MAP_FAILED), _sq_len(0),
+      _cq_ptr(MAP_FAILED), _cq_len(0),
+      _sqes(static_cast<io_uring_sqe *>(MAP_FAILED)), _sqes_len(0),
+      _sq_head(nullptr), _sq_tail(nullptr), _sq_mask(nullptr), _sq_entries(nullptr), _sq_array(nullptr),
+      _cq_head(nullptr), _cq_tail(nullptr), _cq_mask(nullptr), _cqes(nullptr),
+      _sqe_tail(0), _sqe_head(0)
+{
+    auto result = setup(entries);
+
+    if (result != 0)
+    {
+        teardown();
+
+        _fd = -result;
+    }
+}
+
+vfs::uring::uring::~uring() noexcept
+{
+    teardown();
+}
+
+int vfs::uring::uring::setup(unsigned entries) noexcept
+{
+    io_uring_params params {};
+
+    _fd = io_uring_setup(entries, &params);
+
+    if (_fd < 0)
+    {
+        return errno;
+    }
+
+    _sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_len = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+    if (single_mmap)
+    {
+        _sq_len = _cq_len = std::max(_sq_len, _cq_len);
+    }
+
+    _sq_ptr = mmap(nullptr, _sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+
+    if (_sq_ptr == MAP_FAILED)
+    {
+        return errno;
+    }
+
+    if (single_mmap)
+    {
+        _cq_ptr = _sq_ptr;
+    }
+    else
+    {
+        _cq_ptr = mmap(nullptr, _cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+
+        if (_cq_ptr == MAP_FAILED)
+        {
+            return errno;
+        }
+    }
+
+    _sqes_len = params.sq_entries * sizeof(io_uring_sqe);
+
+    auto sqes = mmap(nullptr, _sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+
+    if (sqes == MAP_FAILED)
+    {
+        return errno;
+    }
+
+    _sqes = static_cast<io_uring_sqe *>(sqes);
+
+    _sq_head = offset_ptr<unsigned>(_sq_ptr, params.sq_off.head);
+    _sq_tail = offset_ptr<unsigned>(_sq_ptr, params.sq_off.tail);
+    _sq_mask = offset_ptr<unsigned>(_sq_ptr, params.sq_off.ring_mask);
+    _sq_entries = offset_ptr<unsigned>(_sq_ptr, params.sq_off.ring_entries);
+    _sq_array = offset_ptr<unsigned>(_sq_ptr, params.sq_off.array);
+
+    _cq_head = offset_ptr<unsigned>(_cq_ptr, params.cq_off.head);
+    _cq_tail = offset_ptr<unsigned>(_cq_ptr, params.cq_off.tail);
+    _cq_mask = offset_ptr<unsigned>(_cq_ptr, params.cq_off.ring_mask);
+    _cqes = offset_ptr<io_uring_cqe>(_cq_ptr, params.cq_off.cqes);
+
+    _sqe_head = _sqe_tail = *_sq_tail;
+
+    _event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (_event_fd < 0)
+    {
+        return errno;
+    }
+
+    if (io_uring_register(_fd, IORING_REGISTER_EVENTFD, &_event_fd, 1) < 0)
+    {
+        return errno;
+    }
+
+    probe();
+
+    return 0;
+}
+
+void vfs::uring::uring::probe() noexcept
+{
+    static const unsigned n_ops = 256;
+
+    auto size = sizeof(io_uring_probe) + n_ops * sizeof(io_uring_probe_op);
+    auto buf = std::make_unique<uint8_t[]>(size);
+    auto p = reinterpret_cast<io_uring_probe *>(buf.get());
+
+    if (io_uring_register(_fd, IORING_REGISTER_PROBE, p, n_ops) < 0)
+    {
+        return;
+    }
+
+    for (unsigned i = 0; i < p->ops_len; ++i)
+    {
+        if (p->ops[i].flags & IO_URING_OP_SUPPORTED)
+        {
+            _supported.set(p->ops[i].op);
+        }
+    }
+}
+
+void vfs::uring::uring::teardown() noexcept
+{
+    if (_sqes != MAP_FAILED)
+    {
+        munmap(_sqes, _sqes_len);
+        _sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    }
+
+    if (_cq_ptr != MAP_FAILED && _cq_ptr != _sq_ptr)
+    {
+        munmap(_cq_ptr, _cq_len);
+    }
+
+    _cq_ptr = MAP_FAILED;
+
+    if (_sq_ptr != MAP_FAILED)
+    {
+        munmap(_sq_ptr, _sq_len);
+        _sq_ptr = MAP_FAILED;
+    }
+
+    if (_event_fd >= 0)
+    {
+        ::close(_event_fd);
+        _event_fd = -1;
+    }
+
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    _supported.reset();
+}
+
+io_uring_sqe *vfs::uring::uring::get_sqe() noexcept
+{
+    auto head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+
+    if (_sqe_tail - head >= *_sq_entries)
+    {
+        return nullptr;
+    }
+
+    auto sqe = &_sqes[_sqe_tail & *_sq_mask];
+
+    std::memset(sqe, 0, sizeof(*sqe));
+
+    ++_sqe_tail;
+
+    return sqe;
+}
+
+int vfs::uring::uring::submit() noexcept
+{
+    auto tail = *_sq_tail;
+    auto mask = *_sq_mask;
+
+    while (_sqe_head != _sqe_tail)
+    {
+        _sq_array[tail & mask] = _sqe_head & mask;
+
+        ++tail;
+        ++_sqe_head;
+    }
+
+    __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+
+    auto to_submit = tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+
+    if (to_submit == 0)
+    {
+        return 0;
+    }
+
+    int result;
+
+    do
+    {
+        result = io_uring_enter(_fd, to_submit, 0, 0);
+    }
+    while (result < 0 && errno == EINTR);
+
+    return result < 0 ? -errno : result;
+}
+
+int vfs::uring::uring::wait(unsigned min_complete) noexcept
+{
+    int result;
+
+    do
+    {
+        result = io_uring_enter(_fd, 0, min_complete, IORING_ENTER_GETEVENTS);
+    }
+    while (result < 0 && errno == EINTR);
+
+    return result < 0 ? -errno : result;
+}
@@ -1,65 +1,180 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <tuple>
 #include <vector>
 
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vfs/crc32c.hpp>
 #include <vfs/path.hpp>
 #include <vfs/filesystem.hpp>
 
 #include <vfs/uv/uv-filesystem.hpp>
 
-// <editor-fold desc="using">
-
-using exists_cb = typename vfs::uv::uv_filesystem::exists_cb;
-using stat_cb = typename vfs::uv::uv_filesystem::stat_cb;
-using mkdir_cb = typename vfs::uv::uv_filesystem::mkdir_cb;
-using mkdirs_cb = typename vfs::uv::uv_filesystem::mkdirs_cb;
-using create_cb = typename vfs::uv::uv_filesystem::create_cb;
-using move_cb = typename vfs::uv::uv_filesystem::move_cb;
-using copy_cb = typename vfs::uv::uv_filesystem::copy_cb;
-using link_cb = typename vfs::uv::uv_filesystem::link_cb;
-using symlink_cb = typename vfs::uv::uv_filesystem::symlink_cb;
-using unlink_cb = typename vfs::uv::uv_filesystem::unlink_cb;
-using open_cb = typename vfs::uv::uv_filesystem::open_cb;
-using fstat_cb = typename vfs::uv::uv_filesystem::fstat_cb;
-using read_cb = typename vfs::uv::uv_filesystem::read_cb;
-using write_cb = typename vfs::uv::uv_filesystem::write_cb;
-using truncate_cb = typename vfs::uv::uv_filesystem::truncate_cb;
-using close_cb = typename vfs::uv::uv_filesystem::close_cb;
+// <editor-fold desc="worker pool">
 
-// </editor-fold>
+template<typename t_path>
+void vfs::uv::basic_uv_filesystem<t_path>::use_worker_pool(vfs::uv::uv_worker_pool &pool) noexcept
+{
+    _work_port.reset(new vfs::uv::uv_work_port {pool, loop()});
+}
 
-static auto new_uv_req(void *data)
+template<typename t_path>
+template<typename t_call, typename... t_paths>
+int vfs::uv::basic_uv_filesystem<t_path>::fs_call(uv_fs_t *req, uv_work_class cls, t_call call, uv_fs_cb cb,
+                                                  const t_paths &... paths) noexcept
 {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+    if (!_work_port)
+    {
+        return call(loop(), req, cb, paths.c_str()...);
+    }
+
+    auto uv_loop = loop().ptr();
+
+    // the caller may reuse its path as soon as we return, so the worker gets its own copy
+    std::array<std::string, sizeof...(t_paths)> owned;
+
+    try
+    {
+        owned = {std::string {paths.view()}...};
+    }
+    catch (const std::bad_alloc &)
+    {
+        return UV_ENOMEM;
+    }
+
+    return _work_port->submit(cls, [uv_loop, req, call, owned = std::move(owned)]()
+    {
+        auto result = std::apply([&](const auto &... p)
+        {
+            return call(uv_loop, req, nullptr, p.c_str()...);
+        }, owned);
 
-    return new uv_fs_t {
-        .data = data
+        if (result < 0)
+        {
+            req->result = result;
+        }
+    }, [req, cb]()
+    {
+        cb(req);
+    });
+}
+
+template<typename t_path>
+template<typename t_work, typename t_after>
+int vfs::uv::basic_uv_filesystem<t_path>::work_call(uv_work_class cls, t_work work, t_after after) noexcept
+{
+    struct holder
+    {
+        uv_work_t req;
+        t_work work;
+        t_after after;
+        int result;
     };
 
-#pragma GCC diagnostic pop
+    auto h = new(std::nothrow) holder {uv_work_t {}, std::move(work), std::move(after), 0};
+
+    if (h == nullptr)
+    {
+        return UV_ENOMEM;
+    }
+
+    int result;
+
+    if (_work_port)
+    {
+        result = _work_port->submit(cls, [h]()
+        {
+            h->result = h->work();
+        }, [h]()
+        {
+            h->after(h->result);
+
+            delete h;
+        });
+    }
+    else
+    {
+        h->req.data = h;
+
+        result = uv_queue_work(loop().ptr(), &h->req, [](uv_work_t *req)
+        {
+            auto h = static_cast<holder *>(req->data);
+
+            h->result = h->work();
+        }, [](uv_work_t *req, int status)
+        {
+            auto h = static_cast<holder *>(req->data);
+
+            h->after(status < 0 ? status : h->result);
+
+            delete h;
+        });
+    }
+
+    if (result != 0)
+    {
+        delete h;
+    }
+
+    return result;
+}
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::submit_work(uv_work_class cls, vfs::uv::uv_worker_pool::work work,
+                                                      vfs::uv::uv_worker_pool::work done) noexcept
+{
+    return work_call(cls, [work = std::move(work)]() mutable
+    {
+        work();
+
+        return 0;
+    }, [done = std::move(done)](int) mutable
+    {
+        done();
+    });
 }
 
+// </editor-fold>
+
 // <editor-fold desc="exists">
 
+template<typename t_path>
 struct exists_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    exists_cb cb;
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::exists_cb cb;
 };
 
-int vfs::uv::uv_filesystem::exists(vfs::uv::_uv_path_t path, exists_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::exists(t_path path, exists_cb cb) noexcept
 {
-    auto d = new exists_cb_data {
+    auto r = _req_pool.acquire(exists_cb_data<t_path> {
         .p = path,
-        .cb = cb
-    };
-
-    auto r = new_uv_req(d);
+        .cb = std::move(cb)
+    });
 
-    auto result = uv_fs_stat(loop(), r, path.str().c_str(), [](uv_fs_t *req)
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path)
+    {
+        return uv_fs_stat(loop, req, path, cb);
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<exists_cb_data>(req);
+        auto data = get_uv_data<exists_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
@@ -79,14 +194,12 @@ int vfs::uv::uv_filesystem::exists(vfs::uv::_uv_path_t path, exists_cb cb) noexc
             data->cb(data->p, 0, true);
         }
 
-        delete data;
-        delete req;
-    });
+        uv_req_pool::release<exists_cb_data<t_path>>(req);
+    }, path);
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<exists_cb_data<t_path>>(r);
     }
 
     return result;
@@ -96,26 +209,30 @@ int vfs::uv::uv_filesystem::exists(vfs::uv::_uv_path_t path, exists_cb cb) noexc
 
 // <editor-fold desc="stat">
 
+template<typename t_path>
 struct stat_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    stat_cb cb;
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::stat_cb cb;
 };
 
-int vfs::uv::uv_filesystem::stat(vfs::uv::_uv_path_t path, stat_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::stat(t_path path, stat_cb cb) noexcept
 {
-    auto d = new stat_cb_data {
+    auto r = _req_pool.acquire(stat_cb_data<t_path> {
         .p = path,
-        .cb = cb
-    };
-
-    auto r = new_uv_req(d);
+        .cb = std::move(cb)
+    });
 
-    auto result = uv_fs_stat(loop(), r, path.str().c_str(), [](uv_fs_t *req)
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path)
+    {
+        return uv_fs_stat(loop, req, path, cb);
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<stat_cb_data>(req);
+        auto data = get_uv_data<stat_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
@@ -128,14 +245,12 @@ int vfs::uv::uv_filesystem::stat(vfs::uv::_uv_path_t path, stat_cb cb) noexcept
             data->cb(data->p, 0, uv_stat);
         }
 
-        delete data;
-        delete req;
-    });
+        uv_req_pool::release<stat_cb_data<t_path>>(req);
+    }, path);
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<stat_cb_data<t_path>>(r);
     }
 
     return result;
@@ -145,26 +260,34 @@ int vfs::uv::uv_filesystem::stat(vfs::uv::_uv_path_t path, stat_cb cb) noexcept
 
 // <editor-fold desc="mkdir">
 
+template<typename t_path>
 struct mkdir_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    mkdir_cb cb;
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::mkdir_cb cb;
+    int32_t mode;
 };
 
-int vfs::uv::uv_filesystem::mkdir(vfs::uv::_uv_path_t path, int32_t mode, mkdir_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::mkdir(t_path path, int32_t mode, mkdir_cb cb) noexcept
 {
-    auto d = new mkdir_cb_data {
+    auto r = _req_pool.acquire(mkdir_cb_data<t_path> {
         .p = path,
-        .cb = cb
-    };
+        .cb = std::move(cb),
+        .mode = mode
+    });
 
-    auto r = new_uv_req(d);
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path)
+    {
+        auto data = get_uv_data<mkdir_cb_data<t_path>>(req);
 
-    auto result = uv_fs_mkdir(loop(), r, path.str().c_str(), mode, [](uv_fs_t *req)
+        return uv_fs_mkdir(loop, req, path, data->mode, cb);
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<mkdir_cb_data>(req);
+        auto data = get_uv_data<mkdir_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
@@ -175,14 +298,12 @@ int vfs::uv::uv_filesystem::mkdir(vfs::uv::_uv_path_t path, int32_t mode, mkdir_
             data->cb(data->p, 0);
         }
 
-        delete data;
-        delete req;
-    });
+        uv_req_pool::release<mkdir_cb_data<t_path>>(req);
+    }, path);
 
     if (result)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<mkdir_cb_data<t_path>>(r);
     }
 
     return result;
@@ -192,50 +313,240 @@ int vfs::uv::uv_filesystem::mkdir(vfs::uv::_uv_path_t path, int32_t mode, mkdir_
 
 // <editor-fold desc="mkdirs">
 
+template<typename t_path>
 struct mkdirs_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    mkdir_cb cb;
+    vfs::uv::basic_uv_filesystem<t_path> &fs;
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::mkdirs_cb cb;
     int32_t mode;
+    std::string target;
+    std::size_t end;
+    bool descending;
+    bool verifying;
 };
 
-int vfs::uv::uv_filesystem::mkdirs(vfs::uv::_uv_path_t path, int32_t mode, mkdirs_cb cb) noexcept
+static std::size_t parent_end(const std::string &dir, std::size_t end)
+{
+    if (end == 0)
+    {
+        return 0;
+    }
+
+    auto pos = dir.find_last_of('/', end - 1);
+
+    if (pos == std::string::npos)
+    {
+        return 0;
+    }
+
+    while (pos > 0 && dir[pos - 1] == '/')
+    {
+        --pos;
+    }
+
+    return pos;
+}
+
+static std::size_t next_end(const std::string &dir, std::size_t end)
+{
+    auto pos = dir.find_first_not_of('/', end);
+
+    if (pos == std::string::npos)
+    {
+        return dir.size();
+    }
+
+    pos = dir.find('/', pos);
+
+    return pos == std::string::npos ? dir.size() : pos;
+}
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::mkdirs(t_path path, int32_t mode, mkdirs_cb cb) noexcept
+{
+    std::string target {path.view()};
+
+    while (target.size() > 1 && target.back() == '/')
+    {
+        target.pop_back();
+    }
+
+    auto end = target.size();
+
+    auto r = _req_pool.acquire(mkdirs_cb_data<t_path> {
+        .fs = *this,
+        .p = path,
+        .cb = std::move(cb),
+        .mode = mode,
+        .target = std::move(target),
+        .end = end,
+        .descending = false,
+        .verifying = false
+    });
+
+    auto result = mkdirs_issue(r);
+
+    if (result != 0)
+    {
+        uv_req_pool::release<mkdirs_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::mkdirs_issue(uv_fs_t *req) noexcept
+{
+    auto data = get_uv_data<mkdirs_cb_data<t_path>>(req);
+
+    if (data->verifying)
+    {
+        return data->fs.fs_call(req, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+        {
+            auto data = get_uv_data<mkdirs_cb_data<t_path>>(req);
+
+            return uv_fs_stat(loop, req, data->target.c_str(), cb);
+        }, &mkdirs_complete);
+    }
+
+    return data->fs.fs_call(req, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<mkdirs_cb_data<t_path>>(req);
+
+        return uv_fs_mkdir(loop, req, data->target.substr(0, data->end).c_str(), data->mode, cb);
+    }, &mkdirs_complete);
+}
+
+template<typename t_path>
+void vfs::uv::basic_uv_filesystem<t_path>::mkdirs_complete(uv_fs_t *req) noexcept
 {
-    (void) path;
-    (void) mode;
-    (void) cb;
+    auto data = get_uv_data<mkdirs_cb_data<t_path>>(req);
+
+    auto err = req->result < 0 ? get_uv_error(req) : 0;
+    auto is_dir = data->verifying && err == 0 && S_ISDIR(req->statbuf.st_mode);
+    auto again = false;
+
+    uv_fs_req_cleanup(req);
+
+    auto &cache = data->fs._dir_cache;
+    auto leaf = data->end == data->target.size();
+
+    if (data->verifying)
+    {
+        if (err == 0 && !is_dir)
+        {
+            cache.erase(data->target);
+
+            err = EEXIST;
+        }
+        else if (err == 0)
+        {
+            cache.insert(data->target);
+        }
+    }
+    else if (err == 0 || err == EEXIST)
+    {
+        if (leaf && err == EEXIST)
+        {
+            data->verifying = true;
+            again = true;
+        }
+        else if (leaf)
+        {
+            cache.insert(data->target);
+            err = 0;
+        }
+        else
+        {
+            cache.insert(data->target.substr(0, data->end));
+
+            data->descending = true;
+            data->end = next_end(data->target, data->end);
+            again = true;
+        }
+    }
+    else if (err == ENOENT)
+    {
+        auto end = parent_end(data->target, data->end);
+
+        if (data->descending)
+        {
+            cache.erase(data->target.substr(0, end));
+        }
+
+        data->descending = false;
+
+        for (auto up = parent_end(data->target, end); end > 0 && up > 0; up = parent_end(data->target, up))
+        {
+            if (cache.contains(data->target.substr(0, up)))
+            {
+                data->descending = true;
+                data->end = next_end(data->target, up);
+                break;
+            }
+        }
+
+        if (!data->descending)
+        {
+            data->end = end;
+        }
+
+        again = end > 0;
+    }
 
-    return -1;
+    if (again)
+    {
+        auto result = mkdirs_issue(req);
+
+        if (result == 0)
+        {
+            return;
+        }
+
+        err = -result;
+    }
+
+    data->cb(data->p, err);
+
+    uv_req_pool::release<mkdirs_cb_data<t_path>>(req);
 }
 
 // </editor-fold>
 
 // <editor-fold desc="create">
 
+template<typename t_path>
 struct create_cb_data
 {
-    vfs::uv::uv_filesystem &fs;
-    vfs::uv::_uv_path_t p;
-    create_cb cb;
+    vfs::uv::basic_uv_filesystem<t_path> &fs;
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::create_cb cb;
+    int32_t mode;
 };
 
-int vfs::uv::uv_filesystem::create(vfs::uv::_uv_path_t path, int32_t mode, create_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::create(t_path path, int32_t mode, create_cb cb) noexcept
 {
-    auto d = new create_cb_data {
+    auto r = _req_pool.acquire(create_cb_data<t_path> {
         .fs = *this,
         .p = path,
-        .cb = cb
-    };
-
-    auto r = new_uv_req(d);
+        .cb = std::move(cb),
+        .mode = mode
+    });
 
-    auto flags = UV_FS_O_CREAT | UV_FS_O_EXCL;
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path)
+    {
+        auto data = get_uv_data<create_cb_data<t_path>>(req);
+        auto flags = UV_FS_O_CREAT | UV_FS_O_EXCL;
 
-    auto result = uv_fs_open(loop(), r, path.str().c_str(), flags, mode, [](uv_fs_t *req) noexcept
+        return uv_fs_open(loop, req, path, flags, data->mode, cb);
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<create_cb_data>(req);
+        auto data = get_uv_data<create_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
@@ -246,27 +557,33 @@ int vfs::uv::uv_filesystem::create(vfs::uv::_uv_path_t path, int32_t mode, creat
             data->cb(data->p, 0);
         }
 
-        auto file = get_uv_file(req);
+        if (req->result < 0)
+        {
+            uv_req_pool::release<create_cb_data<t_path>>(req);
+
+            return;
+        }
 
-        auto other_result = uv_fs_close(data->fs.loop(), req, file, [](uv_fs_t *req)
+        auto other_result = data->fs.fs_call(req, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req,
+                                                                              uv_fs_cb cb)
+        {
+            return uv_fs_close(loop, req, get_uv_file(req), cb);
+        }, [](uv_fs_t *req)
         {
             uv_fs_req_cleanup(req);
 
-            delete get_uv_data<create_cb_data>(req);
-            delete req;
+            uv_req_pool::release<create_cb_data<t_path>>(req);
         });
 
         if (other_result != 0)
         {
-            delete data;
-            delete req;
+            uv_req_pool::release<create_cb_data<t_path>>(req);
         }
-    });
+    }, path);
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<create_cb_data<t_path>>(r);
     }
 
     return result;
@@ -276,46 +593,1233 @@ int vfs::uv::uv_filesystem::create(vfs::uv::_uv_path_t path, int32_t mode, creat
 
 // <editor-fold desc="move">
 
+template<typename t_path>
 struct move_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    vfs::uv::_uv_path_t move_p;
-    move_cb cb;
+    t_path p;
+    t_path move_p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::move_cb cb;
 };
 
-int vfs::uv::uv_filesystem::move(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t move_path, move_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::move(t_path path, t_path move_path, move_cb cb) noexcept
 {
-    auto d = new move_cb_data {
+    auto r = _req_pool.acquire(move_cb_data<t_path> {
         .p = path,
         .move_p = move_path,
-        .cb = cb
-    };
+        .cb = std::move(cb)
+    });
+
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path, const char *other_path)
+    {
+        return uv_fs_rename(loop, req, path, other_path, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<move_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            data->cb(data->p, data->move_p, get_uv_error(req));
+        }
+        else
+        {
+            data->cb(data->p, data->move_p, 0);
+        }
+
+        uv_req_pool::release<move_cb_data<t_path>>(req);
+    }, path, move_path);
+
+    if (result != 0)
+    {
+        uv_req_pool::release<move_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="copy">
+
+template<typename t_path>
+struct vfs::uv::uv_copy_job
+{
+    vfs::uv::basic_uv_filesystem<t_path> &fs;
+    t_path p;
+    t_path copy_p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::copy_cb cb;
+    vfs::uv::uv_copy_options options;
+    std::string src_path;
+    std::string dst_path;
+    std::atomic<vfs::uv::uv_copy_method> method;
+    int src;
+    int dst;
+    uint64_t size;
+    uint64_t next;
+    uint64_t copied;
+    std::size_t running;
+    int error;
+};
+
+struct copy_range_state
+{
+    int out;
+    std::unique_ptr<char[]> buf;
+};
+
+static const std::size_t copy_buf_size = 1024 * 1024;
+
+static bool copy_unsupported(int err) noexcept
+{
+    return err == EOPNOTSUPP || err == ENOTTY || err == EINVAL || err == EXDEV || err == ENOSYS;
+}
+
+template<typename t_job>
+static ssize_t copy_with_sendfile(t_job *job, copy_range_state &state,
+                                  uint64_t off, uint64_t len) noexcept
+{
+    if (state.out < 0)
+    {
+        state.out = ::open(job->dst_path.c_str(), O_WRONLY | O_CLOEXEC);
+
+        if (state.out < 0)
+        {
+            return -1;
+        }
+    }
+
+    if (::lseek64(state.out, static_cast<off64_t>(off), SEEK_SET) < 0)
+    {
+        return -1;
+    }
+
+    auto in = static_cast<off64_t>(off);
+
+    return ::sendfile64(state.out, job->src, &in, len);
+}
+
+template<typename t_job>
+static ssize_t copy_with_read_write(t_job *job, copy_range_state &state,
+                                    uint64_t off, uint64_t len) noexcept
+{
+    if (!state.buf)
+    {
+        state.buf.reset(new(std::nothrow) char[copy_buf_size]);
+
+        if (!state.buf)
+        {
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+
+    auto n = ::pread64(job->src, state.buf.get(), std::min<uint64_t>(len, copy_buf_size), off);
+
+    if (n <= 0)
+    {
+        return n;
+    }
+
+    ssize_t written = 0;
+
+    while (written < n)
+    {
+        auto w = ::pwrite64(job->dst, state.buf.get() + written, n - written, off + written);
+
+        if (w < 0 && errno != EINTR)
+        {
+            return -1;
+        }
+
+        written += w < 0 ? 0 : w;
+    }
+
+    return n;
+}
+
+template<typename t_job>
+static int copy_segment(t_job *job, copy_range_state &state,
+                        uint64_t off, uint64_t len) noexcept
+{
+    using vfs::uv::uv_copy_method;
+
+    while (len > 0)
+    {
+        auto method = job->method.load(std::memory_order_relaxed);
+
+        ssize_t n;
+
+        if (method == uv_copy_method::copy_file_range)
+        {
+            auto in = static_cast<loff_t>(off);
+            auto out = static_cast<loff_t>(off);
+
+            n = ::copy_file_range(job->src, &in, job->dst, &out, len, 0);
+        }
+        else if (method == uv_copy_method::sendfile)
+        {
+            n = copy_with_sendfile(job, state, off, len);
+        }
+        else
+        {
+            n = copy_with_read_write(job, state, off, len);
+        }
+
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            if (method != uv_copy_method::read_write && copy_unsupported(errno))
+            {
+                auto lower = static_cast<uv_copy_method>(static_cast<uint8_t>(method) + 1);
+
+                job->method.compare_exchange_strong(method, lower);
+                continue;
+            }
+
+            return -errno;
+        }
+
+        if (n == 0)
+        {
+            break;
+        }
+
+        off += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+template<typename t_job>
+static int copy_range(t_job *job, uint64_t off, uint64_t len) noexcept
+{
+    copy_range_state state {-1, nullptr};
+
+    auto end = off + len;
+    auto sparse = job->options.sparse;
+    auto result = 0;
+
+    while (off < end && result == 0)
+    {
+        auto data_end = end;
+
+        if (sparse)
+        {
+            auto data = ::lseek64(job->src, static_cast<off64_t>(off), SEEK_DATA);
+
+            if (data < 0 && errno == ENXIO)
+            {
+                break;
+            }
+
+            if (data < 0)
+            {
+                sparse = false;
+            }
+            else if (static_cast<uint64_t>(data) >= end)
+            {
+                break;
+            }
+            else
+            {
+                off = data;
+
+                auto hole = ::lseek64(job->src, data, SEEK_HOLE);
+
+                if (hole > 0 && static_cast<uint64_t>(hole) < end)
+                {
+                    data_end = hole;
+                }
+            }
+        }
+
+        result = copy_segment(job, state, off, data_end - off);
+        off = data_end;
+    }
+
+    if (state.out >= 0)
+    {
+        ::close(state.out);
+    }
+
+    return result;
+}
+
+template<typename t_job>
+static int copy_prepare(t_job *job) noexcept
+{
+    job->src = ::open(job->src_path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (job->src < 0)
+    {
+        return -errno;
+    }
+
+    struct stat64 stat;
+
+    if (::fstat64(job->src, &stat) < 0)
+    {
+        return -errno;
+    }
+
+    job->dst = ::open(job->dst_path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, stat.st_mode & 07777);
+
+    if (job->dst < 0)
+    {
+        return -errno;
+    }
+
+    struct stat64 dst_stat;
+
+    if (::fstat64(job->dst, &dst_stat) < 0)
+    {
+        return -errno;
+    }
+
+    if (dst_stat.st_dev == stat.st_dev && dst_stat.st_ino == stat.st_ino)
+    {
+        // copying a file onto itself is a no-op; forget dst so a failure never unlinks the source
+        ::close(job->dst);
+        job->dst = -1;
+
+        return 0;
+    }
+
+    if (::ftruncate64(job->dst, 0) < 0)
+    {
+        return -errno;
+    }
+
+    job->size = static_cast<uint64_t>(stat.st_size);
+
+    if (job->method == vfs::uv::uv_copy_method::reflink)
+    {
+        if (::ioctl(job->dst, FICLONE, job->src) == 0)
+        {
+            job->next = job->size;
+            job->copied = job->size;
+
+            return 0;
+        }
+
+        if (!copy_unsupported(errno))
+        {
+            return -errno;
+        }
+
+        job->method = vfs::uv::uv_copy_method::copy_file_range;
+    }
+
+    if (::ftruncate64(job->dst, static_cast<off64_t>(job->size)) < 0)
+    {
+        return -errno;
+    }
+
+    return 0;
+}
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::copy(t_path path, t_path copy_path, copy_cb cb) noexcept
+{
+    return copy(path, copy_path, uv_copy_options {}, std::move(cb));
+}
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::copy(t_path path, t_path copy_path, uv_copy_options options,
+                                               copy_cb cb) noexcept
+{
+    auto method = options.method;
+
+    auto job = new(std::nothrow) uv_copy_job<t_path> {
+        .fs = *this,
+        .p = path,
+        .copy_p = copy_path,
+        .cb = std::move(cb),
+        .options = std::move(options),
+        .src_path = std::string {path.view()},
+        .dst_path = std::string {copy_path.view()},
+        .method = {method},
+        .src = -1,
+        .dst = -1,
+        .size = 0,
+        .next = 0,
+        .copied = 0,
+        .running = 0,
+        .error = 0
+    };
+
+    if (job == nullptr)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto result = work_call(uv_work_class::data, [job]()
+    {
+        return copy_prepare(job);
+    }, [job](int result)
+    {
+        job->error = result < 0 ? result : 0;
+
+        if (job->error == 0 && job->copied > 0 && job->options.progress)
+        {
+            job->options.progress(job->copied, job->size);
+        }
+
+        copy_pump(job);
+    });
+
+    if (result != 0)
+    {
+        delete job;
+    }
+
+    return result;
+}
+
+template<typename t_path>
+void vfs::uv::basic_uv_filesystem<t_path>::copy_pump(uv_copy_job<t_path> *job) noexcept
+{
+    auto chunk = job->options.chunk_size > 0 ? job->options.chunk_size : job->size;
+    auto parallelism = job->options.parallelism > 0 ? job->options.parallelism : 1;
+
+    while (job->error == 0 && job->next < job->size && job->running < parallelism)
+    {
+        auto off = job->next;
+        auto len = std::min(chunk, job->size - off);
+
+        auto result = job->fs.work_call(uv_work_class::data, [job, off, len]()
+        {
+            return copy_range(job, off, len);
+        }, [job, len](int result)
+        {
+            --job->running;
+
+            if (result < 0)
+            {
+                job->error = job->error != 0 ? job->error : result;
+            }
+            else
+            {
+                job->copied += len;
+
+                if (job->options.progress)
+                {
+                    job->options.progress(job->copied, job->size);
+                }
+            }
+
+            copy_pump(job);
+        });
+
+        if (result != 0)
+        {
+            job->error = result;
+            break;
+        }
+
+        job->next += len;
+        ++job->running;
+    }
+
+    if (job->running == 0 && (job->error != 0 || job->next >= job->size))
+    {
+        copy_finish(job);
+    }
+}
+
+template<typename t_path>
+void vfs::uv::basic_uv_filesystem<t_path>::copy_finish(uv_copy_job<t_path> *job) noexcept
+{
+    auto close = [job]()
+    {
+        if (job->src >= 0)
+        {
+            ::close(job->src);
+        }
+
+        if (job->dst >= 0)
+        {
+            ::close(job->dst);
+
+            if (job->error != 0)
+            {
+                ::unlink(job->dst_path.c_str());
+            }
+        }
+
+        return 0;
+    };
+
+    auto done = [job](int)
+    {
+        job->cb(job->p, job->copy_p, -job->error);
+
+        delete job;
+    };
+
+    if (job->fs.work_call(uv_work_class::metadata, close, done) != 0)
+    {
+        done(close());
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold desc="link">
+
+template<typename t_path>
+struct link_cb_data
+{
+    t_path p;
+    t_path link_p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::link_cb cb;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::link(t_path path, t_path link_path, link_cb cb) noexcept
+{
+    auto r = _req_pool.acquire(link_cb_data<t_path> {
+        .p = path,
+        .link_p = link_path,
+        .cb = std::move(cb)
+    });
+
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path, const char *other_path)
+    {
+        return uv_fs_link(loop, req, path, other_path, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<link_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            data->cb(data->p, data->link_p, get_uv_error(req));
+        }
+        else
+        {
+            data->cb(data->p, data->link_p, 0);
+        }
+
+        uv_req_pool::release<link_cb_data<t_path>>(req);
+    }, path, link_path);
+
+    if (result != 0)
+    {
+        uv_req_pool::release<link_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="symlink">
+
+template<typename t_path>
+struct symlink_cb_data
+{
+    t_path p;
+    t_path link_p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::symlink_cb cb;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::symlink(t_path path, t_path link_path, symlink_cb cb) noexcept
+{
+    auto r = _req_pool.acquire(symlink_cb_data<t_path> {
+        .p = path,
+        .link_p = link_path,
+        .cb = std::move(cb)
+    });
+
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path, const char *other_path)
+    {
+        return uv_fs_symlink(loop, req, path, other_path, 0, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<symlink_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            data->cb(data->p, data->link_p, get_uv_error(req));
+        }
+        else
+        {
+            data->cb(data->p, data->link_p, 0);
+        }
+
+        uv_req_pool::release<symlink_cb_data<t_path>>(req);
+    }, path, link_path);
+
+    if (result != 0)
+    {
+        uv_req_pool::release<symlink_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="unlink">
+
+template<typename t_path>
+struct unlink_cb_data
+{
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::unlink_cb cb;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::unlink(t_path path, unlink_cb cb) noexcept
+{
+    auto r = _req_pool.acquire(unlink_cb_data<t_path> {
+        .p = path,
+        .cb = std::move(cb)
+    });
+
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path)
+    {
+        return uv_fs_unlink(loop, req, path, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<unlink_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            data->cb(data->p, get_uv_error(req));
+        }
+        else
+        {
+            data->cb(data->p, 0);
+        }
+
+        uv_req_pool::release<unlink_cb_data<t_path>>(req);
+    }, path);
+
+    if (result != 0)
+    {
+        uv_req_pool::release<unlink_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="open">
+
+template<typename t_path>
+struct open_cb_data
+{
+    t_path p;
+    typename vfs::uv::basic_uv_filesystem<t_path>::open_cb cb;
+    int32_t mode;
+    int32_t flags;
+    uint32_t direct_alignment;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::open(t_path path, int32_t mode, int32_t flags, open_cb cb) noexcept
+{
+    auto r = _req_pool.acquire(open_cb_data<t_path> {
+        .p = path,
+        .cb = std::move(cb),
+        .mode = mode,
+        .flags = flags,
+        .direct_alignment = (flags & O_DIRECT) != 0 ? _direct_alignment : 0
+    });
+
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb,
+                                                         const char *path)
+    {
+        auto data = get_uv_data<open_cb_data<t_path>>(req);
+
+        return uv_fs_open(loop, req, path, data->flags, data->mode, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<open_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            vfs::uv::uv_file<t_path> file {data->p};
+
+            data->cb(data->p, get_uv_error(req), file);
+        }
+        else
+        {
+            vfs::uv::uv_file<t_path> file {data->p, get_uv_file(req), data->direct_alignment};
+
+            data->cb(data->p, 0, file);
+        }
+
+        uv_req_pool::release<open_cb_data<t_path>>(req);
+    }, path);
+
+    if (result != 0)
+    {
+        uv_req_pool::release<open_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="fstat">
+
+template<typename t_path>
+struct fstat_cb_data
+{
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::fstat_cb cb;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::stat(file_type file, fstat_cb cb) noexcept
+{
+    auto r = _req_pool.acquire(fstat_cb_data<t_path> {
+        .file = file,
+        .cb = std::move(cb)
+    });
+
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<fstat_cb_data<t_path>>(req);
+
+        return uv_fs_fstat(loop, req, data->file.uv_fd(), cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<fstat_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            vfs::uv::_uv_stat_t uv_stat;
+
+            data->cb(data->file, get_uv_error(req), uv_stat);
+        }
+        else
+        {
+            vfs::uv::_uv_stat_t uv_stat {req->statbuf};
+
+            data->cb(data->file, 0, uv_stat);
+        }
+
+        uv_req_pool::release<fstat_cb_data<t_path>>(req);
+    });
+
+    if (result != 0)
+    {
+        uv_req_pool::release<fstat_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="read">
+
+template<typename t_path>
+struct read_cb_data
+{
+    vfs::uv::_uv_buf_t buf;
+    vfs::uv::uv_file<t_path> f;
+    typename vfs::uv::basic_uv_filesystem<t_path>::read_cb cb;
+    off64_t off;
+};
+
+// Linux never moves more than MAX_RW_COUNT bytes in a single read/write; work_call ops that do their own I/O are
+// clamped to the same limit so their byte count always fits the int carried back to the loop
+static const uint64_t max_rw_count = 0x7ffff000;
+
+template<typename t_path>
+static bool is_direct_aligned(vfs::uv::uv_file<t_path> &file, vfs::uv::_uv_buf_t &buf, uint64_t len, off64_t off)
+{
+    auto alignment = file.direct_alignment();
+
+    return alignment == 0 ||
+           (off >= 0 && off % alignment == 0 && len % alignment == 0 && buf.is_aligned(alignment));
+}
+
+template<typename t_path>
+static bool is_direct_aligned(vfs::uv::uv_file<t_path> &file, std::vector<vfs::uv::_uv_buf_t> &bufs,
+                              bool use_capacity, off64_t off)
+{
+    auto alignment = file.direct_alignment();
+
+    if (alignment == 0)
+    {
+        return true;
+    }
+
+    if (off < 0 || off % alignment != 0)
+    {
+        return false;
+    }
+
+    for (auto &buf : bufs)
+    {
+        auto len = use_capacity ? buf.capacity() : buf.size();
+
+        if (len % alignment != 0 || !buf.is_aligned(alignment))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename t_path>
+static bool is_direct_aligned(vfs::uv::uv_file<t_path> &file, const vfs::buffer_chain &chain, off64_t off)
+{
+    auto alignment = file.direct_alignment();
+
+    if (alignment == 0)
+    {
+        return true;
+    }
+
+    if (off < 0 || off % alignment != 0)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < chain.count(); ++i)
+    {
+        auto &slice = chain[i];
+
+        if (slice.size() % alignment != 0 || reinterpret_cast<uintptr_t>(slice.data()) % alignment != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static ssize_t direct_pread(int fd, uint8_t *ptr, uint64_t len, off64_t off) noexcept
+{
+    uint64_t done = 0;
+
+    while (done < len)
+    {
+        auto n = ::pread64(fd, ptr + done, len - done, off + done);
+
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (n < 0)
+        {
+            return -errno;
+        }
+
+        if (n == 0)
+        {
+            break;
+        }
+
+        done += n;
+    }
+
+    return static_cast<ssize_t>(done);
+}
+
+static ssize_t direct_read(int fd, uint8_t *ptr, uint64_t len, off64_t off, uint32_t alignment) noexcept
+{
+    off64_t start = off / alignment * alignment;
+    off64_t end = (off + static_cast<off64_t>(len) + alignment - 1) / alignment * alignment;
+
+    std::unique_ptr<uint8_t[], vfs::buffer_deleter> bounce {
+        new(std::align_val_t {alignment}, std::nothrow) uint8_t[end - start],
+        vfs::buffer_deleter {&vfs::aligned_buffer_source::instance(), alignment}
+    };
+
+    if (!bounce)
+    {
+        return -ENOMEM;
+    }
+
+    auto n = direct_pread(fd, bounce.get(), end - start, start);
+
+    if (n < 0)
+    {
+        return n;
+    }
+
+    auto head = static_cast<uint64_t>(off - start);
+    auto available = static_cast<uint64_t>(n) > head ? std::min<uint64_t>(len, n - head) : 0;
+
+    std::memcpy(ptr, bounce.get() + head, available);
+
+    return static_cast<ssize_t>(available);
+}
+
+// bounced writes rewrite whole edge blocks and trim the padding back off, so two of them on one file must not
+// interleave; the lock is striped by device and inode, which also covers the same file opened twice
+static std::mutex &direct_write_lock(const struct stat64 &stat) noexcept
+{
+    static std::array<std::mutex, 64> locks;
+
+    return locks[(stat.st_dev * 31 + stat.st_ino) % locks.size()];
+}
+
+static ssize_t direct_write(int fd, const uint8_t *ptr, uint64_t len, off64_t off, uint32_t alignment) noexcept
+{
+    struct stat64 stat;
+
+    if (::fstat64(fd, &stat) < 0)
+    {
+        return -errno;
+    }
+
+    std::lock_guard<std::mutex> lock {direct_write_lock(stat)};
+
+    // the size that matters is the one observed under the lock
+    if (::fstat64(fd, &stat) < 0)
+    {
+        return -errno;
+    }
+
+    off64_t start = off / alignment * alignment;
+    off64_t end = (off + static_cast<off64_t>(len) + alignment - 1) / alignment * alignment;
+    auto size = stat.st_size;
+
+    std::unique_ptr<uint8_t[], vfs::buffer_deleter> bounce {
+        new(std::align_val_t {alignment}, std::nothrow) uint8_t[end - start],
+        vfs::buffer_deleter {&vfs::aligned_buffer_source::instance(), alignment}
+    };
+
+    if (!bounce)
+    {
+        return -ENOMEM;
+    }
+
+    std::memset(bounce.get(), 0, end - start);
+
+    if (start != off && start < size)
+    {
+        auto n = direct_pread(fd, bounce.get(), alignment, start);
+
+        if (n < 0)
+        {
+            return n;
+        }
+    }
+
+    off64_t tail = end - alignment;
+
+    if (off + static_cast<off64_t>(len) != end && tail < size && (tail != start || start == off))
+    {
+        auto n = direct_pread(fd, bounce.get() + (tail - start), alignment, tail);
+
+        if (n < 0)
+        {
+            return n;
+        }
+    }
+
+    std::memcpy(bounce.get() + (off - start), ptr, len);
+
+    uint64_t done = 0;
+
+    while (done < static_cast<uint64_t>(end - start))
+    {
+        auto n = ::pwrite64(fd, bounce.get() + done, end - start - done, start + done);
+
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (n < 0)
+        {
+            return -errno;
+        }
+
+        done += n;
+    }
+
+    auto new_size = std::max<off64_t>(size, off + static_cast<off64_t>(len));
+
+    if (end > new_size && ::ftruncate64(fd, new_size) < 0)
+    {
+        return -errno;
+    }
+
+    return static_cast<ssize_t>(len);
+}
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::read(file_type file, buffer_type buf, off64_t off, read_cb cb) noexcept
+{
+    if (file.direct_alignment() != 0 && off < 0)
+    {
+        return UV_EINVAL;
+    }
+
+    if (!is_direct_aligned(file, buf, buf.capacity(), off))
+    {
+        auto fd = file.uv_fd();
+        auto ptr = buf.data();
+        auto len = std::min(buf.capacity(), max_rw_count);
+        auto alignment = file.direct_alignment();
+
+        return work_call(uv_work_class::data, [fd, ptr, len, off, alignment]()
+        {
+            return static_cast<int>(direct_read(fd, ptr, len, off, alignment));
+        }, [file, buf = std::move(buf), cb = std::move(cb)](int result) mutable
+        {
+            buf.truncate(result < 0 ? 0 : result);
+
+            cb(file, result < 0 ? -result : 0, buf);
+        });
+    }
+
+    auto r = _req_pool.acquire(read_cb_data<t_path> {
+        .buf = std::move(buf),
+        .f = file,
+        .cb = std::move(cb),
+        .off = off
+    });
+
+    auto result = fs_call(r, uv_work_class::data, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<read_cb_data<t_path>>(req);
+
+        uv_buf_t bufs[] = {
+            {.base = data->buf.template data<char>(), .len = data->buf.capacity()}
+        };
+
+        return uv_fs_read(loop, req, data->f.uv_fd(), bufs, 1, data->off, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<read_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            data->cb(data->f, get_uv_error(req), data->buf);
+        }
+        else
+        {
+            auto n_read = static_cast<uint64_t>(req->result);
+
+            data->buf.truncate(n_read);
+
+            data->cb(data->f, 0, data->buf);
+        }
+
+        uv_req_pool::release<read_cb_data<t_path>>(req);
+    });
+
+    if (result)
+    {
+        uv_req_pool::release<read_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="write">
+
+template<typename t_path>
+struct write_cb_data
+{
+    vfs::uv::_uv_buf_t buf;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::write_cb cb;
+    off64_t off;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::write(file_type file, buffer_type buf, off64_t off, write_cb cb) noexcept
+{
+    if (file.direct_alignment() != 0 && off < 0)
+    {
+        return UV_EINVAL;
+    }
+
+    if (!is_direct_aligned(file, buf, buf.size(), off))
+    {
+        auto fd = file.uv_fd();
+        auto ptr = buf.data();
+        auto len = std::min(buf.size(), max_rw_count);
+        auto alignment = file.direct_alignment();
+
+        return work_call(uv_work_class::data, [fd, ptr, len, off, alignment]()
+        {
+            return static_cast<int>(direct_write(fd, ptr, len, off, alignment));
+        }, [file, buf = std::move(buf), cb = std::move(cb)](int result) mutable
+        {
+            if (result >= 0)
+            {
+                buf.truncate(result);
+            }
+
+            cb(file, result < 0 ? -result : 0, buf);
+        });
+    }
+
+    auto r = _req_pool.acquire(write_cb_data<t_path> {
+        .buf = std::move(buf),
+        .file = file,
+        .cb = std::move(cb),
+        .off = off
+    });
+
+    auto result = fs_call(r, uv_work_class::data, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<write_cb_data<t_path>>(req);
+
+        uv_buf_t bufs[] = {
+            {.base = data->buf.template data<char>(), .len = data->buf.size()}
+        };
+
+        return uv_fs_write(loop, req, data->file.uv_fd(), bufs, 1, data->off, cb);
+    }, [](uv_fs_t *req)
+    {
+        uv_fs_req_cleanup(req);
+
+        auto data = get_uv_data<write_cb_data<t_path>>(req);
+
+        if (req->result < 0)
+        {
+            data->cb(data->file, get_uv_error(req), data->buf);
+        }
+        else
+        {
+            auto n_write = static_cast<uint64_t>(req->result);
+
+            data->buf.truncate(n_write);
+
+            data->cb(data->file, 0, data->buf);
+        }
+
+        uv_req_pool::release<write_cb_data<t_path>>(req);
+    });
+
+    if (result != 0)
+    {
+        uv_req_pool::release<write_cb_data<t_path>>(r);
+    }
+
+    return result;
+}
+
+// </editor-fold>
+
+// <editor-fold desc="read chain">
+
+static const std::size_t uv_chain_bufs_inline = 8;
+
+template<typename t_fn>
+static int with_uv_chain_bufs(vfs::buffer_chain &chain, t_fn &&fn)
+{
+    uv_buf_t inline_bufs[uv_chain_bufs_inline];
+    std::unique_ptr<uv_buf_t[]> heap_bufs;
+
+    auto n_bufs = chain.count();
+    auto uv_bufs = inline_bufs;
+
+    if (n_bufs > uv_chain_bufs_inline)
+    {
+        heap_bufs = std::make_unique<uv_buf_t[]>(n_bufs);
+        uv_bufs = heap_bufs.get();
+    }
+
+    for (std::size_t i = 0; i < n_bufs; ++i)
+    {
+        uv_bufs[i].base = reinterpret_cast<char *>(chain[i].data());
+        uv_bufs[i].len = chain[i].size();
+    }
+
+    return fn(uv_bufs, static_cast<unsigned int>(n_bufs));
+}
+
+template<typename t_path>
+struct read_chain_cb_data
+{
+    vfs::buffer_chain chain;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::read_chain_cb cb;
+    off64_t off;
+};
+
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::read(file_type file, vfs::buffer_chain chain, off64_t off,
+                                               read_chain_cb cb) noexcept
+{
+    if (!is_direct_aligned(file, chain, off))
+    {
+        return UV_EINVAL;
+    }
+
+    auto r = _req_pool.acquire(read_chain_cb_data<t_path> {
+        .chain = std::move(chain),
+        .file = file,
+        .cb = std::move(cb),
+        .off = off
+    });
 
-    auto r = new_uv_req(d);
+    auto result = fs_call(r, uv_work_class::data, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<read_chain_cb_data<t_path>>(req);
 
-    auto result = uv_fs_rename(loop(), r, path.str().c_str(), move_path.str().c_str(), [](uv_fs_t *req)
+        return with_uv_chain_bufs(data->chain, [&](uv_buf_t *uv_bufs, unsigned int n_bufs)
+        {
+            return uv_fs_read(loop, req, data->file.uv_fd(), uv_bufs, n_bufs, data->off, cb);
+        });
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<move_cb_data>(req);
+        auto data = get_uv_data<read_chain_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
-            data->cb(data->p, data->move_p, get_uv_error(req));
+            data->cb(data->file, get_uv_error(req), data->chain);
         }
         else
         {
-            data->cb(data->p, data->move_p, 0);
+            data->chain.truncate(static_cast<uint64_t>(req->result));
+
+            data->cb(data->file, 0, data->chain);
         }
 
-        delete data;
-        delete req;
+        uv_req_pool::release<read_chain_cb_data<t_path>>(req);
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<read_chain_cb_data<t_path>>(r);
     }
 
     return result;
@@ -323,48 +1827,64 @@ int vfs::uv::uv_filesystem::move(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t m
 
 // </editor-fold>
 
-// <editor-fold desc="copy">
+// <editor-fold desc="write chain">
 
-struct copy_cb_data
+template<typename t_path>
+struct write_chain_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    vfs::uv::_uv_path_t copy_p;
-    copy_cb cb;
+    vfs::buffer_chain chain;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::write_chain_cb cb;
+    off64_t off;
 };
 
-int vfs::uv::uv_filesystem::copy(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t copy_path, copy_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::write(file_type file, vfs::buffer_chain chain, off64_t off,
+                                                write_chain_cb cb) noexcept
 {
-    auto d = new copy_cb_data {
-        .p = path,
-        .copy_p = copy_path,
-        .cb = cb
-    };
+    if (!is_direct_aligned(file, chain, off))
+    {
+        return UV_EINVAL;
+    }
+
+    auto r = _req_pool.acquire(write_chain_cb_data<t_path> {
+        .chain = std::move(chain),
+        .file = file,
+        .cb = std::move(cb),
+        .off = off
+    });
 
-    auto r = new_uv_req(d);
+    auto result = fs_call(r, uv_work_class::data, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<write_chain_cb_data<t_path>>(req);
 
-    auto result = uv_fs_copyfile(loop(), r, path.str().c_str(), copy_path.str().c_str(), 0, [](uv_fs_t *req)
+        return with_uv_chain_bufs(data->chain, [&](uv_buf_t *uv_bufs, unsigned int n_bufs)
+        {
+            return uv_fs_write(loop, req, data->file.uv_fd(), uv_bufs, n_bufs, data->off, cb);
+        });
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<copy_cb_data>(req);
+        auto data = get_uv_data<write_chain_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
-            data->cb(data->p, data->copy_p, get_uv_error(req));
+            data->cb(data->file, get_uv_error(req), data->chain);
         }
         else
         {
-            data->cb(data->p, data->copy_p, 0);
+            data->chain.truncate(static_cast<uint64_t>(req->result));
+
+            data->cb(data->file, 0, data->chain);
         }
 
-        delete data;
-        delete req;
+        uv_req_pool::release<write_chain_cb_data<t_path>>(req);
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<write_chain_cb_data<t_path>>(r);
     }
 
     return result;
@@ -372,144 +1892,183 @@ int vfs::uv::uv_filesystem::copy(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t c
 
 // </editor-fold>
 
-// <editor-fold desc="link">
+// <editor-fold desc="checked read/write">
 
-struct link_cb_data
+template<typename t_path>
+struct checked_job
 {
-    vfs::uv::_uv_path_t p;
-    vfs::uv::_uv_path_t link_p;
-    link_cb cb;
+    vfs::uv::_uv_buf_t buf;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::read_checked_cb cb;
+    uint32_t digest;
 };
 
-int vfs::uv::uv_filesystem::link(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t link_path, link_cb cb) noexcept
+static ssize_t checked_io(bool write, int fd, uint8_t *ptr, uint64_t len, off64_t off) noexcept
 {
-    auto d = new link_cb_data {
-        .p = path,
-        .link_p = link_path,
-        .cb = cb
-    };
-
-    auto r = new_uv_req(d);
+    ssize_t n;
 
-    auto result = uv_fs_link(loop(), r, path.str().c_str(), link_path.str().c_str(), [](uv_fs_t *req)
+    do
     {
-        uv_fs_req_cleanup(req);
-
-        auto data = get_uv_data<link_cb_data>(req);
-
-        if (req->result < 0)
+        if (write)
         {
-            data->cb(data->p, data->link_p, get_uv_error(req));
+            n = off < 0 ? ::write(fd, ptr, len) : ::pwrite64(fd, ptr, len, off);
         }
         else
         {
-            data->cb(data->p, data->link_p, 0);
+            n = off < 0 ? ::read(fd, ptr, len) : ::pread64(fd, ptr, len, off);
         }
+    }
+    while (n < 0 && errno == EINTR);
 
-        delete data;
-        delete req;
-    });
+    return n < 0 ? -errno : n;
+}
 
-    if (result != 0)
+static ssize_t checked_write_all(int fd, uint8_t *ptr, uint64_t len, off64_t off) noexcept
+{
+    uint64_t done = 0;
+
+    while (done < len)
     {
-        delete d;
-        delete r;
+        auto n = checked_io(true, fd, ptr + done, len - done, off < 0 ? off : off + static_cast<off64_t>(done));
+
+        if (n < 0)
+        {
+            return n;
+        }
+
+        if (n == 0)
+        {
+            return -EIO;
+        }
+
+        done += n;
     }
 
-    return result;
+    return static_cast<ssize_t>(done);
 }
 
-// </editor-fold>
-
-// <editor-fold desc="symlink">
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::read_checked(file_type file, buffer_type buf, off64_t off,
+                                                       read_checked_cb cb) noexcept
+{
+    return read_checked(file, std::move(buf), off, false, 0, std::move(cb));
+}
 
-struct symlink_cb_data
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::read_checked(file_type file, buffer_type buf, off64_t off, uint32_t expected,
+                                                       read_checked_cb cb) noexcept
 {
-    vfs::uv::_uv_path_t p;
-    vfs::uv::_uv_path_t link_p;
-    symlink_cb cb;
-};
+    return read_checked(file, std::move(buf), off, true, expected, std::move(cb));
+}
 
-int vfs::uv::uv_filesystem::symlink(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t link_path, symlink_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::read_checked(file_type file, buffer_type buf, off64_t off, bool verify,
+                                                       uint32_t expected, read_checked_cb cb) noexcept
 {
-    auto d = new symlink_cb_data {
-        .p = path,
-        .link_p = link_path,
-        .cb = cb
-    };
+    if (file.direct_alignment() != 0 && off < 0)
+    {
+        return UV_EINVAL;
+    }
+
+    auto bounce = !is_direct_aligned(file, buf, buf.capacity(), off);
+    auto alignment = file.direct_alignment();
+    auto fd = file.uv_fd();
+    auto ptr = buf.data();
+    auto len = std::min(buf.capacity(), max_rw_count);
 
-    auto r = new_uv_req(d);
+    auto job = new(std::nothrow) checked_job<t_path> {
+        .buf = std::move(buf),
+        .file = file,
+        .cb = std::move(cb),
+        .digest = 0
+    };
 
-    auto result = uv_fs_symlink(loop(), r, path.str().c_str(), link_path.str().c_str(), 0, [](uv_fs_t *req)
+    if (job == nullptr)
     {
-        uv_fs_req_cleanup(req);
+        return UV_ENOMEM;
+    }
 
-        auto data = get_uv_data<symlink_cb_data>(req);
+    auto result = work_call(uv_work_class::data, [job, bounce, alignment, fd, ptr, len, off, verify, expected]()
+    {
+        auto n = bounce ? direct_read(fd, ptr, len, off, alignment) : checked_io(false, fd, ptr, len, off);
 
-        if (req->result < 0)
-        {
-            data->cb(data->p, data->link_p, get_uv_error(req));
-        }
-        else
+        if (n < 0)
         {
-            data->cb(data->p, data->link_p, 0);
+            return static_cast<int>(n);
         }
 
-        delete data;
-        delete req;
+        job->digest = vfs::crc32c(ptr, n);
+
+        return verify && job->digest != expected ? -EBADMSG : static_cast<int>(n);
+    }, [job](int result)
+    {
+        job->buf.truncate(result < 0 ? 0 : result);
+
+        job->cb(job->file, result < 0 ? -result : 0, job->buf, job->digest);
+
+        delete job;
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        delete job;
     }
 
     return result;
 }
 
-// </editor-fold>
-
-// <editor-fold desc="unlink">
-
-struct unlink_cb_data
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::write_checked(file_type file, buffer_type buf, off64_t off,
+                                                        write_checked_cb cb) noexcept
 {
-    vfs::uv::_uv_path_t p;
-    unlink_cb cb;
-};
+    if (file.direct_alignment() != 0 && off < 0)
+    {
+        return UV_EINVAL;
+    }
 
-int vfs::uv::uv_filesystem::unlink(vfs::uv::_uv_path_t path, unlink_cb cb) noexcept
-{
-    auto d = new unlink_cb_data {
-        .p = path,
-        .cb = cb
-    };
+    auto bounce = !is_direct_aligned(file, buf, buf.size(), off);
+    auto alignment = file.direct_alignment();
+    auto fd = file.uv_fd();
+    auto ptr = buf.data();
+    auto len = std::min(buf.size(), max_rw_count);
 
-    auto r = new_uv_req(d);
+    auto job = new(std::nothrow) checked_job<t_path> {
+        .buf = std::move(buf),
+        .file = file,
+        .cb = std::move(cb),
+        .digest = 0
+    };
 
-    auto result = uv_fs_unlink(loop(), r, path.str().c_str(), [](uv_fs_t *req)
+    if (job == nullptr)
     {
-        uv_fs_req_cleanup(req);
+        return UV_ENOMEM;
+    }
 
-        auto data = get_uv_data<link_cb_data>(req);
+    auto result = work_call(uv_work_class::data, [job, bounce, alignment, fd, ptr, len, off]()
+    {
+        job->digest = vfs::crc32c(ptr, len);
 
-        if (req->result < 0)
+        if (bounce)
         {
-            data->cb(data->p, data->link_p, get_uv_error(req));
+            return static_cast<int>(direct_write(fd, ptr, len, off, alignment));
         }
-        else
+
+        return static_cast<int>(checked_write_all(fd, ptr, len, off));
+    }, [job](int result)
+    {
+        if (result >= 0)
         {
-            data->cb(data->p, data->link_p, 0);
+            job->buf.truncate(result);
         }
 
-        delete data;
-        delete req;
+        job->cb(job->file, result < 0 ? -result : 0, job->buf, job->digest);
+
+        delete job;
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        delete job;
     }
 
     return result;
@@ -517,50 +2076,107 @@ int vfs::uv::uv_filesystem::unlink(vfs::uv::_uv_path_t path, unlink_cb cb) noexc
 
 // </editor-fold>
 
-// <editor-fold desc="open">
+// <editor-fold desc="readv">
 
-struct open_cb_data
+static const std::size_t uv_bufs_inline = 8;
+
+template<typename t_fn>
+static int with_uv_bufs(std::vector<vfs::uv::_uv_buf_t> &bufs, bool use_capacity, t_fn &&fn)
+{
+    uv_buf_t inline_bufs[uv_bufs_inline];
+    std::unique_ptr<uv_buf_t[]> heap_bufs;
+
+    auto n_bufs = bufs.size();
+    auto uv_bufs = inline_bufs;
+
+    if (n_bufs > uv_bufs_inline)
+    {
+        heap_bufs = std::make_unique<uv_buf_t[]>(n_bufs);
+        uv_bufs = heap_bufs.get();
+    }
+
+    for (std::size_t i = 0; i < n_bufs; ++i)
+    {
+        auto &buf = bufs[i];
+
+        uv_bufs[i].base = buf.data<char>();
+        uv_bufs[i].len = use_capacity ? buf.capacity() : buf.size();
+    }
+
+    return fn(uv_bufs, static_cast<unsigned int>(n_bufs));
+}
+
+static void fill_uv_bufs(std::vector<vfs::uv::_uv_buf_t> &bufs, bool use_capacity, uint64_t n)
+{
+    for (auto &buf : bufs)
+    {
+        auto len = use_capacity ? buf.capacity() : buf.size();
+        auto fill = std::min(len, n);
+
+        buf.truncate(fill);
+
+        n -= fill;
+    }
+}
+
+template<typename t_path>
+struct readv_cb_data
 {
-    vfs::uv::_uv_path_t p;
-    open_cb cb;
+    std::vector<vfs::uv::_uv_buf_t> bufs;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::readv_cb cb;
+    off64_t off;
 };
 
-int vfs::uv::uv_filesystem::open(vfs::uv::_uv_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::readv(file_type file, std::vector<buffer_type> bufs, off64_t off,
+                                                readv_cb cb) noexcept
 {
-    auto d = new open_cb_data {
-        .p = path,
-        .cb = cb
-    };
+    if (!is_direct_aligned(file, bufs, true, off))
+    {
+        return UV_EINVAL;
+    }
 
-    auto r = new_uv_req(d);
+    auto r = _req_pool.acquire(readv_cb_data<t_path> {
+        .bufs = std::move(bufs),
+        .file = file,
+        .cb = std::move(cb),
+        .off = off
+    });
+
+    auto result = fs_call(r, uv_work_class::data, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<readv_cb_data<t_path>>(req);
 
-    auto result = uv_fs_open(loop(), r, path.str().c_str(), flags, mode, [](uv_fs_t *req)
+        return with_uv_bufs(data->bufs, true, [&](uv_buf_t *uv_bufs, unsigned int n_bufs)
+        {
+            return uv_fs_read(loop, req, data->file.uv_fd(), uv_bufs, n_bufs, data->off, cb);
+        });
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<open_cb_data>(req);
+        auto data = get_uv_data<readv_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
-            vfs::uv::_uv_file_t file {data->p};
-
-            data->cb(data->p, get_uv_error(req), file);
+            data->cb(data->file, get_uv_error(req), data->bufs);
         }
         else
         {
-            vfs::uv::_uv_file_t file {data->p, get_uv_file(req)};
+            auto n_read = static_cast<uint64_t>(req->result);
 
-            data->cb(data->p, 0, file);
+            fill_uv_bufs(data->bufs, true, n_read);
+
+            data->cb(data->file, 0, data->bufs);
         }
 
-        delete data;
-        delete req;
+        uv_req_pool::release<readv_cb_data<t_path>>(req);
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<readv_cb_data<t_path>>(r);
     }
 
     return result;
@@ -568,50 +2184,66 @@ int vfs::uv::uv_filesystem::open(vfs::uv::_uv_path_t path, int32_t mode, int32_t
 
 // </editor-fold>
 
-// <editor-fold desc="fstat">
+// <editor-fold desc="writev">
 
-struct fstat_cb_data
+template<typename t_path>
+struct writev_cb_data
 {
-    vfs::uv::_uv_file_t file;
-    fstat_cb cb;
+    std::vector<vfs::uv::_uv_buf_t> bufs;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::writev_cb cb;
+    off64_t off;
 };
 
-int vfs::uv::uv_filesystem::stat(vfs::uv::_uv_file_t file, fstat_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::writev(file_type file, std::vector<buffer_type> bufs, off64_t off,
+                                                 writev_cb cb) noexcept
 {
-    auto d = new fstat_cb_data {
+    if (!is_direct_aligned(file, bufs, false, off))
+    {
+        return UV_EINVAL;
+    }
+
+    auto r = _req_pool.acquire(writev_cb_data<t_path> {
+        .bufs = std::move(bufs),
         .file = file,
-        .cb = cb
-    };
+        .cb = std::move(cb),
+        .off = off
+    });
 
-    auto r = new_uv_req(d);
+    auto result = fs_call(r, uv_work_class::data, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<writev_cb_data<t_path>>(req);
 
-    auto result = uv_fs_fstat(loop(), r, file.uv_fd(), [](uv_fs_t *req)
+        return with_uv_bufs(data->bufs, false, [&](uv_buf_t *uv_bufs, unsigned int n_bufs)
+        {
+            return uv_fs_write(loop, req, data->file.uv_fd(), uv_bufs, n_bufs, data->off, cb);
+        });
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<stat_cb_data>(req);
+        auto data = get_uv_data<writev_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
-            vfs::uv::_uv_stat_t uv_stat;
-
-            data->cb(data->p, get_uv_error(req), uv_stat);
+            data->cb(data->file, get_uv_error(req), data->bufs);
         }
         else
         {
-            vfs::uv::_uv_stat_t uv_stat {req->statbuf};
+            auto n_write = static_cast<uint64_t>(req->result);
 
-            data->cb(data->p, 0, uv_stat);
+            fill_uv_bufs(data->bufs, false, n_write);
+
+            data->cb(data->file, 0, data->bufs);
         }
 
-        delete data;
-        delete req;
+        uv_req_pool::release<writev_cb_data<t_path>>(req);
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<writev_cb_data<t_path>>(r);
     }
 
     return result;
@@ -619,56 +2251,53 @@ int vfs::uv::uv_filesystem::stat(vfs::uv::_uv_file_t file, fstat_cb cb) noexcept
 
 // </editor-fold>
 
-// <editor-fold desc="read">
+// <editor-fold desc="truncate">
 
-struct read_cb_data
+template<typename t_path>
+struct truncate_cb_data
 {
-    vfs::uv::_uv_buf_t buf;
-    vfs::uv::_uv_file_t f;
-    read_cb cb;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::truncate_cb cb;
+    uint64_t size;
 };
 
-int vfs::uv::uv_filesystem::read(vfs::uv::_uv_file_t file, vfs::uv::_uv_buf_t buf, off64_t off, read_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::truncate(file_type file, uint64_t size, truncate_cb cb) noexcept
 {
-    auto d = new read_cb_data {
-        .buf = std::move(buf),
-        .f = file,
-        .cb = cb
-    };
-
-    auto r = new_uv_req(d);
+    auto r = _req_pool.acquire(truncate_cb_data<t_path> {
+        .file = file,
+        .cb = std::move(cb),
+        .size = size
+    });
 
-    uv_buf_t bufs[] = {
-        {.base = d->buf.data<char>(), .len = d->buf.capacity()}
-    };
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<truncate_cb_data<t_path>>(req);
 
-    auto result = uv_fs_read(loop(), r, file.uv_fd(), bufs, 1, off, [](uv_fs_t *req)
+        return uv_fs_ftruncate(loop, req, data->file.uv_fd(), data->size, cb);
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<read_cb_data>(req);
+        auto data = get_uv_data<truncate_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
-            data->cb(data->f, get_uv_error(req), data->buf);
+            data->cb(data->file, get_uv_error(req), 0);
         }
         else
         {
-            auto n_read = static_cast<uint64_t>(req->result);
-
-            data->buf.truncate(n_read);
+            auto n_trunc = static_cast<uint64_t>(req->result);
 
-            data->cb(data->f, 0, data->buf);
+            data->cb(data->file, 0, n_trunc);
         }
 
-        delete data;
-        delete req;
+        uv_req_pool::release<truncate_cb_data<t_path>>(req);
     });
 
-    if (result)
+    if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<truncate_cb_data<t_path>>(r);
     }
 
     return result;
@@ -676,56 +2305,49 @@ int vfs::uv::uv_filesystem::read(vfs::uv::_uv_file_t file, vfs::uv::_uv_buf_t bu
 
 // </editor-fold>
 
-// <editor-fold desc="write">
+// <editor-fold desc="close">
 
-struct write_cb_data
+template<typename t_path>
+struct close_cb_data
 {
-    vfs::uv::_uv_buf_t buf;
-    vfs::uv::_uv_file_t file;
-    write_cb cb;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::close_cb cb;
 };
 
-int vfs::uv::uv_filesystem::write(vfs::uv::_uv_file_t file, vfs::uv::_uv_buf_t buf, off64_t off, write_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::close(file_type file, close_cb cb) noexcept
 {
-    auto d = new write_cb_data {
-        .buf = std::move(buf),
+    auto r = _req_pool.acquire(close_cb_data<t_path> {
         .file = file,
-        .cb = cb
-    };
-
-    auto r = new_uv_req(d);
+        .cb = std::move(cb)
+    });
 
-    uv_buf_t bufs[] = {
-        {.base = d->buf.data<char>(), .len = d->buf.size()}
-    };
+    auto result = fs_call(r, uv_work_class::metadata, [](uv_loop_t *loop, uv_fs_t *req, uv_fs_cb cb)
+    {
+        auto data = get_uv_data<close_cb_data<t_path>>(req);
 
-    auto result = uv_fs_write(loop(), r, file.uv_fd(), bufs, 1, off, [](uv_fs_t *req)
+        return uv_fs_close(loop, req, data->file.uv_fd(), cb);
+    }, [](uv_fs_t *req)
     {
         uv_fs_req_cleanup(req);
 
-        auto data = get_uv_data<write_cb_data>(req);
+        auto data = get_uv_data<close_cb_data<t_path>>(req);
 
         if (req->result < 0)
         {
-            data->cb(data->file, get_uv_error(req), data->buf);
+            data->cb(data->file, get_uv_error(req));
         }
         else
         {
-            auto n_write = static_cast<uint64_t>(req->result);
-
-            data->buf.truncate(n_write);
-
-            data->cb(data->file, 0, data->buf);
+            data->cb(data->file, 0);
         }
 
-        delete data;
-        delete req;
+        uv_req_pool::release<close_cb_data<t_path>>(req);
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        uv_req_pool::release<close_cb_data<t_path>>(r);
     }
 
     return result;
@@ -733,48 +2355,46 @@ int vfs::uv::uv_filesystem::write(vfs::uv::_uv_file_t file, vfs::uv::_uv_buf_t b
 
 // </editor-fold>
 
-// <editor-fold desc="truncate">
+// <editor-fold desc="map">
 
-struct truncate_cb_data
+template<typename t_path>
+struct map_job
 {
-    vfs::uv::_uv_file_t file;
-    truncate_cb cb;
+    vfs::uv::uv_file<t_path> file;
+    typename vfs::uv::basic_uv_filesystem<t_path>::map_cb cb;
+    vfs::mapped_slice view;
 };
 
-int vfs::uv::uv_filesystem::truncate(vfs::uv::_uv_file_t file, uint64_t size, truncate_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::map(file_type file, uint64_t off, uint64_t len, int32_t flags,
+                                              map_cb cb) noexcept
 {
-    auto d = new truncate_cb_data {
+    auto job = new(std::nothrow) map_job<t_path> {
         .file = file,
-        .cb = cb
+        .cb = std::move(cb),
+        .view = {}
     };
 
-    auto r = new_uv_req(d);
-
-    auto result = uv_fs_ftruncate(loop(), r, file.uv_fd(), size, [](uv_fs_t *req)
+    if (job == nullptr)
     {
-        uv_fs_req_cleanup(req);
-
-        auto data = get_uv_data<truncate_cb_data>(req);
+        return UV_ENOMEM;
+    }
 
-        if (req->result < 0)
-        {
-            data->cb(data->file, get_uv_error(req), 0);
-        }
-        else
-        {
-            auto n_trunc = static_cast<uint64_t>(req->result);
+    auto fd = file.uv_fd();
 
-            data->cb(data->file, 0, n_trunc);
-        }
+    auto result = work_call(uv_work_class::data, [job, fd, off, len, flags]()
+    {
+        return vfs::map_fd(fd, off, len, flags, job->view);
+    }, [job](int result)
+    {
+        job->cb(job->file, result < 0 ? -result : 0, job->view);
 
-        delete data;
-        delete req;
+        delete job;
     });
 
     if (result != 0)
     {
-        delete d;
-        delete r;
+        delete job;
     }
 
     return result;
@@ -782,49 +2402,119 @@ int vfs::uv::uv_filesystem::truncate(vfs::uv::_uv_file_t file, uint64_t size, tr
 
 // </editor-fold>
 
-// <editor-fold desc="close">
+// <editor-fold desc="readdir">
 
-struct close_cb_data
+template<typename t_path>
+struct vfs::uv::uv_readdir_job
 {
-    vfs::uv::_uv_file_t file;
-    close_cb cb;
+    t_path p;
+    std::string dir_path;
+    typename vfs::uv::basic_uv_filesystem<t_path>::readdir_cb cb;
+    vfs::dir_reader reader;
+    uint64_t cursor;
 };
 
-int vfs::uv::uv_filesystem::close(vfs::uv::_uv_file_t file, close_cb cb) noexcept
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::readdir(t_path path, std::size_t batch_size, uint64_t cursor,
+                                                  readdir_cb cb) noexcept
 {
-    auto d = new close_cb_data {
-        .file = file,
-        .cb = cb
+    auto job = new(std::nothrow) uv_readdir_job<t_path> {
+        .p = path,
+        .dir_path = std::string {path.view()},
+        .cb = std::move(cb),
+        .reader = vfs::dir_reader {batch_size},
+        .cursor = cursor
     };
 
-    auto r = new_uv_req(d);
+    if (job == nullptr)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto result = readdir_pump(job);
 
-    auto result = uv_fs_close(loop(), r, file.uv_fd(), [](uv_fs_t *req)
+    if (result != 0)
     {
-        uv_fs_req_cleanup(req);
+        delete job;
+    }
 
-        auto data = get_uv_data<close_cb_data>(req);
+    return result;
+}
 
-        if (req->result < 0)
+template<typename t_path>
+int vfs::uv::basic_uv_filesystem<t_path>::readdir_pump(uv_readdir_job<t_path> *job) noexcept
+{
+    return work_call(uv_work_class::metadata, [job]()
+    {
+        if (!job->reader.is_open())
         {
-            data->cb(data->file, get_uv_error(req));
+            auto result = job->reader.open(job->dir_path.c_str(), job->cursor);
+
+            if (result != 0)
+            {
+                return result;
+            }
         }
-        else
+
+        return job->reader.next();
+    }, [this, job](int result)
+    {
+        auto &batch = job->reader.batch();
+
+        if (job->cb(job->p, result < 0 ? -result : 0, batch) && result == 0 && !batch.eof())
         {
-            data->cb(data->file, 0);
+            result = readdir_pump(job);
+
+            if (result == 0)
+            {
+                return;
+            }
+
+            batch.clear();
+
+            job->cb(job->p, -result, batch);
         }
 
-        delete data;
-        delete req;
+        delete job;
     });
+}
 
-    if (result != 0)
-    {
-        delete d;
-        delete r;
-    }
+// </editor-fold>
 
-    return result;
+// <editor-fold desc="req pool">
+
+template<typename t_path>
+std::size_t vfs::uv::basic_uv_filesystem<t_path>::req_data_size() noexcept
+{
+    return std::max({
+        sizeof(exists_cb_data<t_path>),
+        sizeof(stat_cb_data<t_path>),
+        sizeof(mkdir_cb_data<t_path>),
+        sizeof(mkdirs_cb_data<t_path>),
+        sizeof(create_cb_data<t_path>),
+        sizeof(move_cb_data<t_path>),
+        sizeof(link_cb_data<t_path>),
+        sizeof(symlink_cb_data<t_path>),
+        sizeof(unlink_cb_data<t_path>),
+        sizeof(open_cb_data<t_path>),
+        sizeof(fstat_cb_data<t_path>),
+        sizeof(read_cb_data<t_path>),
+        sizeof(write_cb_data<t_path>),
+        sizeof(readv_cb_data<t_path>),
+        sizeof(writev_cb_data<t_path>),
+        sizeof(read_chain_cb_data<t_path>),
+        sizeof(write_chain_cb_data<t_path>),
+        sizeof(truncate_cb_data<t_path>),
+        sizeof(close_cb_data<t_path>)
+    });
 }
 
 // </editor-fold>
+
+// <editor-fold desc="instantiations">
+
+template class vfs::uv::basic_uv_filesystem<vfs::any_path>;
+template class vfs::uv::basic_uv_filesystem<vfs::unix_path>;
+template class vfs::uv::basic_uv_filesystem<vfs::unix_small_path>;
+
+// </editor-fold>
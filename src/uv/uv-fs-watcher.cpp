@@ -0,0 +1,155 @@
+#include <cerrno>
+#include <new>
+
+#include <vfs/uv/uv-fs-watcher.hpp>
+
+// <editor-fold desc="uv_fs_watcher">
+
+vfs::uv::uv_fs_watcher::uv_fs_watcher(uv_loop &uv_loop, changed_cb cb) noexcept
+    : _uv_loop(uv_loop), _cb(std::move(cb)), _events(0), _overflows(0)
+{}
+
+vfs::uv::uv_fs_watcher::~uv_fs_watcher() noexcept
+{
+    // the detached watches are freed by their close callbacks on the owner's next loop turn
+    for (auto &it : _watches)
+    {
+        close(it.second);
+    }
+
+    _watches.clear();
+}
+
+void vfs::uv::uv_fs_watcher::on_event(uv_fs_event_t *handle, const char *filename, int, int status) noexcept
+{
+    auto w = static_cast<watch *>(handle->data);
+    auto owner = w->owner;
+
+    if (owner == nullptr)
+    {
+        return;
+    }
+
+    ++owner->_events;
+
+    if (status < 0 || filename == nullptr)
+    {
+        ++owner->_overflows;
+
+        owner->_cb(w->dir);
+        return;
+    }
+
+    std::string path;
+
+    try
+    {
+        path.reserve(w->dir.size() + 1 + std::char_traits<char>::length(filename));
+        path.append(w->dir);
+
+        if (path.empty() || path.back() != '/')
+        {
+            path.push_back('/');
+        }
+
+        path.append(filename);
+    }
+    catch (...)
+    {
+        ++owner->_overflows;
+
+        owner->_cb(w->dir);
+        return;
+    }
+
+    owner->_cb(path);
+}
+
+void vfs::uv::uv_fs_watcher::close(watch *w) noexcept
+{
+    w->owner = nullptr;
+
+    uv_close(reinterpret_cast<uv_handle_t *>(&w->handle), [](uv_handle_t *handle)
+    {
+        delete static_cast<watch *>(handle->data);
+    });
+}
+
+int vfs::uv::uv_fs_watcher::watch_dir(std::string_view dir) noexcept
+{
+    try
+    {
+        std::string key {dir};
+
+        if (_watches.count(key) != 0)
+        {
+            return 0;
+        }
+
+        auto w = new watch {uv_fs_event_t {}, this, key};
+
+        w->handle.data = w;
+
+        auto result = uv_fs_event_init(_uv_loop, &w->handle);
+
+        if (result != 0)
+        {
+            delete w;
+            return result;
+        }
+
+        result = uv_fs_event_start(&w->handle, &on_event, w->dir.c_str(), 0);
+
+        if (result != 0)
+        {
+            close(w);
+            return result;
+        }
+
+        uv_unref(reinterpret_cast<uv_handle_t *>(&w->handle));
+
+        _watches.emplace(std::move(key), w);
+
+        return 0;
+    }
+    catch (...)
+    {
+        return -ENOMEM;
+    }
+}
+
+int vfs::uv::uv_fs_watcher::unwatch_dir(std::string_view dir) noexcept
+{
+    try
+    {
+        auto it = _watches.find(std::string {dir});
+
+        if (it == _watches.end())
+        {
+            return -ENOENT;
+        }
+
+        uv_fs_event_stop(&it->second->handle);
+
+        close(it->second);
+
+        _watches.erase(it);
+
+        return 0;
+    }
+    catch (...)
+    {
+        return -ENOMEM;
+    }
+}
+
+vfs::uv::uv_fs_watcher_stats vfs::uv::uv_fs_watcher::stats() const noexcept
+{
+    return uv_fs_watcher_stats {
+        .events = _events,
+        .overflows = _overflows,
+        .watched = _watches.size()
+    };
+}
+
+// </editor-fold>
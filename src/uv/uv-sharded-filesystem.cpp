@@ -0,0 +1,831 @@
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <vfs/uv/uv-sharded-filesystem.hpp>
+
+// <editor-fold desc="shard">
+
+struct vfs::uv::sharded_filesystem::shard
+{
+    vfs::uv::uv_filesystem fs;
+    uv_async_t async;
+
+    std::mutex mutex;
+    std::vector<shard_task> tasks;
+    std::vector<shard_task> draining;
+    bool stopping;
+
+    std::thread thread;
+
+    std::atomic<uint64_t> submitted;
+    std::atomic<uint64_t> dispatched;
+    std::atomic<uint64_t> rejected;
+    std::atomic<uint64_t> wakeups;
+
+    shard()
+        : async(), stopping(false), submitted(0), dispatched(0), rejected(0), wakeups(0)
+    {
+        async.data = this;
+
+        uv_async_init(fs.loop(), &async, [](uv_async_t *handle)
+        {
+            static_cast<shard *>(handle->data)->drain();
+        });
+    }
+
+    void drain() noexcept
+    {
+        bool stop;
+
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+
+            draining.swap(tasks);
+            stop = stopping;
+        }
+
+        ++wakeups;
+
+        for (auto &task : draining)
+        {
+            if (task(fs) != 0)
+            {
+                ++rejected;
+            }
+
+            ++dispatched;
+        }
+
+        draining.clear();
+
+        if (stop)
+        {
+            uv_close(reinterpret_cast<uv_handle_t *>(&async), nullptr);
+        }
+    }
+
+    void start(std::size_t i, bool pin) noexcept
+    {
+        thread = std::thread {[this]()
+        {
+            fs.loop().run();
+        }};
+
+        if (pin)
+        {
+            auto n_cpus = std::thread::hardware_concurrency();
+
+            if (n_cpus > 0)
+            {
+                cpu_set_t cpus;
+
+                CPU_ZERO(&cpus);
+                CPU_SET(i % n_cpus, &cpus);
+
+                pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+            }
+        }
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+
+            stopping = true;
+        }
+
+        uv_async_send(&async);
+    }
+};
+
+// </editor-fold>
+
+// <editor-fold desc="sharded_filesystem">
+
+vfs::uv::sharded_filesystem::sharded_filesystem(std::size_t n_shards, bool pin_threads)
+{
+    n_shards = n_shards > 0 ? n_shards : 1;
+
+    _shards.reserve(n_shards);
+
+    for (std::size_t i = 0; i < n_shards; ++i)
+    {
+        _shards.emplace_back(new shard {});
+        _shards.back()->start(i, pin_threads);
+    }
+}
+
+vfs::uv::sharded_filesystem::~sharded_filesystem() noexcept
+{
+    for (auto &s : _shards)
+    {
+        s->stop();
+    }
+
+    for (auto &s : _shards)
+    {
+        s->thread.join();
+    }
+}
+
+std::size_t vfs::uv::sharded_filesystem::shard_of(vfs::uv::_uv_path_t path) const noexcept
+{
+    return std::hash<std::string_view> {}(path.view()) % _shards.size();
+}
+
+std::size_t vfs::uv::sharded_filesystem::shard_of(vfs::uv::_uv_file_t file) const noexcept
+{
+    return static_cast<std::size_t>(file.uv_fd()) % _shards.size();
+}
+
+vfs::uv::sharded_filesystem::shard &vfs::uv::sharded_filesystem::shard_for(vfs::uv::_uv_path_t &path) const noexcept
+{
+    return *_shards[shard_of(path)];
+}
+
+vfs::uv::sharded_filesystem::shard &vfs::uv::sharded_filesystem::shard_for(vfs::uv::_uv_file_t &file) const noexcept
+{
+    return *_shards[shard_of(file)];
+}
+
+vfs::uv::uv_shard_stats vfs::uv::sharded_filesystem::shard_stats(std::size_t i) const noexcept
+{
+    auto &s = *_shards[i];
+
+    auto submitted = s.submitted.load(std::memory_order_relaxed);
+    auto dispatched = s.dispatched.load(std::memory_order_relaxed);
+
+    return uv_shard_stats {
+        .submitted = submitted,
+        .dispatched = dispatched,
+        .rejected = s.rejected.load(std::memory_order_relaxed),
+        .wakeups = s.wakeups.load(std::memory_order_relaxed),
+        .queued = submitted > dispatched ? submitted - dispatched : 0
+    };
+}
+
+int vfs::uv::sharded_filesystem::dispatch(shard &s, shard_task task) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock {s.mutex};
+
+        s.tasks.emplace_back(std::move(task));
+    }
+
+    ++s.submitted;
+
+    return uv_async_send(&s.async);
+}
+
+int vfs::uv::sharded_filesystem::post(std::size_t i, shard_task task) noexcept
+{
+    return dispatch(*_shards[i % _shards.size()], std::move(task));
+}
+
+// </editor-fold>
+
+// <editor-fold desc="shard op">
+
+template<typename t_cb>
+struct shard_op
+{
+    vfs::unix_path path;
+    vfs::unix_path other_path;
+    t_cb cb;
+};
+
+template<typename t_cb>
+static std::shared_ptr<shard_op<t_cb>> make_op(t_cb &&cb, std::string_view path = {},
+                                               std::string_view other_path = {}) noexcept
+{
+    try
+    {
+        return std::make_shared<shard_op<t_cb>>(shard_op<t_cb> {
+            .path = vfs::unix_path {std::string {path}},
+            .other_path = vfs::unix_path {std::string {other_path}},
+            .cb = std::move(cb)
+        });
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+// </editor-fold>
+
+// <editor-fold desc="path ops">
+
+int vfs::uv::sharded_filesystem::exists(vfs::uv::_uv_path_t path, exists_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.exists(p, [op](vfs::any_path &p, int err, bool exists)
+        {
+            op->cb(p, err, exists);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, -result, false);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::stat(vfs::uv::_uv_path_t path, stat_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.stat(p, [op](vfs::any_path &p, int err, vfs::uv::uv_stat stat)
+        {
+            op->cb(p, err, stat);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, -result, vfs::uv::uv_stat {});
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::mkdir(vfs::uv::_uv_path_t path, int32_t mode, mkdir_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op, mode](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.mkdir(p, mode, [op](vfs::any_path &p, int err)
+        {
+            op->cb(p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::mkdirs(vfs::uv::_uv_path_t path, int32_t mode, mkdirs_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op, mode](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.mkdirs(p, mode, [op](vfs::any_path &p, int err)
+        {
+            op->cb(p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::create(vfs::uv::_uv_path_t path, int32_t mode, create_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op, mode](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.create(p, mode, [op](vfs::any_path &p, int err)
+        {
+            op->cb(p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::move(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t move_path, move_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view(), move_path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+        vfs::any_path other_p {op->other_path};
+
+        auto result = fs.move(p, other_p, [op](vfs::any_path &p, vfs::any_path &other_p, int err)
+        {
+            op->cb(p, other_p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, other_p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::copy(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t copy_path, copy_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view(), copy_path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+        vfs::any_path other_p {op->other_path};
+
+        auto result = fs.copy(p, other_p, [op](vfs::any_path &p, vfs::any_path &other_p, int err)
+        {
+            op->cb(p, other_p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, other_p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::link(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t other_path, link_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view(), other_path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+        vfs::any_path other_p {op->other_path};
+
+        auto result = fs.link(p, other_p, [op](vfs::any_path &p, vfs::any_path &other_p, int err)
+        {
+            op->cb(p, other_p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, other_p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::symlink(vfs::uv::_uv_path_t path, vfs::uv::_uv_path_t link_path,
+                                         symlink_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view(), link_path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+        vfs::any_path other_p {op->other_path};
+
+        auto result = fs.symlink(p, other_p, [op](vfs::any_path &p, vfs::any_path &other_p, int err)
+        {
+            op->cb(p, other_p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, other_p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::unlink(vfs::uv::_uv_path_t path, unlink_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.unlink(p, [op](vfs::any_path &p, int err)
+        {
+            op->cb(p, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(p, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::open(vfs::uv::_uv_path_t path, int32_t mode, int32_t flags, open_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op, mode, flags](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.open(p, mode, flags, [op](vfs::any_path &p, int err, vfs::uv::_uv_file_t &file)
+        {
+            op->cb(p, err, file);
+        });
+
+        if (result != 0)
+        {
+            vfs::uv::_uv_file_t file {p};
+
+            op->cb(p, -result, file);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::readdir(vfs::uv::_uv_path_t path, std::size_t batch_size, uint64_t cursor,
+                                         readdir_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), path.view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    return dispatch(shard_for(path), [op, batch_size, cursor](vfs::uv::uv_filesystem &fs)
+    {
+        vfs::any_path p {op->path};
+
+        auto result = fs.readdir(p, batch_size, cursor, [op](vfs::any_path &p, int err, vfs::dir_batch &batch)
+        {
+            return op->cb(p, err, batch);
+        });
+
+        if (result != 0)
+        {
+            vfs::dir_batch empty;
+
+            op->cb(p, -result, empty);
+        }
+
+        return result;
+    });
+}
+
+// </editor-fold>
+
+// <editor-fold desc="file ops">
+
+int vfs::uv::sharded_filesystem::stat(vfs::uv::_uv_file_t file, fstat_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.stat(file, [op](vfs::uv::_uv_file_t &file, int err, vfs::uv::uv_stat stat)
+        {
+            op->cb(file, err, stat);
+        });
+
+        if (result != 0)
+        {
+            op->cb(file, -result, vfs::uv::uv_stat {});
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::read(vfs::uv::_uv_file_t file, vfs::uv::_uv_buf_t buf, off64_t off,
+                                      read_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment, buf = std::move(buf), off](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.read(file, std::move(buf), off, [op](vfs::uv::_uv_file_t &file, int err,
+                                                              vfs::uv::_uv_buf_t &buf)
+        {
+            op->cb(file, err, buf);
+        });
+
+        if (result != 0)
+        {
+            vfs::uv::_uv_buf_t empty;
+
+            op->cb(file, -result, empty);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::write(vfs::uv::_uv_file_t file, vfs::uv::_uv_buf_t buf, off64_t off,
+                                       write_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment, buf = std::move(buf), off](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.write(file, std::move(buf), off, [op](vfs::uv::_uv_file_t &file, int err,
+                                                               vfs::uv::_uv_buf_t &buf)
+        {
+            op->cb(file, err, buf);
+        });
+
+        if (result != 0)
+        {
+            vfs::uv::_uv_buf_t empty;
+
+            op->cb(file, -result, empty);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::readv(vfs::uv::_uv_file_t file, std::vector<vfs::uv::_uv_buf_t> bufs, off64_t off,
+                                       readv_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment, bufs = std::move(bufs), off](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.readv(file, std::move(bufs), off, [op](vfs::uv::_uv_file_t &file, int err,
+                                                                std::vector<vfs::uv::_uv_buf_t> &bufs)
+        {
+            op->cb(file, err, bufs);
+        });
+
+        if (result != 0)
+        {
+            std::vector<vfs::uv::_uv_buf_t> empty;
+
+            op->cb(file, -result, empty);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::writev(vfs::uv::_uv_file_t file, std::vector<vfs::uv::_uv_buf_t> bufs, off64_t off,
+                                        writev_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment, bufs = std::move(bufs), off](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.writev(file, std::move(bufs), off, [op](vfs::uv::_uv_file_t &file, int err,
+                                                                 std::vector<vfs::uv::_uv_buf_t> &bufs)
+        {
+            op->cb(file, err, bufs);
+        });
+
+        if (result != 0)
+        {
+            std::vector<vfs::uv::_uv_buf_t> empty;
+
+            op->cb(file, -result, empty);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::truncate(vfs::uv::_uv_file_t file, uint64_t size, truncate_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment, size](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.truncate(file, size, [op](vfs::uv::_uv_file_t &file, int err, uint64_t size)
+        {
+            op->cb(file, err, size);
+        });
+
+        if (result != 0)
+        {
+            op->cb(file, -result, size);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::close(vfs::uv::_uv_file_t file, close_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.close(file, [op](vfs::uv::_uv_file_t &file, int err)
+        {
+            op->cb(file, err);
+        });
+
+        if (result != 0)
+        {
+            op->cb(file, -result);
+        }
+
+        return result;
+    });
+}
+
+int vfs::uv::sharded_filesystem::map(vfs::uv::_uv_file_t file, uint64_t off, uint64_t len, int32_t flags,
+                                     map_cb cb) noexcept
+{
+    auto op = make_op(std::move(cb), file.path().view());
+
+    if (!op)
+    {
+        return UV_ENOMEM;
+    }
+
+    auto fd = file.uv_fd();
+    auto alignment = file.direct_alignment();
+
+    return dispatch(shard_for(file), [op, fd, alignment, off, len, flags](vfs::uv::uv_filesystem &fs) mutable
+    {
+        vfs::any_path p {op->path};
+        vfs::uv::_uv_file_t file {p, fd, alignment};
+
+        auto result = fs.map(file, off, len, flags, [op](vfs::uv::_uv_file_t &file, int err, vfs::mapped_slice &view)
+        {
+            op->cb(file, err, view);
+        });
+
+        if (result != 0)
+        {
+            vfs::mapped_slice empty;
+
+            op->cb(file, -result, empty);
+        }
+
+        return result;
+    });
+}
+
+// </editor-fold>
@@ -0,0 +1,267 @@
+#include <cerrno>
+#include <system_error>
+#include <thread>
+
+#include <vfs/uv/uv-worker-pool.hpp>
+
+// <editor-fold desc="uv_worker_pool">
+
+vfs::uv::uv_worker_pool::uv_worker_pool(std::size_t min_threads, std::size_t max_threads,
+                                        unsigned metadata_weight, unsigned data_weight,
+                                        std::chrono::milliseconds idle_timeout)
+    : _min_threads(min_threads > 0 ? min_threads : 1),
+      _max_threads(max_threads > _min_threads ? max_threads : _min_threads),
+      _metadata_weight(metadata_weight > 0 ? metadata_weight : 1),
+      _data_weight(data_weight > 0 ? data_weight : 1),
+      _idle_timeout(idle_timeout),
+      _turn(0), _stopping(false),
+      _threads(0), _idle(0), _spawned(0), _retired(0), _metadata_done(0), _data_done(0)
+{
+    std::lock_guard<std::mutex> lock {_mutex};
+
+    while (_threads < _min_threads && spawn())
+    {}
+}
+
+vfs::uv::uv_worker_pool::~uv_worker_pool() noexcept
+{
+    std::unique_lock<std::mutex> lock {_mutex};
+
+    _stopping = true;
+
+    _work_cv.notify_all();
+
+    _exit_cv.wait(lock, [this]()
+    {
+        return _threads == 0;
+    });
+}
+
+bool vfs::uv::uv_worker_pool::spawn() noexcept
+{
+    try
+    {
+        std::thread {[this]()
+        {
+            run();
+        }}.detach();
+    }
+    catch (const std::system_error &)
+    {
+        return false;
+    }
+
+    ++_threads;
+    ++_spawned;
+
+    return true;
+}
+
+bool vfs::uv::uv_worker_pool::take(work &task, uv_work_class &cls) noexcept
+{
+    if (_metadata_queue.empty() && _data_queue.empty())
+    {
+        return false;
+    }
+
+    auto prefer_metadata = _turn < _metadata_weight;
+
+    _turn = (_turn + 1) % (_metadata_weight + _data_weight);
+
+    auto use_metadata = _data_queue.empty() || (prefer_metadata && !_metadata_queue.empty());
+    auto &queue = use_metadata ? _metadata_queue : _data_queue;
+
+    task = std::move(queue.front());
+    cls = use_metadata ? uv_work_class::metadata : uv_work_class::data;
+
+    queue.pop_front();
+
+    return true;
+}
+
+void vfs::uv::uv_worker_pool::run() noexcept
+{
+    std::unique_lock<std::mutex> lock {_mutex};
+
+    work task;
+    uv_work_class cls;
+
+    while (true)
+    {
+        if (!take(task, cls))
+        {
+            if (_stopping)
+            {
+                break;
+            }
+
+            ++_idle;
+
+            auto status = _work_cv.wait_for(lock, _idle_timeout);
+
+            --_idle;
+
+            auto empty = _metadata_queue.empty() && _data_queue.empty();
+
+            if (status == std::cv_status::timeout && empty && _threads > _min_threads)
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        lock.unlock();
+
+        task();
+        task = nullptr;
+
+        lock.lock();
+
+        if (cls == uv_work_class::metadata)
+        {
+            ++_metadata_done;
+        }
+        else
+        {
+            ++_data_done;
+        }
+    }
+
+    --_threads;
+    ++_retired;
+
+    _exit_cv.notify_all();
+}
+
+int vfs::uv::uv_worker_pool::submit(uv_work_class cls, work task) noexcept
+{
+    std::lock_guard<std::mutex> lock {_mutex};
+
+    if (_stopping)
+    {
+        return UV_ECANCELED;
+    }
+
+    auto &queue = cls == uv_work_class::metadata ? _metadata_queue : _data_queue;
+
+    queue.emplace_back(std::move(task));
+
+    auto queued = _metadata_queue.size() + _data_queue.size();
+
+    if ((queued > _idle && _threads < _max_threads) || _threads == 0)
+    {
+        spawn();
+    }
+
+    _work_cv.notify_one();
+
+    return 0;
+}
+
+vfs::uv::uv_worker_pool_stats vfs::uv::uv_worker_pool::stats() noexcept
+{
+    std::lock_guard<std::mutex> lock {_mutex};
+
+    return uv_worker_pool_stats {
+        .threads = _threads,
+        .idle = _idle,
+        .spawned = _spawned,
+        .retired = _retired,
+        .metadata_queued = _metadata_queue.size(),
+        .data_queued = _data_queue.size(),
+        .metadata_done = _metadata_done,
+        .data_done = _data_done
+    };
+}
+
+// </editor-fold>
+
+// <editor-fold desc="uv_work_port">
+
+vfs::uv::uv_work_port::uv_work_port(uv_worker_pool &pool, uv_loop &uv_loop) noexcept
+    : _pool(pool), _state(new state {})
+{
+    _state->uv_async.data = _state;
+
+    uv_async_init(uv_loop, &_state->uv_async, [](uv_async_t *handle)
+    {
+        drain(static_cast<state *>(handle->data));
+    });
+
+    uv_unref(reinterpret_cast<uv_handle_t *>(&_state->uv_async));
+}
+
+vfs::uv::uv_work_port::~uv_work_port() noexcept
+{
+    // in-flight completions keep the state alive and still run on the owner's loop
+    _state->detached = true;
+
+    if (_state->in_flight == 0)
+    {
+        close(_state);
+    }
+}
+
+void vfs::uv::uv_work_port::acquire(state *s) noexcept
+{
+    if (s->in_flight++ == 0)
+    {
+        uv_ref(reinterpret_cast<uv_handle_t *>(&s->uv_async));
+    }
+}
+
+void vfs::uv::uv_work_port::release(state *s) noexcept
+{
+    if (--s->in_flight > 0)
+    {
+        return;
+    }
+
+    if (s->detached)
+    {
+        close(s);
+    }
+    else
+    {
+        uv_unref(reinterpret_cast<uv_handle_t *>(&s->uv_async));
+    }
+}
+
+void vfs::uv::uv_work_port::post(state *s, done fn) noexcept
+{
+    // the send happens under the lock, so once the loop has drained a completion its worker is done with s
+    std::lock_guard<std::mutex> lock {s->mutex};
+
+    s->completed.emplace_back(std::move(fn));
+
+    uv_async_send(&s->uv_async);
+}
+
+void vfs::uv::uv_work_port::drain(state *s) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock {s->mutex};
+
+        s->draining.swap(s->completed);
+    }
+
+    for (auto &fn : s->draining)
+    {
+        release(s);
+
+        fn();
+    }
+
+    s->draining.clear();
+}
+
+void vfs::uv::uv_work_port::close(state *s) noexcept
+{
+    uv_close(reinterpret_cast<uv_handle_t *>(&s->uv_async), [](uv_handle_t *handle)
+    {
+        delete static_cast<state *>(handle->data);
+    });
+}
+
+// </editor-fold>
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <vfs/buffer-arena.hpp>
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::buffer_arena> _arena;
+
+        std::vector<vfs::buffer> _buffers;
+        uint8_t *_first_ptr = nullptr;
+
+        int _reset_result = 0;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_arena(vfs::buffer_arena_pages pages, int numa_node = -1)
+        {
+            vfs::buffer_arena_options options;
+
+            options.region_size = 4 * 1024 * 1024;
+            options.pages = pages;
+            options.numa_node = numa_node;
+
+            _arena = std::make_unique<vfs::buffer_arena>(options);
+        }
+
+        void given_released_buffers()
+        {
+            when_buffers_are_acquired(4, 64 * 1024);
+
+            _buffers.clear();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_buffers_are_acquired(std::size_t n, uint64_t capacity)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                _buffers.emplace_back(_arena->acquire(capacity));
+
+                std::memset(_buffers.back().data(), 0xa5, capacity);
+            }
+
+            _first_ptr = _first_ptr != nullptr ? _first_ptr : _buffers.front().data();
+        }
+
+        void when_the_arena_is_reset()
+        {
+            _reset_result = _arena->reset();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_buffers_are_packed_in_one_region(uint64_t capacity)
+        {
+            for (std::size_t i = 1; i < _buffers.size(); ++i)
+            {
+                ASSERT_EQ(_buffers[i - 1].data() + capacity, _buffers[i].data());
+                ASSERT_TRUE(_buffers[i].is_aligned(vfs::buffer_arena::alignment));
+            }
+
+            ASSERT_EQ(1, _arena->stats().regions);
+        }
+
+        void then_the_arena_has(std::size_t regions, uint64_t live)
+        {
+            auto stats = _arena->stats();
+
+            ASSERT_EQ(regions, stats.regions);
+            ASSERT_EQ(live, stats.live);
+        }
+
+        void then_the_reset_is_refused()
+        {
+            ASSERT_EQ(-EBUSY, _reset_result);
+        }
+
+        void then_the_memory_is_reused()
+        {
+            ASSERT_EQ(0, _reset_result);
+
+            when_buffers_are_acquired(1, 64 * 1024);
+
+            ASSERT_EQ(_first_ptr, _buffers.back().data());
+        }
+
+        void then_the_buffers_are_bound()
+        {
+            ASSERT_EQ(0, _arena->stats().bind_failures);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(buffer_arena, it_should_pack_buffers_in_a_region)
+    {
+        test t;
+
+        t.given_an_arena(vfs::buffer_arena_pages::transparent_huge);
+
+        t.when_buffers_are_acquired(8, 64 * 1024);
+
+        t.then_the_buffers_are_packed_in_one_region(64 * 1024);
+        t.then_the_arena_has(1, 8);
+    }
+
+    TEST(buffer_arena, it_should_map_a_region_for_large_buffers)
+    {
+        test t;
+
+        t.given_an_arena(vfs::buffer_arena_pages::normal);
+
+        t.when_buffers_are_acquired(1, 1024);
+        t.when_buffers_are_acquired(1, 8 * 1024 * 1024);
+
+        t.then_the_arena_has(2, 2);
+    }
+
+    TEST(buffer_arena, it_should_fall_back_when_huge_pages_are_not_reserved)
+    {
+        test t;
+
+        t.given_an_arena(vfs::buffer_arena_pages::huge);
+
+        t.when_buffers_are_acquired(2, 1024 * 1024);
+
+        t.then_the_arena_has(1, 2);
+    }
+
+    TEST(buffer_arena, it_should_refuse_a_reset_with_live_buffers)
+    {
+        test t;
+
+        t.given_an_arena(vfs::buffer_arena_pages::normal);
+
+        t.when_buffers_are_acquired(2, 4096);
+        t.when_the_arena_is_reset();
+
+        t.then_the_reset_is_refused();
+    }
+
+    TEST(buffer_arena, it_should_release_buffers_in_bulk)
+    {
+        test t;
+
+        t.given_an_arena(vfs::buffer_arena_pages::normal);
+        t.given_released_buffers();
+
+        t.when_the_arena_is_reset();
+
+        t.then_the_memory_is_reused();
+    }
+
+    TEST(buffer_arena, it_should_bind_regions_to_a_numa_node)
+    {
+        test t;
+
+        t.given_an_arena(vfs::buffer_arena_pages::transparent_huge, 0);
+
+        t.when_buffers_are_acquired(1, 64 * 1024);
+
+        t.then_the_buffers_are_bound();
+    }
+}
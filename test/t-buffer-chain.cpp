@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <vfs/buffer-chain.hpp>
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::buffer_slice _slice;
+        vfs::buffer_slice _sub_slice;
+
+        vfs::buffer_chain _chain;
+        vfs::buffer_chain _head;
+
+        const uint8_t *_first_ptr = nullptr;
+
+        static vfs::buffer make_buffer(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            return buf;
+        }
+
+        static std::string str(const vfs::buffer_slice &slice)
+        {
+            return std::string {slice.begin(), slice.end()};
+        }
+
+        static std::string str(const vfs::buffer_chain &chain)
+        {
+            std::string result;
+
+            for (auto &slice : chain)
+            {
+                result += str(slice);
+            }
+
+            return result;
+        }
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_slice(const std::string &content)
+        {
+            _slice = vfs::buffer_slice {make_buffer(content)};
+        }
+
+        void given_a_chain(std::initializer_list<std::string> parts)
+        {
+            for (auto &part : parts)
+            {
+                _chain.append(make_buffer(part));
+            }
+
+            _first_ptr = _chain[0].data();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_the_slice_is_sliced(uint64_t off, uint64_t len)
+        {
+            _sub_slice = _slice.slice(off, len);
+        }
+
+        void when_the_chain_is_split(uint64_t n)
+        {
+            _head = _chain.split(n);
+        }
+
+        void when_the_chain_is_coalesced()
+        {
+            _chain.coalesce();
+        }
+
+        void when_the_chain_is_truncated(uint64_t n)
+        {
+            _chain.truncate(n);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_sub_slice_shares_the_memory(const std::string &content)
+        {
+            ASSERT_EQ(content, str(_sub_slice));
+            ASSERT_EQ(2, _slice.use_count());
+            ASSERT_GE(_sub_slice.data(), _slice.data());
+            ASSERT_LE(_sub_slice.end(), _slice.end());
+        }
+
+        void then_the_head_is(const std::string &content)
+        {
+            ASSERT_EQ(content, str(_head));
+            ASSERT_EQ(content.size(), _head.size());
+            ASSERT_EQ(_first_ptr, _head[0].data());
+        }
+
+        void then_the_chain_is(const std::string &content, std::size_t count)
+        {
+            ASSERT_EQ(content, str(_chain));
+            ASSERT_EQ(content.size(), _chain.size());
+            ASSERT_EQ(count, _chain.count());
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(buffer_chain, it_should_slice_without_copying)
+    {
+        test t;
+
+        t.given_a_slice("object-header-body");
+
+        t.when_the_slice_is_sliced(7, 6);
+
+        t.then_the_sub_slice_shares_the_memory("header");
+    }
+
+    TEST(buffer_chain, it_should_split_inside_a_slice)
+    {
+        test t;
+
+        t.given_a_chain({"abc", "defg", "hi"});
+
+        t.when_the_chain_is_split(5);
+
+        t.then_the_head_is("abcde");
+        t.then_the_chain_is("fghi", 2);
+    }
+
+    TEST(buffer_chain, it_should_split_on_a_slice_boundary)
+    {
+        test t;
+
+        t.given_a_chain({"abc", "defg", "hi"});
+
+        t.when_the_chain_is_split(3);
+
+        t.then_the_head_is("abc");
+        t.then_the_chain_is("defghi", 2);
+    }
+
+    TEST(buffer_chain, it_should_coalesce_into_a_single_slice)
+    {
+        test t;
+
+        t.given_a_chain({"abc", "defg", "hi"});
+
+        t.when_the_chain_is_coalesced();
+
+        t.then_the_chain_is("abcdefghi", 1);
+    }
+
+    TEST(buffer_chain, it_should_truncate_across_slices)
+    {
+        test t;
+
+        t.given_a_chain({"abc", "defg", "hi"});
+
+        t.when_the_chain_is_truncated(5);
+
+        t.then_the_chain_is("abcde", 2);
+    }
+}
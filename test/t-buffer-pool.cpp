@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <vfs/buffer-pool.hpp>
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::buffer_pool> _pool;
+
+        vfs::buffer _buffer;
+        uint8_t *_released_ptr = nullptr;
+        std::atomic<std::size_t> _released {0};
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_pool()
+        {
+            _pool = std::make_unique<vfs::buffer_pool>();
+        }
+
+        void given_a_pool_with_a_cap(uint64_t cap)
+        {
+            _pool = std::make_unique<vfs::buffer_pool>(cap);
+        }
+
+        void given_a_released_buffer(uint64_t capacity)
+        {
+            auto buf = _pool->acquire(capacity);
+
+            _released_ptr = buf.data();
+        }
+
+        void given_a_buffer_released_on_another_thread(uint64_t capacity)
+        {
+            auto buf = _pool->acquire(capacity);
+
+            _released_ptr = buf.data();
+
+            std::thread {[buf = std::move(buf)]() mutable
+            {
+                buf = vfs::buffer {};
+            }}.join();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_a_buffer_is_acquired(uint64_t capacity)
+        {
+            _buffer = _pool->acquire(capacity);
+        }
+
+        void when_the_pool_is_destroyed()
+        {
+            _pool.reset();
+        }
+
+        void when_the_pool_is_destroyed_while_other_threads_release(uint64_t capacity, std::size_t n)
+        {
+            std::atomic<bool> go {false};
+            std::vector<std::thread> threads;
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                threads.emplace_back([this, &go, buf = _pool->acquire(capacity)]() mutable
+                {
+                    while (!go.load())
+                    {}
+
+                    buf = vfs::buffer {};
+
+                    ++_released;
+                });
+            }
+
+            go = true;
+
+            _pool.reset();
+
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        void when_buffers_are_released(uint64_t capacity, std::size_t n)
+        {
+            std::vector<vfs::buffer> bufs;
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                bufs.emplace_back(_pool->acquire(capacity));
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_buffer_has_the_capacity(uint64_t capacity)
+        {
+            ASSERT_EQ(capacity, _buffer.capacity());
+            ASSERT_EQ(0, _buffer.size());
+        }
+
+        void then_the_buffer_is_usable()
+        {
+            _buffer.put("outlived", 8);
+
+            ASSERT_EQ(8, _buffer.size());
+            ASSERT_EQ(0, std::memcmp("outlived", _buffer.data(), 8));
+        }
+
+        void then_the_buffer_can_be_released()
+        {
+            _buffer = vfs::buffer {};
+
+            ASSERT_EQ(nullptr, _buffer.data());
+        }
+
+        void then_every_buffer_was_released(std::size_t n)
+        {
+            ASSERT_EQ(n, _released.load());
+        }
+
+        void then_the_memory_was_recycled()
+        {
+            ASSERT_EQ(_released_ptr, _buffer.data());
+        }
+
+        void then_the_pool_has_counted(uint64_t hits, uint64_t misses)
+        {
+            auto stats = _pool->stats();
+
+            ASSERT_EQ(hits, stats.hits);
+            ASSERT_EQ(misses, stats.misses);
+        }
+
+        void then_the_pool_has_dropped(uint64_t drops, uint64_t cached_bytes)
+        {
+            auto stats = _pool->stats();
+
+            ASSERT_EQ(drops, stats.drops);
+            ASSERT_EQ(cached_bytes, stats.cached_bytes);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(buffer_pool, it_should_hand_out_buffers_of_the_requested_capacity)
+    {
+        test t;
+
+        t.given_a_pool();
+
+        t.when_a_buffer_is_acquired(100 * 1024);
+
+        t.then_the_buffer_has_the_capacity(100 * 1024);
+        t.then_the_pool_has_counted(0, 1);
+    }
+
+    TEST(buffer_pool, it_should_recycle_released_buffers_of_the_same_class)
+    {
+        test t;
+
+        t.given_a_pool();
+        t.given_a_released_buffer(64 * 1024);
+
+        t.when_a_buffer_is_acquired(60 * 1024);
+
+        t.then_the_buffer_has_the_capacity(60 * 1024);
+        t.then_the_memory_was_recycled();
+        t.then_the_pool_has_counted(1, 1);
+    }
+
+    TEST(buffer_pool, it_should_recycle_buffers_released_on_another_thread)
+    {
+        test t;
+
+        t.given_a_pool();
+        t.given_a_buffer_released_on_another_thread(1024 * 1024);
+
+        t.when_a_buffer_is_acquired(1024 * 1024);
+
+        t.then_the_memory_was_recycled();
+        t.then_the_pool_has_counted(1, 1);
+    }
+
+    TEST(buffer_pool, it_should_drop_buffers_above_the_cap)
+    {
+        test t;
+
+        t.given_a_pool_with_a_cap(16 * 1024);
+
+        t.when_buffers_are_released(8 * 1024, 3);
+
+        t.then_the_pool_has_dropped(1, 16 * 1024);
+    }
+
+    TEST(buffer_pool, it_should_not_pool_oversized_buffers)
+    {
+        test t;
+
+        t.given_a_pool();
+        t.given_a_released_buffer(vfs::buffer_pool::max_class_size + 1);
+
+        t.when_a_buffer_is_acquired(vfs::buffer_pool::max_class_size + 1);
+
+        t.then_the_pool_has_counted(0, 2);
+        t.then_the_pool_has_dropped(1, 0);
+    }
+
+    TEST(buffer_pool, it_should_free_buffers_that_outlive_the_pool)
+    {
+        test t;
+
+        t.given_a_pool();
+
+        t.when_a_buffer_is_acquired(64 * 1024);
+        t.when_the_pool_is_destroyed();
+
+        t.then_the_buffer_is_usable();
+        t.then_the_buffer_can_be_released();
+    }
+
+    TEST(buffer_pool, it_should_let_other_threads_release_while_the_pool_is_destroyed)
+    {
+        test t;
+
+        t.given_a_pool();
+
+        t.when_the_pool_is_destroyed_while_other_threads_release(64 * 1024, 8);
+
+        t.then_every_buffer_was_released(8);
+    }
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <vfs/callback.hpp>
+#include <vfs/filesystem.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+
+namespace
+{
+    using read_cb = vfs::uv::uv_filesystem::read_cb;
+    using exists_cb = vfs::uv::uv_filesystem::exists_cb;
+
+    struct handler
+    {
+        int calls;
+    };
+
+    // <editor-fold name="Compile time">
+
+    inline void typical_lambdas_fit_inline(handler *h, std::shared_ptr<handler> sh, std::string *s)
+    {
+        auto this_capture = [h](vfs::any_path &, int, bool)
+        {
+            ++h->calls;
+        };
+
+        auto ref_capture = [h, &sh, s](vfs::any_path &, int, bool)
+        {
+            h->calls += sh->calls + static_cast<int>(s->size());
+        };
+
+        auto shared_capture = [h, sh](vfs::uv::_uv_file_t &, int, vfs::buffer &)
+        {
+            h->calls += sh->calls;
+        };
+
+        static_assert(vfs::fits_inline_callback<exists_cb, decltype(this_capture)>::value, "");
+        static_assert(vfs::fits_inline_callback<exists_cb, decltype(ref_capture)>::value, "");
+        static_assert(vfs::fits_inline_callback<read_cb, decltype(shared_capture)>::value, "");
+    }
+
+    // </editor-fold>
+
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        using int_cb = vfs::callback<int(int)>;
+
+        handler _handler;
+        std::shared_ptr<handler> _shared_handler;
+
+        int_cb _callback;
+        int_cb _other_callback;
+
+        int _int_result;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_callback_with_a_small_capture()
+        {
+            _handler = {.calls = 0};
+
+            auto h = &_handler;
+
+            _callback = [h](int v)
+            {
+                ++h->calls;
+                return v + 1;
+            };
+        }
+
+        void given_a_callback_with_a_large_capture()
+        {
+            _handler = {.calls = 0};
+
+            std::array<int, 64> values {};
+            values.fill(1);
+
+            auto h = &_handler;
+
+            _callback = [h, values](int v)
+            {
+                ++h->calls;
+                return v + values[63];
+            };
+        }
+
+        void given_a_callback_with_a_move_only_capture()
+        {
+            auto ptr = std::make_unique<int>(41);
+
+            _callback = [ptr = std::move(ptr)](int v)
+            {
+                return v + *ptr;
+            };
+        }
+
+        void given_a_callback_with_a_shared_capture()
+        {
+            _shared_handler = std::make_shared<handler>();
+
+            auto sh = _shared_handler;
+
+            _callback = [sh](int v)
+            {
+                return v;
+            };
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_the_callback_is_invoked()
+        {
+            _int_result = _callback(1);
+        }
+
+        void when_the_callback_is_moved()
+        {
+            _other_callback = std::move(_callback);
+        }
+
+        void when_the_other_callback_is_invoked()
+        {
+            _int_result = _other_callback(1);
+        }
+
+        void when_the_callbacks_are_destroyed()
+        {
+            _callback = nullptr;
+            _other_callback = nullptr;
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_result_is(int expected)
+        {
+            ASSERT_EQ(expected, _int_result);
+        }
+
+        void then_the_handler_was_called()
+        {
+            ASSERT_EQ(1, _handler.calls);
+        }
+
+        void then_the_callback_is_inline()
+        {
+            ASSERT_TRUE(_callback.is_inline());
+        }
+
+        void then_the_callback_is_not_inline()
+        {
+            ASSERT_FALSE(_callback.is_inline());
+        }
+
+        void then_the_callback_is_empty()
+        {
+            ASSERT_FALSE(static_cast<bool>(_callback));
+        }
+
+        void then_the_shared_capture_is_released()
+        {
+            ASSERT_EQ(1, _shared_handler.use_count());
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(callback, it_should_store_small_captures_inline)
+    {
+        test t;
+
+        t.given_a_callback_with_a_small_capture();
+
+        t.when_the_callback_is_invoked();
+
+        t.then_the_callback_is_inline();
+        t.then_the_result_is(2);
+        t.then_the_handler_was_called();
+    }
+
+    TEST(callback, it_should_store_large_captures_on_the_heap)
+    {
+        test t;
+
+        t.given_a_callback_with_a_large_capture();
+
+        t.when_the_callback_is_invoked();
+
+        t.then_the_callback_is_not_inline();
+        t.then_the_result_is(2);
+        t.then_the_handler_was_called();
+    }
+
+    TEST(callback, it_should_accept_move_only_captures)
+    {
+        test t;
+
+        t.given_a_callback_with_a_move_only_capture();
+
+        t.when_the_callback_is_moved();
+        t.when_the_other_callback_is_invoked();
+
+        t.then_the_callback_is_empty();
+        t.then_the_result_is(42);
+    }
+
+    TEST(callback, it_should_move_large_captures)
+    {
+        test t;
+
+        t.given_a_callback_with_a_large_capture();
+
+        t.when_the_callback_is_moved();
+        t.when_the_other_callback_is_invoked();
+
+        t.then_the_callback_is_empty();
+        t.then_the_result_is(2);
+    }
+
+    TEST(callback, it_should_destroy_captures)
+    {
+        test t;
+
+        t.given_a_callback_with_a_shared_capture();
+
+        t.when_the_callback_is_moved();
+        t.when_the_callbacks_are_destroyed();
+
+        t.then_the_shared_capture_is_released();
+    }
+}
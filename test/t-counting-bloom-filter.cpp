@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <vfs/counting-bloom-filter.hpp>
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::counting_bloom_filter _filter {vfs::counting_bloom_filter::for_capacity(1000, 0.01)};
+        std::vector<std::string> _keys;
+
+        // </editor-fold>
+
+        static std::string key_of(std::size_t i)
+        {
+            return "/data/vfs/bucket/object-" + std::to_string(i);
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_inserted_keys(std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                _keys.push_back(key_of(i));
+                _filter.insert(_keys.back());
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_keys_are_erased(std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                _filter.erase(_keys[i]);
+            }
+
+            _keys.erase(_keys.begin(), _keys.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_every_remaining_key_may_be_contained()
+        {
+            for (auto &key : _keys)
+            {
+                ASSERT_TRUE(_filter.may_contain(key)) << key;
+            }
+        }
+
+        void then_the_false_positive_rate_is_below(double rate)
+        {
+            std::size_t positives = 0;
+            std::size_t probes = 10000;
+
+            for (std::size_t i = 0; i < probes; ++i)
+            {
+                positives += _filter.may_contain(key_of(1000000 + i)) ? 1 : 0;
+            }
+
+            ASSERT_LT(static_cast<double>(positives) / static_cast<double>(probes), rate);
+        }
+
+        void then_the_key_is_absent(std::size_t i)
+        {
+            ASSERT_FALSE(_filter.may_contain(key_of(i)));
+        }
+
+        void then_the_filter_is_sized(std::size_t counters, unsigned hashes)
+        {
+            ASSERT_EQ(counters, _filter.counters());
+            ASSERT_EQ(hashes, _filter.hashes());
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(counting_bloom_filter, it_should_size_itself_for_a_false_positive_rate)
+    {
+        test t;
+
+        t.then_the_filter_is_sized(9586, 7);
+    }
+
+    TEST(counting_bloom_filter, it_should_never_report_false_negatives)
+    {
+        test t;
+
+        t.given_inserted_keys(1000);
+
+        t.then_every_remaining_key_may_be_contained();
+        t.then_the_false_positive_rate_is_below(0.03);
+    }
+
+    TEST(counting_bloom_filter, it_should_forget_erased_keys)
+    {
+        test t;
+
+        t.given_inserted_keys(1);
+
+        t.when_keys_are_erased(1);
+
+        t.then_the_key_is_absent(0);
+    }
+
+    TEST(counting_bloom_filter, it_should_keep_other_keys_after_erasing)
+    {
+        test t;
+
+        t.given_inserted_keys(1000);
+
+        t.when_keys_are_erased(500);
+
+        t.then_every_remaining_key_may_be_contained();
+        t.then_the_false_positive_rate_is_below(0.02);
+    }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <vfs/crc32c.hpp>
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::vector<uint8_t> _data;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_data(const std::string &content)
+        {
+            _data.assign(content.begin(), content.end());
+        }
+
+        void given_random_data(std::size_t size)
+        {
+            _data.resize(size);
+
+            uint32_t seed = 0x9e3779b9u;
+
+            for (auto &b : _data)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                b = static_cast<uint8_t>(seed >> 24);
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_checksum_is(uint32_t expected)
+        {
+            ASSERT_EQ(expected, vfs::crc32c_sw(_data.data(), _data.size()));
+            ASSERT_EQ(expected, vfs::crc32c_hw(_data.data(), _data.size()));
+            ASSERT_EQ(expected, vfs::crc32c(_data.data(), _data.size()));
+        }
+
+        void then_both_implementations_agree_on_every_prefix()
+        {
+            for (std::size_t len = 0; len <= _data.size(); len += 7)
+            {
+                ASSERT_EQ(vfs::crc32c_sw(_data.data(), len), vfs::crc32c_hw(_data.data(), len));
+            }
+        }
+
+        void then_the_checksum_can_be_chained(std::size_t split)
+        {
+            auto head = vfs::crc32c(_data.data(), split);
+            auto chained = vfs::crc32c(_data.data() + split, _data.size() - split, head);
+
+            ASSERT_EQ(vfs::crc32c(_data.data(), _data.size()), chained);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(crc32c, it_should_match_the_check_value)
+    {
+        test t;
+
+        t.given_data("123456789");
+
+        t.then_the_checksum_is(0xe3069283u);
+    }
+
+    TEST(crc32c, it_should_agree_between_implementations)
+    {
+        test t;
+
+        t.given_random_data(4099);
+
+        t.then_both_implementations_agree_on_every_prefix();
+    }
+
+    TEST(crc32c, it_should_chain_partial_checksums)
+    {
+        test t;
+
+        t.given_random_data(10000);
+
+        t.then_the_checksum_can_be_chained(3333);
+    }
+}
@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <vfs/path-normalize.hpp>
+#include <vfs/unix/unix-path.hpp>
+#include <vfs/unix/unix-small-path.hpp>
+
+namespace
+{
+    std::string reference_normalize(const std::string &value)
+    {
+        if (value.empty())
+        {
+            return value;
+        }
+
+        bool absolute = value.front() == '/';
+        std::vector<std::string> components;
+        std::size_t i = 0;
+
+        while (i < value.size())
+        {
+            auto e = value.find('/', i);
+
+            if (e == std::string::npos)
+            {
+                e = value.size();
+            }
+
+            auto component = value.substr(i, e - i);
+
+            if (component == "..")
+            {
+                if (!components.empty() && components.back() != "..")
+                {
+                    components.pop_back();
+                }
+                else if (!absolute)
+                {
+                    components.push_back(component);
+                }
+            }
+            else if (!component.empty() && component != ".")
+            {
+                components.push_back(component);
+            }
+
+            i = e + 1;
+        }
+
+        std::string result = absolute ? "/" : "";
+
+        for (std::size_t k = 0; k < components.size(); ++k)
+        {
+            result += (k > 0 ? "/" : "") + components[k];
+        }
+
+        return result.empty() ? "." : result;
+    }
+
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::string _value;
+        std::vector<std::string> _values;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_path(const std::string &value)
+        {
+            _value = value;
+        }
+
+        void given_random_paths(std::size_t count, std::size_t max_size)
+        {
+            static const char alphabet[] = {'a', 'b', '.', '.', '/', '/'};
+
+            uint32_t seed = 0x9e3779b9u;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                seed = seed * 1664525u + 1013904223u;
+
+                std::string value(1 + (seed >> 8) % max_size, '\0');
+
+                for (auto &c : value)
+                {
+                    seed = seed * 1664525u + 1013904223u;
+                    c = alphabet[(seed >> 24) % sizeof(alphabet)];
+                }
+
+                _values.push_back(value);
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_normalized_path_is(const std::string &expected)
+        {
+            vfs::unix_path path {std::string {_value}};
+            vfs::unix_small_path small_path {_value};
+
+            ASSERT_EQ(expected, path.normalize().str());
+            ASSERT_EQ(expected, small_path.normalize().view());
+            ASSERT_EQ(expected, reference_normalize(_value));
+        }
+
+        void then_the_path_validates_to(int expected)
+        {
+            ASSERT_EQ(expected, vfs::validate_path(_value));
+        }
+
+        void then_every_path_matches_the_reference()
+        {
+            for (auto &value : _values)
+            {
+                auto copy = value;
+
+                copy.resize(vfs::normalize_path(&copy[0], copy.size()));
+
+                ASSERT_EQ(reference_normalize(value), copy) << value;
+            }
+        }
+
+        void then_every_scan_agrees_with_the_scalar_scan()
+        {
+            for (auto &value : _values)
+            {
+                auto simd = vfs::path_scan(value);
+                auto sw = vfs::path_scan_sw(value);
+
+                ASSERT_EQ(sw.restart, simd.restart) << value;
+                ASSERT_EQ(sw.longest, simd.longest) << value;
+                ASSERT_EQ(sw.has_nul, simd.has_nul) << value;
+            }
+        }
+
+        void then_the_small_path_has_components(std::size_t expected)
+        {
+            vfs::unix_small_path small_path {_value};
+
+            ASSERT_EQ(expected, small_path.normalize().components());
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    // <editor-fold name="Normalize">
+
+    TEST(path_normalize, it_should_keep_a_canonical_path)
+    {
+        test t;
+
+        t.given_a_path("/data/vfs/bucket/object");
+
+        t.then_the_normalized_path_is("/data/vfs/bucket/object");
+    }
+
+    TEST(path_normalize, it_should_collapse_separators_and_drop_trailing_separators)
+    {
+        test t;
+
+        t.given_a_path("//data///vfs//bucket/");
+
+        t.then_the_normalized_path_is("/data/vfs/bucket");
+    }
+
+    TEST(path_normalize, it_should_resolve_dot_components)
+    {
+        test t;
+
+        t.given_a_path("/data/./vfs/../objects/./.hidden/..");
+
+        t.then_the_normalized_path_is("/data/objects");
+    }
+
+    TEST(path_normalize, it_should_not_escape_the_root)
+    {
+        test t;
+
+        t.given_a_path("/../../data/..");
+
+        t.then_the_normalized_path_is("/");
+    }
+
+    TEST(path_normalize, it_should_keep_leading_parents_of_relative_paths)
+    {
+        test t;
+
+        t.given_a_path("./a/../../b/./../..");
+
+        t.then_the_normalized_path_is("../..");
+    }
+
+    TEST(path_normalize, it_should_return_the_current_directory_for_an_empty_relative_path)
+    {
+        test t;
+
+        t.given_a_path("a/b/../..//");
+
+        t.then_the_normalized_path_is(".");
+    }
+
+    TEST(path_normalize, it_should_detect_separators_across_blocks)
+    {
+        test t;
+
+        t.given_a_path("/" + std::string(62, 'a') + "//" + std::string(70, 'b') + "/./c");
+
+        t.then_the_normalized_path_is("/" + std::string(62, 'a') + "/" + std::string(70, 'b') + "/c");
+    }
+
+    TEST(path_normalize, it_should_reindex_a_small_path)
+    {
+        test t;
+
+        t.given_a_path("/data//vfs/./bucket/../object");
+
+        t.then_the_small_path_has_components(3);
+    }
+
+    TEST(path_normalize, it_should_match_the_reference_implementation)
+    {
+        test t;
+
+        t.given_random_paths(2000, 200);
+
+        t.then_every_path_matches_the_reference();
+        t.then_every_scan_agrees_with_the_scalar_scan();
+    }
+
+    // </editor-fold>
+
+    // <editor-fold name="Validate">
+
+    TEST(path_validate, it_should_accept_a_path)
+    {
+        test t;
+
+        t.given_a_path("/data/vfs/bucket/object");
+
+        t.then_the_path_validates_to(0);
+    }
+
+    TEST(path_validate, it_should_reject_an_empty_path)
+    {
+        test t;
+
+        t.given_a_path("");
+
+        t.then_the_path_validates_to(-EINVAL);
+    }
+
+    TEST(path_validate, it_should_reject_a_nul_byte)
+    {
+        test t;
+
+        t.given_a_path(std::string("/data/vfs") + '\0' + "/object");
+
+        t.then_the_path_validates_to(-EINVAL);
+    }
+
+    TEST(path_validate, it_should_reject_a_long_component)
+    {
+        test t;
+
+        t.given_a_path("/data/" + std::string(256, 'a') + "/object");
+
+        t.then_the_path_validates_to(-ENAMETOOLONG);
+    }
+
+    TEST(path_validate, it_should_reject_a_long_path)
+    {
+        test t;
+
+        std::string value;
+
+        for (int i = 0; i < 64; ++i)
+        {
+            value += "/" + std::string(64, 'a');
+        }
+
+        t.given_a_path(value);
+
+        t.then_the_path_validates_to(-ENAMETOOLONG);
+    }
+
+    // </editor-fold>
+}
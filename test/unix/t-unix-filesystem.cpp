@@ -0,0 +1,508 @@
+#include <gtest/gtest.h>
+
+#include <vfs/unix/unix-filesystem.hpp>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "../uv/t-uv-filesystem-base.hpp"
+
+namespace
+{
+    using batch_result = vfs::unix_filesystem::batch_type::result_type;
+
+    class t_unix :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::unix_filesystem _unix_fs;
+
+        bool _exists_result;
+        vfs::unix_stat _stat_result;
+        std::string _read_result;
+        uint64_t _write_result;
+        int _close_error_result;
+        bool _called;
+        std::size_t _batch_size;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_existing_file_with_content()
+        {
+            given_an_existing_file();
+
+            write_file(_path, "unix-data");
+        }
+
+        void given_a_nested_unexisting_path()
+        {
+            _path.clear()
+                .append(_mount.path())
+                .append("a")
+                .append("b")
+                .append("c");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_exists_is_invoked()
+        {
+            _called = false;
+
+            _result = _unix_fs.exists(_path, [this](vfs::any_path &, int err, bool exists)
+            {
+                _called = true;
+                _error_result = err;
+                _exists_result = exists;
+            });
+        }
+
+        void when_stat_is_invoked()
+        {
+            _result = _unix_fs.stat(_path, [this](vfs::any_path &, int err, vfs::unix_stat stat)
+            {
+                _error_result = err;
+                _stat_result = stat;
+            });
+        }
+
+        void when_mkdirs_is_invoked()
+        {
+            _result = _unix_fs.mkdirs(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+        }
+
+        void when_create_is_invoked()
+        {
+            _result = _unix_fs.create(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+        }
+
+        void when_move_is_invoked()
+        {
+            _result = _unix_fs.move(_path, _other_path, [this](vfs::any_path &, vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+        }
+
+        void when_copy_is_invoked()
+        {
+            _result = _unix_fs.copy(_path, _other_path, [this](vfs::any_path &, vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+        }
+
+        void when_copy_onto_itself_is_invoked()
+        {
+            _result = _unix_fs.copy(_path, _path, [this](vfs::any_path &, vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+        }
+
+        void when_the_file_is_opened_read_and_closed()
+        {
+            _result = _unix_fs.open(_path, O_RDONLY, [this](vfs::any_path &, int err, vfs::_unix_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                _unix_fs.read(file, vfs::buffer {64}, 0, [this](vfs::_unix_file_t &file, int err, vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+
+                    _unix_fs.close(file, [this](vfs::_unix_file_t &, int err)
+                    {
+                        _close_error_result = err;
+                    });
+                });
+            });
+        }
+
+        void when_the_file_is_mapped()
+        {
+            _result = _unix_fs.open(_path, O_RDONLY, [this](vfs::any_path &, int err, vfs::_unix_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                _unix_fs.map(file, 0, 0, vfs::map_populate, [this](vfs::_unix_file_t &file, int err,
+                                                                   vfs::mapped_slice &view)
+                {
+                    _error_result = err;
+                    _read_result = std::string {view.begin(), view.end()};
+
+                    _unix_fs.close(file, [this](vfs::_unix_file_t &, int err)
+                    {
+                        _close_error_result = err;
+                    });
+                });
+            });
+        }
+
+        void when_the_file_is_opened_written_with_buffers_and_closed()
+        {
+            _result = _unix_fs.open(_path, O_WRONLY, [this](vfs::any_path &, int err, vfs::_unix_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                std::vector<vfs::buffer> bufs;
+
+                bufs.emplace_back(16);
+                bufs.emplace_back(16);
+
+                bufs[0].put("unix-", 5);
+                bufs[1].put("writev", 6);
+
+                _unix_fs.writev(file, std::move(bufs), 0, [this](vfs::_unix_file_t &file, int err,
+                                                                 std::vector<vfs::buffer> &bufs)
+                {
+                    _error_result = err;
+                    _write_result = bufs[0].size() + bufs[1].size();
+
+                    _unix_fs.close(file, [this](vfs::_unix_file_t &, int err)
+                    {
+                        _close_error_result = err;
+                    });
+                });
+            });
+        }
+
+        void when_the_mount_dir_is_read()
+        {
+            vfs::unix_path dir;
+
+            dir.append(_mount.path());
+
+            _called = false;
+
+            _result = _unix_fs.readdir(vfs::any_path {dir}, 1, [this](vfs::any_path &, int err,
+                                                                      vfs::dir_batch &batch)
+            {
+                _error_result = err;
+                _called = batch.eof();
+
+                for (auto &entry : batch)
+                {
+                    _read_result.append(entry.name);
+                    _exists_result = entry.is_file();
+                }
+
+                return true;
+            });
+        }
+
+        void when_a_large_batch_is_submitted()
+        {
+            auto batch = _unix_fs.batch(1);
+
+            for (auto i = 0; i < 4096; ++i)
+            {
+                batch.exists(_path);
+            }
+
+            _called = false;
+
+            _result = batch.submit([this](int err, std::vector<batch_result> &results)
+            {
+                _called = true;
+                _error_result = err;
+                _batch_size = results.size();
+                _exists_result = results.back().exists();
+            });
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_callback_was_invoked_inline()
+        {
+            ASSERT_TRUE(_called);
+        }
+
+        void then_every_batch_entry_has_completed()
+        {
+            ASSERT_EQ(4096, _batch_size);
+        }
+
+        void then_the_dir_has_been_listed()
+        {
+            ASSERT_EQ("existing", _read_result);
+        }
+
+        void then_exist_result_is_true()
+        {
+            ASSERT_TRUE(_exists_result);
+        }
+
+        void then_exist_result_is_false()
+        {
+            ASSERT_FALSE(_exists_result);
+        }
+
+        void then_stat_result_is_a_file()
+        {
+            ASSERT_TRUE(_stat_result.inode() > 0);
+            ASSERT_TRUE(_stat_result.is_file());
+            ASSERT_EQ(9, _stat_result.size());
+        }
+
+        void then_path_is_a_dir()
+        {
+            struct stat64 stat;
+
+            ASSERT_EQ(0, stat64(_path.str().c_str(), &stat));
+            ASSERT_TRUE(S_ISDIR(stat.st_mode));
+        }
+
+        void then_path_does_not_exist()
+        {
+            struct stat64 stat;
+
+            ASSERT_NE(0, stat64(_path.str().c_str(), &stat));
+        }
+
+        void then_other_path_has_the_content()
+        {
+            ASSERT_EQ("unix-data", read_file(_other_path));
+        }
+
+        void then_path_still_has_the_content()
+        {
+            ASSERT_EQ("unix-data", read_file(_path));
+        }
+
+        void then_the_content_has_been_read()
+        {
+            ASSERT_EQ("unix-data", _read_result);
+            ASSERT_EQ(0, _close_error_result);
+        }
+
+        void then_the_content_has_been_written()
+        {
+            ASSERT_EQ(11, _write_result);
+            ASSERT_EQ(0, _close_error_result);
+            ASSERT_EQ("unix-writev", read_file(_path));
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(unix_filesystem, it_should_return_true_when_file_exists)
+    {
+        t_unix t;
+
+        t.given_an_existing_path();
+
+        t.when_exists_is_invoked();
+
+        t.then_the_callback_was_invoked_inline();
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_exist_result_is_true();
+    }
+
+    TEST(unix_filesystem, it_should_return_false_when_file_does_not_exist)
+    {
+        t_unix t;
+
+        t.given_an_unexisting_path();
+
+        t.when_exists_is_invoked();
+
+        t.then_the_callback_was_invoked_inline();
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_exist_result_is_false();
+    }
+
+    TEST(unix_filesystem, it_should_return_stat_struct_when_file_exists)
+    {
+        t_unix t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_stat_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_stat_result_is_a_file();
+    }
+
+    TEST(unix_filesystem, it_should_create_intermediate_directories)
+    {
+        t_unix t;
+
+        t.given_a_nested_unexisting_path();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_dir();
+    }
+
+    TEST(unix_filesystem, it_should_succeed_when_directories_already_exist)
+    {
+        t_unix t;
+
+        t.given_an_existing_dir();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_dir();
+    }
+
+    TEST(unix_filesystem, it_should_return_eexist_when_created_file_exists)
+    {
+        t_unix t;
+
+        t.given_an_existing_file();
+
+        t.when_create_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_eexist();
+    }
+
+    TEST(unix_filesystem, it_should_move_file_when_file_exists)
+    {
+        t_unix t;
+
+        t.given_an_existing_file();
+        t.given_an_unexisting_other_path();
+
+        t.when_move_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_does_not_exist();
+    }
+
+    TEST(unix_filesystem, it_should_copy_file_content)
+    {
+        t_unix t;
+
+        t.given_an_existing_file_with_content();
+        t.given_an_unexisting_other_path();
+
+        t.when_copy_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_other_path_has_the_content();
+    }
+
+    TEST(unix_filesystem, it_should_leave_a_file_copied_onto_itself_intact)
+    {
+        t_unix t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_copy_onto_itself_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_still_has_the_content();
+    }
+
+    TEST(unix_filesystem, it_should_read_file_content)
+    {
+        t_unix t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_the_file_is_opened_read_and_closed();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_read();
+    }
+
+    TEST(unix_filesystem, it_should_map_file_content)
+    {
+        t_unix t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_the_file_is_mapped();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_read();
+    }
+
+    TEST(unix_filesystem, it_should_write_file_content_from_buffers)
+    {
+        t_unix t;
+
+        t.given_an_existing_file();
+
+        t.when_the_file_is_opened_written_with_buffers_and_closed();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_written();
+    }
+
+    TEST(unix_filesystem, it_should_complete_a_large_batch_inline)
+    {
+        t_unix t;
+
+        t.given_an_existing_path();
+
+        t.when_a_large_batch_is_submitted();
+
+        t.then_the_callback_was_invoked_inline();
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_every_batch_entry_has_completed();
+        t.then_exist_result_is_true();
+    }
+
+    TEST(unix_filesystem, it_should_list_a_dir_inline)
+    {
+        t_unix t;
+
+        t.given_an_existing_file();
+
+        t.when_the_mount_dir_is_read();
+
+        t.then_the_callback_was_invoked_inline();
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_dir_has_been_listed();
+        t.then_exist_result_is_true();
+    }
+}
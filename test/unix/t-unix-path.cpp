@@ -87,6 +87,11 @@ namespace
             _other_path = vfs::unix_path {_other_value};
         }
 
+        void given_a_long_relative_path_value()
+        {
+            _value = std::string(64, 'a');
+        }
+
         // </editor-fold>
 
         // <editor-fold name="When">
@@ -124,6 +129,18 @@ namespace
             _bool_result = _path.is_valid();
         }
 
+        void when_the_path_is_appended_to_itself()
+        {
+            _path_ptr_result = &(_path.append(_path));
+            _path_result = *_path_ptr_result;
+        }
+
+        void when_the_path_is_prepended_to_itself()
+        {
+            _path_ptr_result = &(_path.prepend(_path));
+            _path_result = *_path_ptr_result;
+        }
+
         // </editor-fold>
 
         // <editor-fold name="Then">
@@ -202,6 +219,11 @@ namespace
             ASSERT_EQ(expected, _path_result.str());
         }
 
+        void then_the_returned_path_is_the_value_twice()
+        {
+            ASSERT_EQ(_value + "/" + _value, _path_result.str());
+        }
+
         // </editor-fold>
     };
 
@@ -399,6 +421,19 @@ namespace
         t.then_the_returned_path_has_appended_the_value_and_the_other_value_with_a_sep();
     }
 
+    TEST(unix_path_append, it_should_append_the_path_to_itself)
+    {
+        test t;
+
+        t.given_a_long_relative_path_value();
+        t.given_a_path();
+
+        t.when_the_path_is_appended_to_itself();
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_returned_path_is_the_value_twice();
+    }
+
     // </editor-fold>
 
     // <editor-fold name="Prepend">
@@ -451,6 +486,19 @@ namespace
         t.then_the_returned_path_has_prepended_the_value_and_the_other_value_with_a_sep();
     }
 
+    TEST(unix_path_prepend, it_should_prepend_the_path_to_itself)
+    {
+        test t;
+
+        t.given_a_long_relative_path_value();
+        t.given_a_path();
+
+        t.when_the_path_is_prepended_to_itself();
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_returned_path_is_the_value_twice();
+    }
+
     // </editor-fold>
 
     // <editor-fold name="Parent">
@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <vfs/unix/unix-small-path.hpp>
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::unix_small_path _path;
+        vfs::unix_small_path *_path_ptr_result = nullptr;
+        std::string _original;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_path(std::string_view value)
+        {
+            _path = vfs::unix_small_path {value};
+        }
+
+        void given_a_long_path()
+        {
+            _path = vfs::unix_small_path {"/data"};
+
+            for (int i = 0; i < 40; ++i)
+            {
+                _path.append("component-" + std::to_string(i));
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_an_object_key_is_appended()
+        {
+            std::string_view bucket {"bucket"};
+
+            _path_ptr_result = &(_path.append(bucket)
+                .append("2f")
+                .append("a3")
+                .append("object-0001")
+                .append("data"));
+        }
+
+        void when_a_value_is_appended(std::string_view value)
+        {
+            _path_ptr_result = &(_path.append(value));
+        }
+
+        void when_a_value_is_prepended(std::string_view value)
+        {
+            _path_ptr_result = &(_path.prepend(value));
+        }
+
+        void when_its_own_view_is_appended()
+        {
+            _original = std::string {_path.view()};
+            _path_ptr_result = &(_path.append(_path.view()));
+        }
+
+        void when_its_own_view_is_prepended()
+        {
+            _original = std::string {_path.view()};
+            _path_ptr_result = &(_path.prepend(_path.view()));
+        }
+
+        void when_parent_is_invoked(int times)
+        {
+            for (int i = 0; i < times; ++i)
+            {
+                _path_ptr_result = &(_path.parent());
+            }
+        }
+
+        void when_filename_is_invoked()
+        {
+            _path_ptr_result = &(_path.filename());
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_returned_path_is_the_path()
+        {
+            ASSERT_EQ(&_path, _path_ptr_result);
+        }
+
+        void then_the_path_is(std::string_view expected)
+        {
+            ASSERT_EQ(expected, _path.view());
+            ASSERT_EQ(expected, _path.str());
+            ASSERT_EQ(expected.size(), std::strlen(_path.c_str()));
+        }
+
+        void then_the_path_is_the_original_twice()
+        {
+            then_the_path_is(_original + (_original.front() == '/' ? "" : "/") + _original);
+        }
+
+        void then_the_path_has_components(std::size_t expected)
+        {
+            ASSERT_EQ(expected, _path.components());
+        }
+
+        void then_the_path_is_inline()
+        {
+            ASSERT_TRUE(_path.is_inline());
+        }
+
+        void then_the_path_is_not_inline()
+        {
+            ASSERT_FALSE(_path.is_inline());
+        }
+
+        // </editor-fold>
+    };
+
+    // <editor-fold name="Append">
+
+    TEST(unix_small_path_append, it_should_build_an_object_key_inline)
+    {
+        test t;
+
+        t.given_a_path("/data/vfs");
+
+        t.when_an_object_key_is_appended();
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_path_is("/data/vfs/bucket/2f/a3/object-0001/data");
+        t.then_the_path_has_components(7);
+        t.then_the_path_is_inline();
+    }
+
+    TEST(unix_small_path_append, it_should_trim_value_if_value_ends_with_separator_and_other_value_is_absolute)
+    {
+        test t;
+
+        t.given_a_path("/data/vfs/");
+
+        t.when_a_value_is_appended("/objects");
+
+        t.then_the_path_is("/data/vfs/objects");
+        t.then_the_path_has_components(3);
+    }
+
+    TEST(unix_small_path_append, it_should_spill_to_the_heap_for_long_paths)
+    {
+        test t;
+
+        t.given_a_long_path();
+
+        t.when_parent_is_invoked(39);
+
+        t.then_the_path_is_not_inline();
+        t.then_the_path_is("/data/component-0");
+        t.then_the_path_has_components(2);
+    }
+
+    TEST(unix_small_path_append, it_should_append_its_own_view_while_spilling_to_the_heap)
+    {
+        test t;
+
+        t.given_a_path("bucket/object-with-a-long-name-that-fills-the-inline-storage-"
+                       "0123456789012345678901234567890123456789012345678901234567890123456789");
+
+        t.when_its_own_view_is_appended();
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_path_is_the_original_twice();
+    }
+
+    // </editor-fold>
+
+    // <editor-fold name="Prepend">
+
+    TEST(unix_small_path_prepend, it_should_add_a_separator_if_other_value_does_not_end_with_separator)
+    {
+        test t;
+
+        t.given_a_path("bucket/object");
+
+        t.when_a_value_is_prepended("/data");
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_path_is("/data/bucket/object");
+        t.then_the_path_has_components(3);
+    }
+
+    TEST(unix_small_path_prepend, it_should_prepend_its_own_view)
+    {
+        test t;
+
+        t.given_a_path("bucket/object");
+
+        t.when_its_own_view_is_prepended();
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_path_is("bucket/object/bucket/object");
+        t.then_the_path_has_components(4);
+    }
+
+    // </editor-fold>
+
+    // <editor-fold name="Parent">
+
+    TEST(unix_small_path_parent, it_should_return_the_parent_path_from_the_offset_table)
+    {
+        test t;
+
+        t.given_a_path("/data/vfs/bucket/object");
+
+        t.when_parent_is_invoked(2);
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_path_is("/data/vfs");
+        t.then_the_path_has_components(2);
+    }
+
+    TEST(unix_small_path_parent, it_should_return_the_root_path_if_the_path_is_the_root)
+    {
+        test t;
+
+        t.given_a_path("/");
+
+        t.when_parent_is_invoked(1);
+
+        t.then_the_path_is("/");
+    }
+
+    // </editor-fold>
+
+    // <editor-fold name="Filename">
+
+    TEST(unix_small_path_filename, it_should_keep_the_last_component)
+    {
+        test t;
+
+        t.given_a_path("/data/vfs/object/");
+
+        t.when_filename_is_invoked();
+
+        t.then_the_returned_path_is_the_path();
+        t.then_the_path_is("/object");
+        t.then_the_path_has_components(1);
+    }
+
+    // </editor-fold>
+}
@@ -0,0 +1,415 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <vfs/uring/uring-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "../uv/t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_uring :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::uring::uring_filesystem> _uring_fs;
+
+        vfs::uv::_uv_file_t _file {_path};
+
+        bool _exists_result;
+        vfs::uv::uv_stat _stat_result;
+        std::string _read_result;
+        uint64_t _write_result;
+        int _close_error_result;
+        std::vector<std::string> _names;
+        bool _listed = false;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_uring_filesystem()
+        {
+            _uring_fs = std::make_unique<vfs::uring::uring_filesystem>();
+        }
+
+        void given_an_uring_filesystem_without_a_ring()
+        {
+            _uring_fs = std::make_unique<vfs::uring::uring_filesystem>(0);
+        }
+
+        void given_the_mount_is_listed()
+        {
+            _path.clear()
+                .append(_mount.path());
+        }
+
+        void given_an_existing_file_with_content()
+        {
+            given_an_existing_file();
+
+            write_file(_path, "uring-data");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_exists_is_invoked()
+        {
+            _result = _uring_fs->exists(_path, [this](vfs::any_path &, int err, bool exists)
+            {
+                _error_result = err;
+                _exists_result = exists;
+            });
+
+            _uring_fs->loop().run();
+        }
+
+        void when_stat_is_invoked()
+        {
+            _result = _uring_fs->stat(_path, [this](vfs::any_path &, int err, vfs::uv::uv_stat stat)
+            {
+                _error_result = err;
+                _stat_result = stat;
+            });
+
+            _uring_fs->loop().run();
+        }
+
+        void when_mkdir_is_invoked()
+        {
+            _result = _uring_fs->mkdir(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uring_fs->loop().run();
+        }
+
+        void when_unlink_is_invoked()
+        {
+            _result = _uring_fs->unlink(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uring_fs->loop().run();
+        }
+
+        void when_readdir_is_invoked_without_running_the_loop()
+        {
+            _result = _uring_fs->readdir(_path, 16, [this](vfs::any_path &, int err, vfs::dir_batch &batch)
+            {
+                _error_result = err;
+                _listed = true;
+
+                for (auto &entry : batch)
+                {
+                    _names.emplace_back(entry.name);
+                }
+
+                return true;
+            });
+        }
+
+        void when_the_loop_is_run()
+        {
+            _uring_fs->loop().run();
+        }
+
+        void when_the_file_is_opened_read_and_closed()
+        {
+            _result = _uring_fs->open(_path, O_RDONLY, [this](vfs::any_path &, int err, vfs::uv::_uv_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                _uring_fs->read(file, vfs::buffer {64}, 0, [this](vfs::uv::_uv_file_t &file, int err,
+                                                                   vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+
+                    _uring_fs->close(file, [this](vfs::uv::_uv_file_t &, int err)
+                    {
+                        _close_error_result = err;
+                    });
+                });
+            });
+
+            _uring_fs->loop().run();
+        }
+
+        void when_the_file_is_opened_written_and_closed()
+        {
+            _result = _uring_fs->open(_path, O_WRONLY, [this](vfs::any_path &, int err, vfs::uv::_uv_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                vfs::buffer buf {64};
+
+                buf.put("written", 7);
+
+                _uring_fs->write(file, std::move(buf), 0, [this](vfs::uv::_uv_file_t &file, int err,
+                                                                 vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _write_result = buf.size();
+
+                    _uring_fs->close(file, [this](vfs::uv::_uv_file_t &, int err)
+                    {
+                        _close_error_result = err;
+                    });
+                });
+            });
+
+            _uring_fs->loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        bool has_ring() const
+        {
+            return _uring_fs->is_uring();
+        }
+
+        void then_the_ring_is_used()
+        {
+            ASSERT_TRUE(_uring_fs->is_uring());
+        }
+
+        void then_the_ring_is_not_used()
+        {
+            ASSERT_FALSE(_uring_fs->is_uring());
+        }
+
+        void then_exist_result_is_true()
+        {
+            ASSERT_TRUE(_exists_result);
+        }
+
+        void then_exist_result_is_false()
+        {
+            ASSERT_FALSE(_exists_result);
+        }
+
+        void then_stat_result_is_a_file()
+        {
+            ASSERT_TRUE(_stat_result.inode() > 0);
+            ASSERT_TRUE(_stat_result.is_file());
+            ASSERT_EQ(10, _stat_result.size());
+        }
+
+        void then_path_is_a_dir()
+        {
+            struct stat64 stat;
+
+            ASSERT_EQ(0, stat64(_path.str().c_str(), &stat));
+            ASSERT_TRUE(S_ISDIR(stat.st_mode));
+        }
+
+        void then_path_does_not_exist()
+        {
+            struct stat64 stat;
+
+            ASSERT_NE(0, stat64(_path.str().c_str(), &stat));
+        }
+
+        void then_the_content_has_been_read()
+        {
+            ASSERT_EQ("uring-data", _read_result);
+            ASSERT_EQ(0, _close_error_result);
+        }
+
+        void then_the_content_has_been_written()
+        {
+            ASSERT_EQ(7, _write_result);
+            ASSERT_EQ(0, _close_error_result);
+            ASSERT_EQ("written", read_file(_path));
+        }
+
+        void then_nothing_was_listed_yet()
+        {
+            ASSERT_FALSE(_listed);
+        }
+
+        void then_the_dir_lists(const std::string &name)
+        {
+            ASSERT_EQ(std::vector<std::string> {name}, _names);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uring_filesystem, it_should_return_true_when_file_exists)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_existing_path();
+
+        if (!t.has_ring())
+        {
+            GTEST_SKIP() << "io_uring is not available on this host";
+        }
+
+        t.when_exists_is_invoked();
+
+        t.then_the_ring_is_used();
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_exist_result_is_true();
+    }
+
+    TEST(uring_filesystem, it_should_return_false_when_file_does_not_exist)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_unexisting_path();
+
+        t.when_exists_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_exist_result_is_false();
+    }
+
+    TEST(uring_filesystem, it_should_return_stat_struct_when_file_exists)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_existing_file_with_content();
+
+        t.when_stat_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_stat_result_is_a_file();
+    }
+
+    TEST(uring_filesystem, it_should_create_directory_when_directory_does_not_exist)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_unexisting_path();
+
+        t.when_mkdir_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_dir();
+    }
+
+    TEST(uring_filesystem, it_should_unlink_file_when_file_exists)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_existing_file();
+
+        t.when_unlink_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_does_not_exist();
+    }
+
+    TEST(uring_filesystem, it_should_return_enoent_when_unlinked_path_does_not_exist)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_unexisting_path();
+
+        t.when_unlink_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_enoent();
+    }
+
+    TEST(uring_filesystem, it_should_read_file_content)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_existing_file_with_content();
+
+        t.when_the_file_is_opened_read_and_closed();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_read();
+    }
+
+    TEST(uring_filesystem, it_should_write_file_content)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_existing_file();
+
+        t.when_the_file_is_opened_written_and_closed();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_written();
+    }
+
+    TEST(uring_filesystem, it_should_fall_back_to_uv_when_the_ring_is_unavailable)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem_without_a_ring();
+        t.given_an_existing_file_with_content();
+
+        t.when_the_file_is_opened_read_and_closed();
+
+        t.then_the_ring_is_not_used();
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_read();
+    }
+
+    TEST(uring_filesystem, it_should_list_dirs_off_the_loop_thread)
+    {
+        t_uring t;
+
+        t.given_an_uring_filesystem();
+        t.given_an_existing_file();
+        t.given_the_mount_is_listed();
+
+        t.when_readdir_is_invoked_without_running_the_loop();
+
+        t.then_result_is_zero();
+        t.then_nothing_was_listed_yet();
+
+        t.when_the_loop_is_run();
+
+        t.then_error_result_is_zero();
+        t.then_the_dir_lists("existing");
+    }
+}
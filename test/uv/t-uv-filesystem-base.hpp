@@ -1,6 +1,11 @@
 #ifndef VFS_T_UV_FILESYSTEM_BASE_HPP
 #define VFS_T_UV_FILESYSTEM_BASE_HPP
 
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
 #include <vfs/uv/uv-filesystem.hpp>
 #include <gtest/gtest.h>
 #include "../include/t-tmpfs-mount.hpp"
@@ -14,6 +19,8 @@ namespace vfs::test
         vfs::unix_path _unix_path;
         vfs::unix_path _unix_other_path;
 
+        std::vector<int> _fds;
+
       protected:
 
         // <editor-fold name="Context">
@@ -53,10 +60,54 @@ namespace vfs::test
             }
         }
 
+        void write_file(vfs::path &path, const std::string &content)
+        {
+            std::ofstream out {path.str(), std::ios::binary | std::ios::trunc};
+
+            out << content;
+
+            if (!out)
+            {
+                throw std::exception {};
+            }
+        }
+
+        std::string read_file(vfs::path &path)
+        {
+            std::ifstream in {path.str(), std::ios::binary};
+            std::stringstream content;
+
+            content << in.rdbuf();
+
+            return content.str();
+        }
+
+        vfs::uv::_uv_file_t open_file(vfs::any_path &path, int flags)
+        {
+            auto fd = ::open(path.str().c_str(), flags, 0664);
+
+            if (fd < 0)
+            {
+                throw std::exception {};
+            }
+
+            _fds.push_back(fd);
+
+            return vfs::uv::_uv_file_t {path, fd};
+        }
+
         // </editor-fold>
 
       public:
 
+        ~t_uv_filesystem_base()
+        {
+            for (auto fd : _fds)
+            {
+                ::close(fd);
+            }
+        }
+
         // <editor-fold name="Given">
 
         void given_an_existing_file()
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    using batch_result = vfs::uv::uv_filesystem::batch_type::result_type;
+
+    class t_batch :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::unix_path _unix_file_path;
+        vfs::unix_path _unix_unlink_path;
+        vfs::unix_path _unix_move_path;
+        vfs::unix_path _unix_moved_path;
+
+        vfs::any_path _file_path {_unix_file_path};
+        vfs::any_path _unlink_path {_unix_unlink_path};
+        vfs::any_path _move_path {_unix_move_path};
+        vfs::any_path _moved_path {_unix_moved_path};
+
+        std::unique_ptr<vfs::uv::uv_filesystem::batch_type> _batch {new auto(_uv_fs.batch())};
+
+        std::vector<batch_result> _batch_results;
+        int _calls = 0;
+
+        // </editor-fold>
+
+        vfs::any_path &mount_path(vfs::any_path &path, const char *name)
+        {
+            path.clear()
+                .append(_mount.path())
+                .append(name);
+
+            return path;
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_batch_with_a_concurrency_of(std::size_t concurrency)
+        {
+            _batch.reset(new auto(_uv_fs.batch(concurrency)));
+        }
+
+        void given_a_batch_of_heterogeneous_operations()
+        {
+            mount_path(_file_path, "file");
+            mount_path(_unlink_path, "unlink");
+            mount_path(_move_path, "move");
+            mount_path(_moved_path, "moved");
+
+            write_file(_file_path, "batch-data");
+            create_file(_unlink_path);
+            create_file(_move_path);
+
+            _batch->exists(_file_path)
+                  .stat(_file_path)
+                  .unlink(_unlink_path)
+                  .move(_move_path, _moved_path)
+                  .read(open_file(_file_path, O_RDONLY), vfs::buffer {64}, 0);
+        }
+
+        void given_a_batch_with_a_failing_operation()
+        {
+            given_an_unexisting_path();
+
+            mount_path(_file_path, "file");
+
+            create_file(_file_path);
+
+            _batch->exists(_file_path)
+                  .unlink(_path)
+                  .stat(_path);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_the_batch_is_submitted()
+        {
+            _result = _batch->submit([this](int err, std::vector<batch_result> &results)
+            {
+                ++_calls;
+
+                _error_result = err;
+                _batch_results = std::move(results);
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_completion_is_called_once()
+        {
+            ASSERT_EQ(1, _calls);
+        }
+
+        void then_there_are_results(std::size_t n)
+        {
+            ASSERT_EQ(n, _batch_results.size());
+        }
+
+        void then_each_result_matches_its_operation()
+        {
+            ASSERT_EQ(vfs::batch_op::exists, _batch_results[0].op());
+            ASSERT_EQ(0, _batch_results[0].error());
+            ASSERT_TRUE(_batch_results[0].exists());
+
+            ASSERT_EQ(vfs::batch_op::stat, _batch_results[1].op());
+            ASSERT_EQ(0, _batch_results[1].error());
+            ASSERT_EQ(10, _batch_results[1].stat().size());
+
+            ASSERT_EQ(vfs::batch_op::unlink, _batch_results[2].op());
+            ASSERT_EQ(0, _batch_results[2].error());
+
+            ASSERT_EQ(vfs::batch_op::move, _batch_results[3].op());
+            ASSERT_EQ(0, _batch_results[3].error());
+
+            auto &buf = _batch_results[4].buffer();
+
+            ASSERT_EQ(vfs::batch_op::read, _batch_results[4].op());
+            ASSERT_EQ(0, _batch_results[4].error());
+            ASSERT_EQ("batch-data", std::string(buf.begin(), buf.end()));
+        }
+
+        void then_the_operations_have_been_applied()
+        {
+            struct stat64 stat;
+
+            ASSERT_NE(0, stat64(_unlink_path.str().c_str(), &stat));
+            ASSERT_NE(0, stat64(_move_path.str().c_str(), &stat));
+            ASSERT_EQ(0, stat64(_moved_path.str().c_str(), &stat));
+        }
+
+        void then_only_the_failing_operations_have_errors()
+        {
+            ASSERT_EQ(0, _batch_results[0].error());
+            ASSERT_EQ(ENOENT, _batch_results[1].error());
+            ASSERT_EQ(ENOENT, _batch_results[2].error());
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_batch, it_should_complete_once_with_a_result_per_operation)
+    {
+        t_batch t;
+
+        t.given_a_batch_of_heterogeneous_operations();
+
+        t.when_the_batch_is_submitted();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_completion_is_called_once();
+        t.then_there_are_results(5);
+        t.then_each_result_matches_its_operation();
+        t.then_the_operations_have_been_applied();
+    }
+
+    TEST(uv_filesystem_batch, it_should_bound_the_number_of_operations_in_flight)
+    {
+        t_batch t;
+
+        t.given_a_batch_with_a_concurrency_of(1);
+        t.given_a_batch_of_heterogeneous_operations();
+
+        t.when_the_batch_is_submitted();
+
+        t.then_error_result_is_zero();
+        t.then_the_completion_is_called_once();
+        t.then_each_result_matches_its_operation();
+    }
+
+    TEST(uv_filesystem_batch, it_should_report_the_first_error_and_keep_going)
+    {
+        t_batch t;
+
+        t.given_a_batch_with_a_failing_operation();
+
+        t.when_the_batch_is_submitted();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_enoent();
+        t.then_the_completion_is_called_once();
+        t.then_there_are_results(3);
+        t.then_only_the_failing_operations_have_errors();
+    }
+
+    TEST(uv_filesystem_batch, it_should_complete_an_empty_batch)
+    {
+        t_batch t;
+
+        t.when_the_batch_is_submitted();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_completion_is_called_once();
+        t.then_there_are_results(0);
+    }
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <vfs/block-cache-filesystem.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    using block_cache_filesystem = vfs::block_cache_filesystem<vfs::uv::_uv_path_t, vfs::uv::_uv_stat_t,
+                                                               vfs::uv::_uv_file_t, vfs::uv::_uv_buf_t>;
+
+    class t_block_cache :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        block_cache_filesystem _fs {_uv_fs, 16, 4};
+
+        vfs::uv::_uv_file_t _file {_path};
+        std::vector<vfs::buffer_chain> _chains;
+        std::string _read_result;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_file_with(const std::string &content, int flags = O_RDONLY)
+        {
+            given_an_existing_file();
+
+            write_file(_path, content);
+
+            _file = open_file(_path, flags);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_blocks_are_read(uint64_t off, uint64_t len)
+        {
+            _error_result = -1;
+
+            _result = _fs.read_blocks(_file, off, len, [this](vfs::uv::_uv_file_t &, int err,
+                                                              vfs::buffer_chain &chain)
+            {
+                _error_result = err;
+                _read_result.clear();
+
+                for (auto &slice : chain)
+                {
+                    _read_result.append(slice.begin(), slice.end());
+                }
+
+                _chains.push_back(std::move(chain));
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_read_is_invoked(off64_t off)
+        {
+            _error_result = -1;
+
+            _result = _fs.read(_file, vfs::buffer {64}, off, [this](vfs::uv::_uv_file_t &, int err,
+                                                                    vfs::buffer &buf)
+            {
+                _error_result = err;
+                _read_result = std::string {buf.begin(), buf.end()};
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_written_through_the_cache(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            _result = _fs.write(_file, std::move(buf), 0, [this](vfs::uv::_uv_file_t &, int err, vfs::buffer &)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_replaced_externally(const std::string &content)
+        {
+            write_file(_path, content);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_content_is(const std::string &expected)
+        {
+            ASSERT_EQ(expected, _read_result);
+        }
+
+        void then_the_tier_stats_are(uint64_t recent_hits, uint64_t frequent_hits, uint64_t misses)
+        {
+            auto stats = _fs.stats();
+
+            ASSERT_EQ(recent_hits, stats.recent.hits);
+            ASSERT_EQ(frequent_hits, stats.frequent.hits);
+            ASSERT_EQ(misses, stats.misses);
+        }
+
+        void then_the_recent_hit_rate_is(double expected)
+        {
+            auto stats = _fs.stats();
+
+            ASSERT_DOUBLE_EQ(expected, stats.hit_rate(stats.recent));
+        }
+
+        void then_the_chains_share_the_cached_blocks()
+        {
+            ASSERT_EQ(2, _chains.size());
+            ASSERT_EQ(_chains[0].count(), _chains[1].count());
+
+            for (std::size_t i = 0; i < _chains[0].count(); ++i)
+            {
+                ASSERT_EQ(_chains[0][i].data(), _chains[1][i].data());
+            }
+        }
+
+        void then_the_block_was_promoted_from_the_ghost_list()
+        {
+            auto stats = _fs.stats();
+
+            ASSERT_EQ(1, stats.ghost_hits);
+            ASSERT_EQ(1, stats.frequent.blocks);
+            ASSERT_EQ(3, stats.recent.evictions);
+            ASSERT_LE(stats.recent.bytes + stats.frequent.bytes, _fs.budget());
+        }
+
+        void then_stale_blocks_were_dropped(uint64_t expected)
+        {
+            ASSERT_EQ(expected, _fs.stats().stale);
+        }
+
+        void then_blocks_were_invalidated()
+        {
+            ASSERT_LT(0, _fs.stats().invalidations);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_block_cache, it_should_serve_repeated_reads_from_the_recent_tier)
+    {
+        t_block_cache t;
+
+        t.given_a_file_with("0123456789");
+
+        t.when_blocks_are_read(2, 6);
+        t.when_blocks_are_read(2, 6);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_is("234567");
+        t.then_the_tier_stats_are(2, 0, 2);
+        t.then_the_recent_hit_rate_is(0.5);
+    }
+
+    TEST(uv_filesystem_block_cache, it_should_hand_out_cached_blocks_without_copying)
+    {
+        t_block_cache t;
+
+        t.given_a_file_with("0123456789");
+
+        t.when_blocks_are_read(0, 10);
+        t.when_blocks_are_read(0, 10);
+
+        t.then_the_content_is("0123456789");
+        t.then_the_chains_share_the_cached_blocks();
+    }
+
+    TEST(uv_filesystem_block_cache, it_should_promote_blocks_seen_again_after_eviction)
+    {
+        t_block_cache t;
+
+        t.given_a_file_with("abcdefghijklmnopqrstuvwx");
+
+        t.when_blocks_are_read(0, 24);
+        t.when_blocks_are_read(0, 4);
+        t.when_blocks_are_read(0, 4);
+
+        t.then_the_content_is("abcd");
+        t.then_the_tier_stats_are(0, 1, 7);
+        t.then_the_block_was_promoted_from_the_ghost_list();
+    }
+
+    TEST(uv_filesystem_block_cache, it_should_drop_blocks_when_the_size_changes)
+    {
+        t_block_cache t;
+
+        t.given_a_file_with("0123456789");
+
+        t.when_read_is_invoked(0);
+        t.when_the_file_is_replaced_externally("a longer object");
+        t.when_read_is_invoked(0);
+
+        t.then_error_result_is_zero();
+        t.then_the_content_is("a longer object");
+        t.then_stale_blocks_were_dropped(1);
+    }
+
+    TEST(uv_filesystem_block_cache, it_should_invalidate_blocks_written_through_the_cache)
+    {
+        t_block_cache t;
+
+        t.given_a_file_with("0123456789", O_RDWR);
+
+        t.when_blocks_are_read(0, 10);
+        t.when_the_file_is_written_through_the_cache("XY");
+        t.when_blocks_are_read(0, 10);
+
+        t.then_error_result_is_zero();
+        t.then_the_content_is("XY23456789");
+        t.then_blocks_were_invalidated();
+    }
+
+    TEST(uv_filesystem_block_cache, it_should_forward_reads_at_the_current_position)
+    {
+        t_block_cache t;
+
+        t.given_a_file_with("0123456789");
+
+        t.when_read_is_invoked(-1);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_is("0123456789");
+        t.then_the_tier_stats_are(0, 0, 0);
+    }
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <vfs/buffer-chain.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_chain :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::string _read_result;
+        std::size_t _read_count = 0;
+
+        // </editor-fold>
+
+        static vfs::buffer make_buffer(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            return buf;
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_existing_file_with_content()
+        {
+            given_an_existing_file();
+
+            write_file(_path, "0123456789abcdef");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_a_chain_is_written()
+        {
+            vfs::buffer_slice body {make_buffer("--header--body--")};
+
+            vfs::buffer_chain chain;
+
+            chain.append(body.slice(2, 6))
+                .append(make_buffer(":"))
+                .append(body.slice(10, 4));
+
+            _result = _uv_fs.write(open_file(_path, O_WRONLY | O_TRUNC), std::move(chain), 0,
+                                   [this](vfs::uv::_uv_file_t &, int err, vfs::buffer_chain &)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_a_chain_is_read()
+        {
+            vfs::buffer_slice space {vfs::buffer {32}, 32};
+
+            vfs::buffer_chain chain;
+
+            chain.append(space.slice(0, 4))
+                .append(space.slice(16, 4))
+                .append(vfs::buffer_slice {vfs::buffer {64}, 64});
+
+            _result = _uv_fs.read(open_file(_path, O_RDONLY), std::move(chain), 0,
+                                  [this](vfs::uv::_uv_file_t &, int err, vfs::buffer_chain &chain)
+            {
+                _error_result = err;
+                _read_count = chain.count();
+
+                for (auto &slice : chain)
+                {
+                    _read_result.append(slice.begin(), slice.end());
+                }
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_file_has_the_chain_content()
+        {
+            ASSERT_EQ("header:body", read_file(_path));
+        }
+
+        void then_the_chain_has_been_filled()
+        {
+            ASSERT_EQ("0123456789abcdef", _read_result);
+            ASSERT_EQ(3, _read_count);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_chain, it_should_write_a_chain_in_one_call)
+    {
+        t_chain t;
+
+        t.given_an_existing_file();
+
+        t.when_a_chain_is_written();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_file_has_the_chain_content();
+    }
+
+    TEST(uv_filesystem_chain, it_should_read_into_a_chain_in_one_call)
+    {
+        t_chain t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_a_chain_is_read();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_chain_has_been_filled();
+    }
+}
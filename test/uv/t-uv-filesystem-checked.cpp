@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <csignal>
+
+#include <sys/resource.h>
+
+#include <vfs/crc32c.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_checked :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::uv::uv_worker_pool> _pool;
+
+        std::string _content = "checksummed-object-payload";
+        std::string _read_result;
+        uint32_t _digest = 0;
+
+        bool _limited = false;
+        struct rlimit _saved_limit {};
+
+        // </editor-fold>
+
+      public:
+
+        ~t_checked()
+        {
+            if (_limited)
+            {
+                ::setrlimit(RLIMIT_FSIZE, &_saved_limit);
+            }
+        }
+
+        // <editor-fold name="Given">
+
+        void given_a_worker_pool()
+        {
+            _pool = std::make_unique<vfs::uv::uv_worker_pool>();
+
+            _uv_fs.use_worker_pool(*_pool);
+        }
+
+        void given_an_existing_file_with_content()
+        {
+            given_an_existing_file();
+
+            write_file(_path, _content);
+        }
+
+        void given_a_file_size_limit(rlim_t limit)
+        {
+            ASSERT_EQ(0, ::getrlimit(RLIMIT_FSIZE, &_saved_limit));
+
+            struct rlimit rlimit = _saved_limit;
+
+            rlimit.rlim_cur = limit;
+
+            std::signal(SIGXFSZ, SIG_IGN);
+
+            ASSERT_EQ(0, ::setrlimit(RLIMIT_FSIZE, &rlimit));
+
+            _limited = true;
+        }
+
+        void given_content_larger_than(std::size_t size)
+        {
+            _content.assign(2 * size, 'x');
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_it_is_read_checked()
+        {
+            _result = _uv_fs.read_checked(open_file(_path, O_RDONLY), vfs::buffer {64}, 0,
+                                          [this](vfs::uv::_uv_file_t &, int err, vfs::buffer &buf, uint32_t digest)
+            {
+                _error_result = err;
+                _read_result = std::string {buf.begin(), buf.end()};
+                _digest = digest;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_it_is_read_against(uint32_t expected)
+        {
+            _result = _uv_fs.read_checked(open_file(_path, O_RDONLY), vfs::buffer {64}, 0, expected,
+                                          [this](vfs::uv::_uv_file_t &, int err, vfs::buffer &buf, uint32_t digest)
+            {
+                _error_result = err;
+                _read_result = std::string {buf.begin(), buf.end()};
+                _digest = digest;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_it_is_written_checked()
+        {
+            vfs::buffer buf {_content.size() + 1};
+
+            buf.put(_content.data(), _content.size());
+
+            _result = _uv_fs.write_checked(open_file(_path, O_WRONLY | O_TRUNC), std::move(buf), 0,
+                                           [this](vfs::uv::_uv_file_t &, int err, vfs::buffer &, uint32_t digest)
+            {
+                _error_result = err;
+                _digest = digest;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        uint32_t expected_digest()
+        {
+            return vfs::crc32c(_content.data(), _content.size());
+        }
+
+        void then_the_content_and_digest_have_been_read()
+        {
+            ASSERT_EQ(_content, _read_result);
+            ASSERT_EQ(expected_digest(), _digest);
+        }
+
+        void then_the_content_and_digest_have_been_written()
+        {
+            ASSERT_EQ(_content, read_file(_path));
+            ASSERT_EQ(expected_digest(), _digest);
+        }
+
+        void then_error_result_is_efbig()
+        {
+            ASSERT_EQ(EFBIG, _error_result);
+        }
+
+        void then_error_result_is_ebadmsg()
+        {
+            ASSERT_EQ(EBADMSG, _error_result);
+            ASSERT_EQ("", _read_result);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_checked, it_should_return_the_digest_of_a_read)
+    {
+        t_checked t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_it_is_read_checked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_and_digest_have_been_read();
+    }
+
+    TEST(uv_filesystem_checked, it_should_accept_a_read_matching_the_expected_digest)
+    {
+        t_checked t;
+
+        t.given_a_worker_pool();
+        t.given_an_existing_file_with_content();
+
+        t.when_it_is_read_against(vfs::crc32c("checksummed-object-payload", 26));
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_and_digest_have_been_read();
+    }
+
+    TEST(uv_filesystem_checked, it_should_fail_a_read_with_a_mismatching_digest)
+    {
+        t_checked t;
+
+        t.given_an_existing_file_with_content();
+
+        t.when_it_is_read_against(0xdeadbeef);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_ebadmsg();
+    }
+
+    TEST(uv_filesystem_checked, it_should_return_the_digest_of_a_write)
+    {
+        t_checked t;
+
+        t.given_an_existing_file();
+
+        t.when_it_is_written_checked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_and_digest_have_been_written();
+    }
+
+    TEST(uv_filesystem_checked, it_should_not_report_a_short_write_as_success)
+    {
+        t_checked t;
+
+        t.given_an_existing_file();
+        t.given_content_larger_than(4096);
+        t.given_a_file_size_limit(4096);
+
+        t.when_it_is_written_checked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_efbig();
+    }
+}
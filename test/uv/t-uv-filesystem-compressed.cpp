@@ -0,0 +1,449 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <vfs/compressed-filesystem.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class rle_codec :
+        public vfs::block_codec
+    {
+      public:
+
+        uint8_t id() const noexcept override
+        {
+            return 0x7f;
+        }
+
+        std::size_t bound(std::size_t size) const noexcept override
+        {
+            return 2 * size;
+        }
+
+        int64_t compress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            std::size_t n = 0;
+
+            for (std::size_t i = 0; i < size;)
+            {
+                std::size_t run = 1;
+
+                while (i + run < size && run < 255 && src[i + run] == src[i])
+                {
+                    ++run;
+                }
+
+                if (n + 2 > cap)
+                {
+                    return -ENOBUFS;
+                }
+
+                dst[n++] = static_cast<uint8_t>(run);
+                dst[n++] = src[i];
+
+                i += run;
+            }
+
+            return static_cast<int64_t>(n);
+        }
+
+        int64_t decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t cap) const noexcept override
+        {
+            std::size_t n = 0;
+
+            for (std::size_t i = 0; i + 1 < size; i += 2)
+            {
+                if (n + src[i] > cap)
+                {
+                    return -EBADMSG;
+                }
+
+                std::memset(dst + n, src[i + 1], src[i]);
+
+                n += src[i];
+            }
+
+            return static_cast<int64_t>(n);
+        }
+    };
+
+    using compressed_filesystem = vfs::compressed_filesystem<vfs::uv::_uv_path_t, vfs::uv::_uv_stat_t,
+                                                             vfs::uv::_uv_file_t, vfs::uv::_uv_buf_t>;
+
+    class t_compressed :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        rle_codec _rle;
+
+        vfs::uv::uv_worker_pool _pool;
+        vfs::uv::uv_work_port _port {_pool, _uv_fs.loop()};
+
+        std::unique_ptr<compressed_filesystem> _fs;
+
+        std::string _content;
+        std::string _read_result;
+
+        // </editor-fold>
+
+        static vfs::buffer make_buffer(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            return buf;
+        }
+
+        static std::string make_content(std::size_t size)
+        {
+            std::string content;
+
+            for (std::size_t i = 0; content.size() < size; ++i)
+            {
+                content.append(i % 7 + 1, static_cast<char>('a' + i % 26));
+            }
+
+            content.resize(size);
+
+            return content;
+        }
+
+        void with_file(int32_t flags, vfs::callback<void(vfs::uv::_uv_file_t &), 128> fn)
+        {
+            _error_result = -1;
+
+            _result = _fs->open(_path, flags, [this, fn = std::move(fn)](vfs::uv::_uv_path_t &, int err,
+                                                                      vfs::uv::_uv_file_t &file) mutable
+            {
+                _error_result = err;
+
+                if (err == 0)
+                {
+                    fn(file);
+                }
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void write_content(vfs::uv::_uv_file_t &file, const std::string &content)
+        {
+            auto result = _fs->write(file, make_buffer(content), -1,
+                                     [this](vfs::uv::_uv_file_t &file, int err, vfs::buffer &)
+            {
+                _error_result = err;
+                _fs->close(file, [](vfs::uv::_uv_file_t &, int)
+                {});
+            });
+
+            if (result != 0)
+            {
+                _result = result;
+            }
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_compressed_filesystem(const vfs::block_codec &codec)
+        {
+            _fs = std::make_unique<compressed_filesystem>(_uv_fs, [this](vfs::block_work work, vfs::block_done done)
+            {
+                return _port.submit(vfs::uv::uv_work_class::data, std::move(work), std::move(done));
+            }, codec, 1024);
+        }
+
+        void given_a_compressed_filesystem()
+        {
+            given_a_compressed_filesystem(_rle);
+        }
+
+        void given_a_compressed_file(std::size_t size)
+        {
+            given_an_unexisting_path();
+
+            _content = make_content(size);
+
+            with_file(O_WRONLY | O_CREAT | O_TRUNC, [this](vfs::uv::_uv_file_t &file)
+            {
+                write_content(file, _content);
+            });
+        }
+
+        void given_an_appended_compressed_file(std::size_t size)
+        {
+            given_a_compressed_file(size);
+
+            auto more = make_content(size + 300);
+
+            _content += more;
+
+            with_file(O_WRONLY, [this, more](vfs::uv::_uv_file_t &file)
+            {
+                write_content(file, more);
+            });
+        }
+
+        void given_a_corrupted_block()
+        {
+            auto raw = read_file(_path);
+
+            raw[sizeof(vfs::compressed_block_header) + 1] ^= 0x5a;
+
+            write_file(_path, raw);
+        }
+
+        void given_a_footer_claiming_blocks(uint64_t blocks)
+        {
+            auto raw = read_file(_path);
+
+            vfs::compressed_block_footer footer;
+
+            std::memcpy(&footer, raw.data() + raw.size() - sizeof(footer), sizeof(footer));
+
+            footer.blocks = blocks;
+
+            std::memcpy(raw.data() + raw.size() - sizeof(footer), &footer, sizeof(footer));
+
+            write_file(_path, raw);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_a_range_is_read(off64_t off, uint64_t len)
+        {
+            with_file(O_RDONLY, [this, off, len](vfs::uv::_uv_file_t &file)
+            {
+                auto result = _fs->read(file, vfs::buffer {len}, off,
+                                        [this](vfs::uv::_uv_file_t &file, int err, vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+
+                    _fs->close(file, [](vfs::uv::_uv_file_t &, int)
+                    {});
+                });
+
+                if (result != 0)
+                {
+                    _result = result;
+                }
+            });
+        }
+
+        void when_it_is_written_in_the_middle()
+        {
+            with_file(O_WRONLY, [this](vfs::uv::_uv_file_t &file)
+            {
+                _result = _fs->write(file, make_buffer("patch"), 10, [](vfs::uv::_uv_file_t &, int, vfs::buffer &)
+                {});
+
+                _fs->close(file, [](vfs::uv::_uv_file_t &, int)
+                {});
+            });
+        }
+
+        void when_a_plain_file_is_opened()
+        {
+            given_an_existing_file();
+
+            write_file(_path, "plain content, no block index");
+
+            with_file(O_RDONLY, [](vfs::uv::_uv_file_t &)
+            {});
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_range_is(off64_t off, uint64_t len)
+        {
+            ASSERT_EQ(_content.substr(off, len), _read_result);
+        }
+
+        void then_the_file_is_smaller_than_its_content()
+        {
+            ASSERT_LT(read_file(_path).size(), _content.size());
+            ASSERT_GT(_fs->stats().blocks_written, 1);
+        }
+
+        void then_the_blocks_were_stored_uncompressed()
+        {
+            auto stats = _fs->stats();
+
+            ASSERT_EQ(stats.blocks_written, stats.blocks_uncompressed);
+        }
+
+        void then_result_is_enotsup()
+        {
+            ASSERT_EQ(-ENOTSUP, _result);
+        }
+
+        void then_error_result_is_ebadmsg()
+        {
+            ASSERT_EQ(EBADMSG, _error_result);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_compressed, it_should_read_back_the_whole_content)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+        t.given_a_compressed_file(5000);
+
+        t.when_a_range_is_read(0, 8192);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_is(0, 5000);
+        t.then_the_file_is_smaller_than_its_content();
+    }
+
+    TEST(uv_filesystem_compressed, it_should_read_a_range_across_blocks)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+        t.given_a_compressed_file(5000);
+
+        t.when_a_range_is_read(1000, 2100);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_is(1000, 2100);
+    }
+
+    TEST(uv_filesystem_compressed, it_should_reload_the_index_after_an_append)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+        t.given_an_appended_compressed_file(1500);
+
+        t.when_a_range_is_read(1200, 1000);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_is(1200, 1000);
+    }
+
+    TEST(uv_filesystem_compressed, it_should_store_blocks_that_do_not_compress)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem(vfs::stored_codec::instance());
+        t.given_a_compressed_file(3000);
+
+        t.when_a_range_is_read(500, 2000);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_is(500, 2000);
+        t.then_the_blocks_were_stored_uncompressed();
+    }
+
+    TEST(uv_filesystem_compressed, it_should_detect_a_corrupted_block)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+        t.given_a_compressed_file(3000);
+        t.given_a_corrupted_block();
+
+        t.when_a_range_is_read(0, 100);
+
+        t.then_error_result_is_ebadmsg();
+    }
+
+    TEST(uv_filesystem_compressed, it_should_reject_a_file_without_an_index)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+
+        t.when_a_plain_file_is_opened();
+
+        t.then_error_result_is_ebadmsg();
+    }
+
+    TEST(uv_filesystem_compressed, it_should_reject_a_footer_claiming_more_blocks_than_fit)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+        t.given_a_compressed_file(3000);
+        t.given_a_footer_claiming_blocks(uint64_t {1} << 60);
+
+        t.when_a_range_is_read(0, 100);
+
+        t.then_error_result_is_ebadmsg();
+    }
+
+    TEST(uv_filesystem_compressed, it_should_only_append)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem();
+        t.given_a_compressed_file(3000);
+
+        t.when_it_is_written_in_the_middle();
+
+        t.then_result_is_enotsup();
+    }
+
+#ifdef VFS_HAVE_LZ4
+
+    TEST(uv_filesystem_compressed, it_should_read_a_range_compressed_with_lz4)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem(vfs::lz4_codec::instance());
+        t.given_a_compressed_file(5000);
+
+        t.when_a_range_is_read(1000, 2100);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_is(1000, 2100);
+        t.then_the_file_is_smaller_than_its_content();
+    }
+
+#endif
+
+#ifdef VFS_HAVE_ZSTD
+
+    TEST(uv_filesystem_compressed, it_should_read_a_range_compressed_with_zstd)
+    {
+        t_compressed t;
+
+        t.given_a_compressed_filesystem(vfs::zstd_codec::instance());
+        t.given_a_compressed_file(5000);
+
+        t.when_a_range_is_read(1000, 2100);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_is(1000, 2100);
+        t.then_the_file_is_smaller_than_its_content();
+    }
+
+#endif
+}
@@ -11,8 +11,76 @@ namespace
     class t_copy :
         public vfs::test::t_uv_filesystem_base
     {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::uv::uv_worker_pool> _pool;
+
+        vfs::uv::uv_copy_options _options;
+
+        std::string _content;
+
+        std::vector<uint64_t> _progress;
+        uint64_t _total = 0;
+
+        // </editor-fold>
+
       public:
 
+        // <editor-fold name="Given">
+
+        void given_a_worker_pool()
+        {
+            _pool = std::make_unique<vfs::uv::uv_worker_pool>();
+
+            _uv_fs.use_worker_pool(*_pool);
+        }
+
+        void given_an_existing_file_with_content(std::size_t size)
+        {
+            given_an_existing_file();
+
+            _content.resize(size);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                _content[i] = static_cast<char>('a' + (i * 7 + i / 13) % 26);
+            }
+
+            write_file(_path, _content);
+        }
+
+        void given_an_existing_sparse_file(off64_t size)
+        {
+            given_an_existing_file();
+
+            auto fd = ::open(_path.str().c_str(), O_WRONLY);
+
+            ASSERT_LE(0, fd);
+            ASSERT_EQ(0, ::ftruncate64(fd, size));
+            ASSERT_EQ(4, ::pwrite64(fd, "head", 4, 0));
+            ASSERT_EQ(4, ::pwrite64(fd, "tail", 4, size - 4));
+
+            ::close(fd);
+
+            _content = read_file(_path);
+        }
+
+        void given_copy_options(vfs::uv::uv_copy_method method, uint64_t chunk_size, std::size_t parallelism)
+        {
+            _options.method = method;
+            _options.chunk_size = chunk_size;
+            _options.parallelism = parallelism;
+            _options.progress = [this](uint64_t copied, uint64_t total)
+            {
+                _progress.push_back(copied);
+                _total = total;
+            };
+        }
+
+        // </editor-fold>
+
         // <editor-fold name="When">
 
         void when_copy_is_invoked()
@@ -25,6 +93,27 @@ namespace
             _uv_fs.loop().run();
         }
 
+        void when_copy_onto_itself_is_invoked()
+        {
+            _result = _uv_fs.copy(_path, _path, [this](vfs::any_path &, vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_copy_is_invoked_with_options()
+        {
+            _result = _uv_fs.copy(_path, _other_path, std::move(_options),
+                                  [this](vfs::any_path &, vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
         // </editor-fold>
 
         // <editor-fold name="Then">
@@ -44,6 +133,33 @@ namespace
             ASSERT_TRUE(S_ISREG(stat.st_mode));
         }
 
+        void then_content_has_been_copied()
+        {
+            ASSERT_EQ(_content, read_file(_other_path));
+        }
+
+        void then_path_still_has_the_content()
+        {
+            ASSERT_EQ(_content, read_file(_path));
+        }
+
+        void then_progress_was_reported_in(std::size_t chunks)
+        {
+            ASSERT_EQ(chunks, _progress.size());
+            ASSERT_TRUE(std::is_sorted(_progress.begin(), _progress.end()));
+            ASSERT_EQ(_content.size(), _progress.back());
+            ASSERT_EQ(_content.size(), _total);
+        }
+
+        void then_holes_have_been_preserved()
+        {
+            struct stat64 stat;
+
+            ASSERT_EQ(0, stat64(_other_path.str().c_str(), &stat));
+            ASSERT_EQ(_content.size(), stat.st_size);
+            ASSERT_GT(1024 * 1024, stat.st_blocks * 512);
+        }
+
         // </editor-fold>
     };
 
@@ -92,4 +208,82 @@ namespace
         t.then_result_is_zero();
         t.then_error_result_is_enoent();
     }
-}
\ No newline at end of file
+
+    TEST(uv_filesystem_copy, it_should_copy_content_in_parallel_ranges)
+    {
+        t_copy t;
+
+        t.given_an_existing_file_with_content(64 * 1024 + 17);
+        t.given_an_unexisting_other_path();
+        t.given_copy_options(vfs::uv::uv_copy_method::reflink, 4096, 3);
+
+        t.when_copy_is_invoked_with_options();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_content_has_been_copied();
+        t.then_progress_was_reported_in(17);
+    }
+
+    TEST(uv_filesystem_copy, it_should_preserve_holes_in_sparse_files)
+    {
+        t_copy t;
+
+        t.given_an_existing_sparse_file(16 * 1024 * 1024);
+        t.given_an_unexisting_other_path();
+        t.given_copy_options(vfs::uv::uv_copy_method::copy_file_range, 1024 * 1024, 4);
+
+        t.when_copy_is_invoked_with_options();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_content_has_been_copied();
+        t.then_holes_have_been_preserved();
+    }
+
+    TEST(uv_filesystem_copy, it_should_copy_content_with_sendfile)
+    {
+        t_copy t;
+
+        t.given_an_existing_file_with_content(10000);
+        t.given_an_existing_other_path();
+        t.given_copy_options(vfs::uv::uv_copy_method::sendfile, 1000, 4);
+
+        t.when_copy_is_invoked_with_options();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_content_has_been_copied();
+        t.then_progress_was_reported_in(10);
+    }
+
+    TEST(uv_filesystem_copy, it_should_copy_content_with_read_write_on_the_worker_pool)
+    {
+        t_copy t;
+
+        t.given_a_worker_pool();
+        t.given_an_existing_file_with_content(3 * 1024 * 1024 + 5);
+        t.given_an_unexisting_other_path();
+        t.given_copy_options(vfs::uv::uv_copy_method::read_write, 1024 * 1024, 2);
+
+        t.when_copy_is_invoked_with_options();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_content_has_been_copied();
+        t.then_progress_was_reported_in(4);
+    }
+
+    TEST(uv_filesystem_copy, it_should_leave_a_file_copied_onto_itself_intact)
+    {
+        t_copy t;
+
+        t.given_an_existing_file_with_content(4096);
+
+        t.when_copy_onto_itself_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_still_has_the_content();
+    }
+}
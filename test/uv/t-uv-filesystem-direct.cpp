@@ -0,0 +1,356 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vfs/crc32c.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_direct :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::string _content;
+        std::string _read_result;
+
+        uint32_t _file_alignment = 0;
+        int _op_result = 0;
+        uint32_t _digest = 0;
+
+        // </editor-fold>
+
+        template<typename t_fn>
+        void with_direct_file(t_fn &&fn)
+        {
+            _result = _uv_fs.open(_path, O_RDWR | O_DIRECT, [this, fn](vfs::any_path &, int err, vfs::uv::_uv_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                _file_alignment = file.direct_alignment();
+
+                fn(file);
+            });
+
+            _uv_fs.loop().run();
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_existing_file_with_content(std::size_t size)
+        {
+            given_an_existing_file();
+
+            _content.resize(size);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                _content[i] = static_cast<char>('a' + i % 26);
+            }
+
+            write_file(_path, _content);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_it_is_read_directly(vfs::buffer buf, off64_t off)
+        {
+            with_direct_file([this, buf = std::make_shared<vfs::buffer>(std::move(buf)), off](vfs::uv::_uv_file_t &file)
+            {
+                _uv_fs.read(file, std::move(*buf), off, [this](vfs::uv::_uv_file_t &file, int err, vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+
+                    _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                    {});
+                });
+            });
+        }
+
+        void when_it_is_written_directly(const std::string &content, off64_t off)
+        {
+            _content.resize(std::max(_content.size(), off + content.size()));
+            _content.replace(off, content.size(), content);
+
+            with_direct_file([this, content, off](vfs::uv::_uv_file_t &file)
+            {
+                vfs::buffer buf {content.size() + 1};
+
+                buf.put(content.data(), content.size());
+
+                _uv_fs.write(file, std::move(buf), off, [this](vfs::uv::_uv_file_t &file, int err, vfs::buffer &)
+                {
+                    _error_result = err;
+
+                    _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                    {});
+                });
+            });
+        }
+
+        void when_ranges_are_written_directly_at_once(std::size_t n, std::size_t len)
+        {
+            std::vector<std::pair<std::string, off64_t>> ranges;
+
+            // neighbouring ranges share blocks, and the highest goes first so no later one may trim it off
+            for (std::size_t i = n; i > 0; --i)
+            {
+                ranges.emplace_back(std::string(len, static_cast<char>('a' + i % 26)), (i - 1) * len * 2);
+            }
+
+            for (auto &[content, off] : ranges)
+            {
+                _content.resize(std::max(_content.size(), off + content.size()));
+                _content.replace(off, content.size(), content);
+            }
+
+            with_direct_file([this, ranges](vfs::uv::_uv_file_t &file)
+            {
+                auto pending = std::make_shared<std::size_t>(ranges.size());
+
+                for (auto &[content, off] : ranges)
+                {
+                    vfs::buffer buf {content.size() + 1};
+
+                    buf.put(content.data(), content.size());
+
+                    _uv_fs.write(file, std::move(buf), off, [this, pending](vfs::uv::_uv_file_t &file, int err,
+                                                                             vfs::buffer &)
+                    {
+                        _error_result = _error_result != 0 ? _error_result : err;
+
+                        if (--*pending == 0)
+                        {
+                            _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                            {});
+                        }
+                    });
+                }
+            });
+        }
+
+        void when_it_is_read_directly_at_the_current_position()
+        {
+            with_direct_file([this](vfs::uv::_uv_file_t &file)
+            {
+                _op_result = _uv_fs.read(file, vfs::buffer {100}, -1, [](vfs::uv::_uv_file_t &, int, vfs::buffer &)
+                {});
+
+                _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                {});
+            });
+        }
+
+        void when_it_is_read_directly_into_unaligned_buffers(off64_t off)
+        {
+            with_direct_file([this, off](vfs::uv::_uv_file_t &file)
+            {
+                std::vector<vfs::buffer> bufs;
+
+                bufs.emplace_back(100);
+                bufs.emplace_back(100);
+
+                _op_result = _uv_fs.readv(file, std::move(bufs), off, [](vfs::uv::_uv_file_t &, int,
+                                                                         std::vector<vfs::buffer> &)
+                {});
+
+                _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                {});
+            });
+        }
+
+        void when_it_is_read_checked_directly(vfs::buffer buf, off64_t off)
+        {
+            with_direct_file([this, buf = std::make_shared<vfs::buffer>(std::move(buf)), off](vfs::uv::_uv_file_t &file)
+            {
+                _op_result = _uv_fs.read_checked(file, std::move(*buf), off, [this](vfs::uv::_uv_file_t &file, int err,
+                                                                                    vfs::buffer &buf, uint32_t digest)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+                    _digest = digest;
+
+                    _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                    {});
+                });
+            });
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_file_is_direct()
+        {
+            ASSERT_EQ(4096, _file_alignment);
+        }
+
+        void then_the_range_has_been_read(off64_t off, std::size_t len)
+        {
+            ASSERT_EQ(_content.substr(off, len), _read_result);
+        }
+
+        void then_the_op_was_rejected()
+        {
+            ASSERT_EQ(UV_EINVAL, _op_result);
+        }
+
+        void then_the_op_was_accepted()
+        {
+            ASSERT_EQ(0, _op_result);
+        }
+
+        void then_the_digest_matches_the_range(off64_t off, std::size_t len)
+        {
+            auto expected = _content.substr(off, len);
+
+            ASSERT_EQ(vfs::crc32c(expected.data(), expected.size()), _digest);
+        }
+
+        void then_the_file_has_the_content()
+        {
+            ASSERT_EQ(_content, read_file(_path));
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_direct, it_should_read_an_aligned_range)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(16384);
+
+        t.when_it_is_read_directly(vfs::buffer::aligned(8192, 4096), 4096);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_file_is_direct();
+        t.then_the_range_has_been_read(4096, 8192);
+    }
+
+    TEST(uv_filesystem_direct, it_should_read_an_unaligned_range)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(10000);
+
+        t.when_it_is_read_directly(vfs::buffer {100}, 4050);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_has_been_read(4050, 100);
+    }
+
+    TEST(uv_filesystem_direct, it_should_read_an_unaligned_range_up_to_the_end_of_file)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(5000);
+
+        t.when_it_is_read_directly(vfs::buffer {1000}, 4500);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_range_has_been_read(4500, 500);
+    }
+
+    TEST(uv_filesystem_direct, it_should_write_an_unaligned_range)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(10000);
+
+        t.when_it_is_written_directly("spanning-two-blocks", 4090);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_file_has_the_content();
+    }
+
+    TEST(uv_filesystem_direct, it_should_extend_the_file_with_an_unaligned_write)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(5000);
+
+        t.when_it_is_written_directly("appended", 5000);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_file_has_the_content();
+    }
+
+    TEST(uv_filesystem_direct, it_should_not_lose_concurrent_unaligned_writes)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(0);
+
+        t.when_ranges_are_written_directly_at_once(128, 20);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_file_has_the_content();
+    }
+
+    TEST(uv_filesystem_direct, it_should_reject_reads_at_the_current_position)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(5000);
+
+        t.when_it_is_read_directly_at_the_current_position();
+
+        t.then_result_is_zero();
+        t.then_the_op_was_rejected();
+    }
+
+    TEST(uv_filesystem_direct, it_should_reject_unaligned_vectored_reads)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(5000);
+
+        t.when_it_is_read_directly_into_unaligned_buffers(4096);
+
+        t.then_result_is_zero();
+        t.then_the_op_was_rejected();
+    }
+
+    TEST(uv_filesystem_direct, it_should_bounce_unaligned_checked_reads)
+    {
+        t_direct t;
+
+        t.given_an_existing_file_with_content(10000);
+
+        t.when_it_is_read_checked_directly(vfs::buffer {100}, 4050);
+
+        t.then_result_is_zero();
+        t.then_the_op_was_accepted();
+        t.then_error_result_is_zero();
+        t.then_the_range_has_been_read(4050, 100);
+        t.then_the_digest_matches_the_range(4050, 100);
+    }
+}
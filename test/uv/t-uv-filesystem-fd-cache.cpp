@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <vfs/fd-cache-filesystem.hpp>
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    using fd_cache_filesystem = vfs::fd_cache_filesystem<vfs::uv::_uv_path_t, vfs::uv::_uv_stat_t,
+                                                         vfs::uv::_uv_file_t, vfs::uv::_uv_buf_t>;
+
+    class t_fd_cache :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        fd_cache_filesystem _fs {_uv_fs, 2};
+
+        std::vector<fd_cache_filesystem::file_handle> _handles;
+        std::vector<uint64_t> _fds;
+        std::string _read_result;
+
+        // </editor-fold>
+
+        void set_path(const std::string &name)
+        {
+            _path.clear()
+                .append(_mount.path())
+                .append(name);
+        }
+
+      public:
+
+        ~t_fd_cache()
+        {
+            _handles.clear();
+            _fs.clear();
+            _uv_fs.loop().run();
+        }
+
+        // <editor-fold name="Given">
+
+        void given_files(std::initializer_list<std::string> names)
+        {
+            for (auto &name : names)
+            {
+                set_path(name);
+                write_file(_path, name);
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_acquired(const std::string &name, bool keep = false)
+        {
+            set_path(name);
+
+            _error_result = -1;
+
+            _result = _fs.acquire(_path, O_RDONLY, [this, keep](vfs::any_path &, int err,
+                                                                fd_cache_filesystem::file_handle &handle)
+            {
+                _error_result = err;
+
+                if (err == 0)
+                {
+                    _fds.push_back(handle.file().fd());
+
+                    if (keep)
+                    {
+                        _handles.push_back(std::move(handle));
+                    }
+                }
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_acquired_twice_concurrently(const std::string &name)
+        {
+            set_path(name);
+
+            for (int i = 0; i < 2; ++i)
+            {
+                _result = _fs.acquire(_path, O_RDONLY, [this](vfs::any_path &, int err,
+                                                              fd_cache_filesystem::file_handle &handle)
+                {
+                    _error_result = err;
+
+                    _fds.push_back(handle.file().fd());
+                });
+            }
+
+            _uv_fs.loop().run();
+        }
+
+        void when_acquired_and_read(const std::string &name)
+        {
+            set_path(name);
+
+            _result = _fs.acquire(_path, O_RDONLY, [this](vfs::any_path &, int err,
+                                                          fd_cache_filesystem::file_handle &handle)
+            {
+                _error_result = err;
+
+                auto file = handle.file();
+
+                _fs.read(file, vfs::buffer {64}, 0,
+                         [this, handle = std::move(handle)](vfs::uv::_uv_file_t &, int err, vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+                });
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_handles_are_released()
+        {
+            _handles.clear();
+        }
+
+        void when_the_file_is_unlinked(const std::string &name)
+        {
+            set_path(name);
+
+            _result = _fs.unlink(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_stats_are(uint64_t hits, uint64_t misses, uint64_t evictions)
+        {
+            auto stats = _fs.stats();
+
+            ASSERT_EQ(hits, stats.hits);
+            ASSERT_EQ(misses, stats.misses);
+            ASSERT_EQ(evictions, stats.evictions);
+        }
+
+        void then_open_fds_are(std::size_t open, std::size_t idle)
+        {
+            ASSERT_EQ(open, _fs.stats().open);
+            ASSERT_EQ(idle, _fs.stats().idle);
+        }
+
+        void then_the_same_fd_was_reused()
+        {
+            ASSERT_EQ(2, _fds.size());
+            ASSERT_EQ(_fds[0], _fds[1]);
+        }
+
+        void then_the_content_is(const std::string &expected)
+        {
+            ASSERT_EQ(expected, _read_result);
+        }
+
+        void then_a_moved_from_handle_is_empty()
+        {
+            ASSERT_FALSE(_handles.empty());
+
+            auto handle = std::move(_handles.front());
+
+            ASSERT_TRUE(static_cast<bool>(handle));
+            ASSERT_FALSE(static_cast<bool>(_handles.front()));
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_fd_cache, it_should_reuse_an_idle_descriptor)
+    {
+        t_fd_cache t;
+
+        t.given_files({"object"});
+
+        t.when_acquired("object");
+        t.when_acquired_and_read("object");
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_is("object");
+        t.then_the_stats_are(1, 1, 0);
+        t.then_open_fds_are(1, 1);
+    }
+
+    TEST(uv_filesystem_fd_cache, it_should_coalesce_concurrent_opens)
+    {
+        t_fd_cache t;
+
+        t.given_files({"object"});
+
+        t.when_acquired_twice_concurrently("object");
+
+        t.then_error_result_is_zero();
+        t.then_the_same_fd_was_reused();
+        t.then_the_stats_are(1, 1, 0);
+    }
+
+    TEST(uv_filesystem_fd_cache, it_should_evict_the_least_recently_used_descriptor)
+    {
+        t_fd_cache t;
+
+        t.given_files({"a", "b", "c"});
+
+        t.when_acquired("a");
+        t.when_acquired("b");
+        t.when_acquired("a");
+        t.when_acquired("c");
+        t.when_acquired("a");
+        t.when_acquired("b");
+
+        t.then_the_stats_are(2, 4, 2);
+        t.then_open_fds_are(2, 2);
+    }
+
+    TEST(uv_filesystem_fd_cache, it_should_trim_to_the_budget_once_handles_are_released)
+    {
+        t_fd_cache t;
+
+        t.given_files({"a", "b", "c"});
+
+        t.when_acquired("a", true);
+        t.when_acquired("b", true);
+        t.when_acquired("c", true);
+
+        t.then_open_fds_are(3, 0);
+        t.then_a_moved_from_handle_is_empty();
+
+        t.when_the_handles_are_released();
+
+        t.then_open_fds_are(2, 2);
+        t.then_the_stats_are(0, 3, 1);
+    }
+
+    TEST(uv_filesystem_fd_cache, it_should_invalidate_on_unlink)
+    {
+        t_fd_cache t;
+
+        t.given_files({"object"});
+
+        t.when_acquired("object");
+        t.when_the_file_is_unlinked("object");
+
+        t.then_error_result_is_zero();
+        t.then_open_fds_are(0, 0);
+
+        t.when_acquired("object");
+
+        t.then_error_result_is_enoent();
+        t.then_the_stats_are(0, 2, 0);
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    static_assert(std::is_same<decltype(std::declval<vfs::mapped_slice &>().data()), const uint8_t *>::value,
+                  "mapped views must not expose writable pointers into a PROT_READ mapping");
+
+    class t_map :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::string _content;
+
+        vfs::mapped_slice _view;
+        vfs::mapped_slice _sub_view;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_existing_file_with_content(std::size_t size)
+        {
+            given_an_existing_file();
+
+            _content.resize(size);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                _content[i] = static_cast<char>('a' + i % 26);
+            }
+
+            write_file(_path, _content);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_it_is_mapped(uint64_t off, uint64_t len, int32_t flags)
+        {
+            _result = _uv_fs.map(open_file(_path, O_RDONLY), off, len, flags,
+                                 [this](vfs::uv::_uv_file_t &, int err, vfs::mapped_slice &view)
+            {
+                _error_result = err;
+                _view = view;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_view_is_sliced_and_released(uint64_t off, uint64_t len)
+        {
+            _sub_view = _view.slice(off, len);
+            _view = vfs::mapped_slice {};
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_view_has_the_range(uint64_t off, uint64_t len)
+        {
+            ASSERT_EQ(_content.substr(off, len), std::string(_view.begin(), _view.end()));
+        }
+
+        void then_the_sub_view_is_still_mapped(uint64_t off, uint64_t len)
+        {
+            ASSERT_EQ(1, _sub_view.use_count());
+            ASSERT_EQ(_content.substr(off, len), std::string(_sub_view.begin(), _sub_view.end()));
+        }
+
+        void then_the_error_result_is_einval()
+        {
+            ASSERT_EQ(EINVAL, _error_result);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_map, it_should_map_an_unaligned_range)
+    {
+        t_map t;
+
+        t.given_an_existing_file_with_content(20000);
+
+        t.when_it_is_mapped(5000, 9000, vfs::map_populate | vfs::map_sequential);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_view_has_the_range(5000, 9000);
+    }
+
+    TEST(uv_filesystem_map, it_should_map_up_to_the_end_of_file)
+    {
+        t_map t;
+
+        t.given_an_existing_file_with_content(10000);
+
+        t.when_it_is_mapped(4096, 0, vfs::map_willneed);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_view_has_the_range(4096, 10000 - 4096);
+    }
+
+    TEST(uv_filesystem_map, it_should_keep_the_mapping_while_a_view_is_alive)
+    {
+        t_map t;
+
+        t.given_an_existing_file_with_content(10000);
+
+        t.when_it_is_mapped(0, 10000, vfs::map_random);
+        t.when_the_view_is_sliced_and_released(8000, 100);
+
+        t.then_the_sub_view_is_still_mapped(8000, 100);
+    }
+
+    TEST(uv_filesystem_map, it_should_return_einval_past_the_end_of_file)
+    {
+        t_map t;
+
+        t.given_an_existing_file_with_content(100);
+
+        t.when_it_is_mapped(4096, 10, vfs::map_default);
+
+        t.then_result_is_zero();
+        t.then_the_error_result_is_einval();
+    }
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_mkdirs :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::uv::uv_worker_pool> _pool;
+
+        vfs::uv::uv_dir_cache_stats _cache_stats;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_worker_pool()
+        {
+            _pool = std::make_unique<vfs::uv::uv_worker_pool>();
+
+            _uv_fs.use_worker_pool(*_pool);
+        }
+
+        void given_a_nested_unexisting_path()
+        {
+            _path.clear()
+                .append(_mount.path())
+                .append("a")
+                .append("b")
+                .append("c");
+        }
+
+        void given_a_nested_path_below_an_existing_file()
+        {
+            given_an_existing_file();
+
+            _path.append("b");
+        }
+
+        void given_a_cached_sibling_tree()
+        {
+            given_a_nested_unexisting_path();
+
+            when_mkdirs_is_invoked();
+
+            _path.clear()
+                .append(_mount.path())
+                .append("a")
+                .append("b")
+                .append("d");
+        }
+
+        void given_a_cached_tree_removed_behind_the_cache()
+        {
+            given_a_nested_unexisting_path();
+
+            when_mkdirs_is_invoked();
+
+            auto cmd = "rm -rf " + _mount.path() + "/a";
+
+            ASSERT_EQ(0, system(cmd.c_str()));
+
+            _path.append("d").append("e");
+        }
+
+        void given_a_cached_dir_replaced_by_a_file()
+        {
+            given_a_nested_unexisting_path();
+
+            when_mkdirs_is_invoked();
+
+            ASSERT_EQ(0, ::rmdir(_path.c_str()));
+
+            create_file(_path);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_mkdirs_is_invoked()
+        {
+            _result = _uv_fs.mkdirs(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+
+            _cache_stats = _uv_fs.dir_cache().stats();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_path_is_a_directory()
+        {
+            struct stat64 stat;
+
+            ASSERT_EQ(0, stat64(_path.str().c_str(), &stat));
+            ASSERT_TRUE(S_ISDIR(stat.st_mode));
+        }
+
+        void then_error_result_is_enotdir()
+        {
+            ASSERT_EQ(ENOTDIR, _error_result);
+        }
+
+        void then_created_levels_are_cached()
+        {
+            ASSERT_LE(3, _cache_stats.size);
+        }
+
+        void then_the_cache_was_hit()
+        {
+            ASSERT_LE(1, _cache_stats.hits);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_mkdirs, it_should_create_missing_levels)
+    {
+        t_mkdirs t;
+
+        t.given_a_nested_unexisting_path();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_directory();
+        t.then_created_levels_are_cached();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_succeed_when_directory_already_exists)
+    {
+        t_mkdirs t;
+
+        t.given_an_existing_dir();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_directory();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_return_eexist_when_path_is_a_file)
+    {
+        t_mkdirs t;
+
+        t.given_an_existing_file();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_eexist();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_return_enotdir_when_a_level_is_a_file)
+    {
+        t_mkdirs t;
+
+        t.given_a_nested_path_below_an_existing_file();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_enotdir();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_reuse_cached_prefixes)
+    {
+        t_mkdirs t;
+
+        t.given_a_cached_sibling_tree();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_directory();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_recover_from_stale_cached_prefixes)
+    {
+        t_mkdirs t;
+
+        t.given_a_cached_tree_removed_behind_the_cache();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_directory();
+        t.then_the_cache_was_hit();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_return_eexist_when_a_cached_dir_became_a_file)
+    {
+        t_mkdirs t;
+
+        t.given_a_cached_dir_replaced_by_a_file();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_eexist();
+    }
+
+    TEST(uv_filesystem_mkdirs, it_should_create_missing_levels_on_the_worker_pool)
+    {
+        t_mkdirs t;
+
+        t.given_a_worker_pool();
+        t.given_a_nested_unexisting_path();
+
+        t.when_mkdirs_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_path_is_a_directory();
+    }
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_readdir :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::vector<std::size_t> _batch_sizes;
+        std::vector<std::string> _names;
+        std::vector<uint64_t> _inodes;
+        std::vector<uint8_t> _types;
+        uint64_t _cursor = 0;
+        bool _eof = false;
+
+        // </editor-fold>
+
+        void set_path(const std::string &name)
+        {
+            _path.clear()
+                .append(_mount.path())
+                .append(name);
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_dir_with_files(std::initializer_list<std::string> names)
+        {
+            set_path("dir");
+            create_dir(_path);
+
+            for (auto &name : names)
+            {
+                set_path("dir/" + name);
+                write_file(_path, name);
+            }
+
+            set_path("dir");
+        }
+
+        void given_a_sub_dir(const std::string &name)
+        {
+            set_path("dir/" + name);
+            create_dir(_path);
+            set_path("dir");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_readdir_is_invoked(std::size_t batch_size, std::size_t max_batches = SIZE_MAX,
+                                     uint64_t cursor = 0)
+        {
+            _error_result = -1;
+
+            _result = _uv_fs.readdir(_path, batch_size, cursor, [this, max_batches](vfs::any_path &, int err,
+                                                                                      vfs::dir_batch &batch)
+            {
+                _error_result = err;
+                _batch_sizes.push_back(batch.size());
+                _cursor = batch.cursor();
+                _eof = batch.eof();
+
+                for (auto &entry : batch)
+                {
+                    _names.emplace_back(entry.name);
+                    _inodes.push_back(entry.inode);
+                    _types.push_back(entry.type);
+                }
+
+                return _batch_sizes.size() < max_batches;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_readdir_is_resumed(std::size_t batch_size)
+        {
+            _batch_sizes.clear();
+
+            when_readdir_is_invoked(batch_size, SIZE_MAX, _cursor);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_names_are(std::set<std::string> expected)
+        {
+            std::set<std::string> names {_names.begin(), _names.end()};
+
+            ASSERT_EQ(expected.size(), _names.size());
+            ASSERT_EQ(expected, names);
+        }
+
+        void then_no_batch_exceeds(std::size_t batch_size)
+        {
+            ASSERT_FALSE(_batch_sizes.empty());
+
+            for (auto size : _batch_sizes)
+            {
+                ASSERT_LE(size, batch_size);
+            }
+        }
+
+        void then_the_stream_ended()
+        {
+            ASSERT_TRUE(_eof);
+        }
+
+        void then_batches_were_delivered(std::size_t expected)
+        {
+            ASSERT_EQ(expected, _batch_sizes.size());
+        }
+
+        void then_entries_were_read(std::size_t expected)
+        {
+            ASSERT_EQ(expected, _names.size());
+        }
+
+        void then_the_inodes_match_stat()
+        {
+            for (std::size_t i = 0; i < _names.size(); ++i)
+            {
+                struct stat st {};
+
+                ASSERT_EQ(0, ::stat((_path.str() + "/" + _names[i]).c_str(), &st));
+                ASSERT_EQ(st.st_ino, _inodes[i]);
+            }
+        }
+
+        void then_the_entry_has_type(const std::string &name, uint8_t type)
+        {
+            auto it = std::find(_names.begin(), _names.end(), name);
+
+            ASSERT_NE(_names.end(), it);
+            ASSERT_EQ(type, _types[it - _names.begin()]);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_readdir, it_should_stream_entries_in_batches)
+    {
+        t_readdir t;
+
+        t.given_a_dir_with_files({"a", "b", "c", "d", "e"});
+
+        t.when_readdir_is_invoked(2);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_names_are({"a", "b", "c", "d", "e"});
+        t.then_no_batch_exceeds(2);
+        t.then_the_stream_ended();
+        t.then_the_inodes_match_stat();
+    }
+
+    TEST(uv_filesystem_readdir, it_should_report_entry_types)
+    {
+        t_readdir t;
+
+        t.given_a_dir_with_files({"file"});
+        t.given_a_sub_dir("sub");
+
+        t.when_readdir_is_invoked(16);
+
+        t.then_the_names_are({"file", "sub"});
+        t.then_the_entry_has_type("file", DT_REG);
+        t.then_the_entry_has_type("sub", DT_DIR);
+    }
+
+    TEST(uv_filesystem_readdir, it_should_stop_when_the_callback_declines)
+    {
+        t_readdir t;
+
+        t.given_a_dir_with_files({"a", "b", "c", "d", "e"});
+
+        t.when_readdir_is_invoked(2, 1);
+
+        t.then_error_result_is_zero();
+        t.then_batches_were_delivered(1);
+        t.then_entries_were_read(2);
+    }
+
+    TEST(uv_filesystem_readdir, it_should_resume_from_a_cursor)
+    {
+        t_readdir t;
+
+        t.given_a_dir_with_files({"a", "b", "c", "d", "e"});
+
+        t.when_readdir_is_invoked(2, 1);
+        t.when_readdir_is_resumed(2);
+
+        t.then_error_result_is_zero();
+        t.then_the_names_are({"a", "b", "c", "d", "e"});
+        t.then_the_stream_ended();
+    }
+
+    TEST(uv_filesystem_readdir, it_should_fail_on_a_missing_dir)
+    {
+        t_readdir t;
+
+        t.given_an_unexisting_path();
+
+        t.when_readdir_is_invoked(2);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_enoent();
+        t.then_batches_were_delivered(1);
+    }
+}
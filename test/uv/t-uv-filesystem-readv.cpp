@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_readv :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::uv::_uv_file_t _file {_path};
+        std::vector<vfs::buffer> _bufs;
+
+        std::vector<std::string> _bufs_result;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_existing_file_with_header_payload_and_trailer()
+        {
+            given_an_existing_file();
+
+            write_file(_path, "HEAD" "payload-data" "TR");
+        }
+
+        void given_the_file_is_open()
+        {
+            _file = open_file(_path, O_RDONLY);
+        }
+
+        void given_buffers_for_header_payload_and_trailer()
+        {
+            _bufs.emplace_back(4);
+            _bufs.emplace_back(12);
+            _bufs.emplace_back(8);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_readv_is_invoked()
+        {
+            _result = _uv_fs.readv(_file, std::move(_bufs), 0, [this](vfs::uv::_uv_file_t &, int err,
+                                                                       std::vector<vfs::buffer> &bufs)
+            {
+                _error_result = err;
+
+                for (auto &buf : bufs)
+                {
+                    _bufs_result.emplace_back(buf.begin(), buf.end());
+                }
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_each_buffer_has_been_filled_in_order()
+        {
+            ASSERT_EQ(3, _bufs_result.size());
+            ASSERT_EQ("HEAD", _bufs_result[0]);
+            ASSERT_EQ("payload-data", _bufs_result[1]);
+            ASSERT_EQ("TR", _bufs_result[2]);
+        }
+
+        void then_the_buffers_are_empty()
+        {
+            ASSERT_EQ(3, _bufs_result.size());
+            ASSERT_TRUE(_bufs_result[0].empty());
+            ASSERT_TRUE(_bufs_result[1].empty());
+            ASSERT_TRUE(_bufs_result[2].empty());
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_readv, it_should_scatter_the_file_into_the_buffers)
+    {
+        t_readv t;
+
+        t.given_an_existing_file_with_header_payload_and_trailer();
+        t.given_the_file_is_open();
+        t.given_buffers_for_header_payload_and_trailer();
+
+        t.when_readv_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+
+        t.then_each_buffer_has_been_filled_in_order();
+    }
+
+    TEST(uv_filesystem_readv, it_should_return_empty_buffers_when_file_is_empty)
+    {
+        t_readv t;
+
+        t.given_an_existing_file();
+        t.given_the_file_is_open();
+        t.given_buffers_for_header_payload_and_trailer();
+
+        t.when_readv_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+
+        t.then_the_buffers_are_empty();
+    }
+}
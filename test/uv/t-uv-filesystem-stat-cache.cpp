@@ -0,0 +1,697 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <vfs/uv/uv-stat-cache-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_stat_cache :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        uint64_t _now = 0;
+
+        vfs::uv::uv_stat_cache_filesystem _fs {_uv_fs, 2, 1000, [this]()
+        {
+            return _now;
+        }};
+
+        vfs::uv::uv_stat _stat_result;
+        bool _exists = false;
+        bool _called = false;
+
+        vfs::uv::_uv_file_t _file {_path};
+        bool _open = false;
+
+        vfs::unix_path _watched;
+
+        // </editor-fold>
+
+        static vfs::buffer make_buffer(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            return buf;
+        }
+
+        void set_path(const std::string &name)
+        {
+            _path.clear()
+                .append(_mount.path())
+                .append(name);
+        }
+
+      public:
+
+        ~t_stat_cache()
+        {
+            if (_open)
+            {
+                ::close(_file.uv_fd());
+            }
+
+            if (!_watched.view().empty())
+            {
+                _fs.unwatch(vfs::any_path {_watched});
+                _uv_fs.loop().run(UV_RUN_NOWAIT);
+            }
+        }
+
+        // <editor-fold name="Given">
+
+        void given_files(std::initializer_list<std::string> names)
+        {
+            for (auto &name : names)
+            {
+                set_path(name);
+                write_file(_path, name);
+            }
+
+            set_path(*names.begin());
+        }
+
+        void given_the_dir_is_watched()
+        {
+            _watched.append(_mount.path());
+
+            ASSERT_EQ(0, _fs.watch(vfs::any_path {_watched}));
+        }
+
+        void given_the_file_is_opened_through_the_cache()
+        {
+            _result = _fs.open(_path, 0, O_RDWR, [this](vfs::any_path &, int err, vfs::uv::_uv_file_t &file)
+            {
+                _error_result = err;
+                _file = vfs::uv::_uv_file_t {_path, file.uv_fd()};
+                _open = err == 0;
+            });
+
+            _uv_fs.loop().run();
+
+            ASSERT_TRUE(_open);
+        }
+
+        void given_a_dir_with_files(const std::string &dir, std::initializer_list<std::string> names)
+        {
+            set_path(dir);
+            create_dir(_path);
+
+            for (auto &name : names)
+            {
+                set_path(dir + "/" + name);
+                write_file(_path, name);
+            }
+        }
+
+        void given_the_filter_is_enabled(std::size_t expected = 100)
+        {
+            ASSERT_EQ(0, _fs.enable_filter(_mount.path(), expected));
+
+            _uv_fs.loop().run();
+
+            ASSERT_NE(nullptr, _fs.filter());
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_the_filter_is_enabled_without_running_the_loop()
+        {
+            _result = _fs.enable_filter(_mount.path(), 100);
+        }
+
+        void when_the_loop_runs()
+        {
+            _uv_fs.loop().run();
+        }
+
+        void when_stat_is_invoked()
+        {
+            _error_result = -1;
+
+            _result = _fs.stat(_path, [this](vfs::any_path &, int err, vfs::uv::uv_stat stat)
+            {
+                _error_result = err;
+                _stat_result = stat;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_stat_is_invoked_on(const std::string &name)
+        {
+            set_path(name);
+
+            when_stat_is_invoked();
+        }
+
+        void when_exists_is_invoked()
+        {
+            _error_result = -1;
+            _called = false;
+
+            _result = _fs.exists(_path, [this](vfs::any_path &, int err, bool exists)
+            {
+                _error_result = err;
+                _exists = exists;
+                _called = true;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_exists_is_invoked_on(const std::string &name)
+        {
+            set_path(name);
+
+            when_exists_is_invoked();
+        }
+
+        void when_exists_is_invoked_without_running_the_loop_on(const std::string &name)
+        {
+            set_path(name);
+
+            _called = false;
+
+            _result = _fs.exists(_path, [this](vfs::any_path &, int err, bool exists)
+            {
+                _error_result = err;
+                _exists = exists;
+                _called = true;
+            });
+        }
+
+        void when_the_file_is_created(const std::string &name)
+        {
+            set_path(name);
+
+            _result = _fs.create(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_path_is_moved(const std::string &from, const std::string &to)
+        {
+            set_path(to);
+
+            vfs::unix_path to_path;
+            to_path.append(_path.view());
+
+            set_path(from);
+
+            _result = _fs.move(_path, vfs::any_path {to_path}, [this](vfs::any_path &, vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_unlinked()
+        {
+            _result = _fs.unlink(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_written_through_the_cache(const std::string &content)
+        {
+            _result = _fs.write(_file, make_buffer(content), 0, [this](vfs::uv::_uv_file_t &, int err,
+                                                                       vfs::buffer &)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_written_with_writev(const std::string &first, const std::string &second)
+        {
+            std::vector<vfs::buffer> bufs;
+
+            bufs.push_back(make_buffer(first));
+            bufs.push_back(make_buffer(second));
+
+            _result = _fs.writev(_file, std::move(bufs), 0, [this](vfs::uv::_uv_file_t &, int err,
+                                                                   std::vector<vfs::buffer> &)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_truncated(uint64_t size)
+        {
+            _result = _fs.truncate(_file, size, [this](vfs::uv::_uv_file_t &, int err, uint64_t)
+            {
+                _error_result = err;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_closed()
+        {
+            _result = _fs.close(_file, [this](vfs::uv::_uv_file_t &, int err)
+            {
+                _error_result = err;
+                _open = false;
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_file_is_unlinked_on(const std::string &name)
+        {
+            set_path(name);
+
+            when_the_file_is_unlinked();
+        }
+
+        void when_time_passes(uint64_t ms)
+        {
+            _now += ms;
+        }
+
+        void when_the_file_is_changed_externally(const std::string &content)
+        {
+            uv_timer_t timeout;
+
+            uv_timer_init(_uv_fs.loop(), &timeout);
+            uv_timer_start(&timeout, [](uv_timer_t *)
+            {}, 1000, 0);
+
+            write_file(_path, content);
+
+            while (_fs.stats().invalidations == 0 && uv_is_active(reinterpret_cast<uv_handle_t *>(&timeout)))
+            {
+                _uv_fs.loop().run(UV_RUN_ONCE);
+            }
+
+            uv_close(reinterpret_cast<uv_handle_t *>(&timeout), nullptr);
+
+            _uv_fs.loop().run(UV_RUN_NOWAIT);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_stats_are(uint64_t hits, uint64_t misses)
+        {
+            auto stats = _fs.stats();
+
+            ASSERT_EQ(hits, stats.hits);
+            ASSERT_EQ(misses, stats.misses);
+        }
+
+        void then_the_hit_rate_is(double expected)
+        {
+            ASSERT_DOUBLE_EQ(expected, _fs.stats().hit_rate());
+        }
+
+        void then_entries_expired(uint64_t expected)
+        {
+            ASSERT_EQ(expected, _fs.stats().expirations);
+        }
+
+        void then_entries_were_evicted(uint64_t expected)
+        {
+            ASSERT_EQ(expected, _fs.stats().evictions);
+            ASSERT_EQ(2, _fs.stats().size);
+        }
+
+        void then_the_size_is(uint64_t expected)
+        {
+            ASSERT_EQ(expected, _stat_result.size());
+        }
+
+        void then_the_path_does_not_exist()
+        {
+            ASSERT_FALSE(_exists);
+        }
+
+        void then_the_path_exists()
+        {
+            ASSERT_TRUE(_exists);
+        }
+
+        void then_the_callback_was_invoked_synchronously()
+        {
+            ASSERT_TRUE(_called);
+        }
+
+        void then_the_callback_was_not_invoked()
+        {
+            ASSERT_FALSE(_called);
+        }
+
+        void then_the_filter_is_not_built()
+        {
+            ASSERT_EQ(nullptr, _fs.filter());
+        }
+
+        void then_the_filter_is_built()
+        {
+            ASSERT_NE(nullptr, _fs.filter());
+        }
+
+        void then_nothing_was_erased_from_the_filter()
+        {
+            ASSERT_NE(nullptr, _fs.filter());
+            ASSERT_EQ(0, _fs.filter()->stats().erases);
+        }
+
+        void then_the_negative_stats_are(uint64_t negative_hits, uint64_t filter_rejections)
+        {
+            auto stats = _fs.stats();
+
+            ASSERT_EQ(negative_hits, stats.negative_hits);
+            ASSERT_EQ(filter_rejections, stats.filter_rejections);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_stat_cache, it_should_serve_repeated_stats_from_the_cache)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+
+        t.when_stat_is_invoked();
+        t.when_stat_is_invoked();
+        t.when_exists_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_size_is(6);
+        t.then_the_stats_are(2, 1);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_expire_entries_after_the_ttl)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+
+        t.when_stat_is_invoked();
+        t.when_time_passes(1000);
+        t.when_stat_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_entries_expired(1);
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_evict_the_least_recently_used_entry)
+    {
+        t_stat_cache t;
+
+        t.given_files({"a", "b", "c"});
+
+        t.when_stat_is_invoked_on("a");
+        t.when_stat_is_invoked_on("b");
+        t.when_stat_is_invoked_on("a");
+        t.when_stat_is_invoked_on("c");
+        t.when_stat_is_invoked_on("a");
+        t.when_stat_is_invoked_on("b");
+
+        t.then_entries_were_evicted(2);
+        t.then_the_stats_are(2, 4);
+        t.then_the_hit_rate_is(2.0 / 6.0);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_on_unlink)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_unlinked();
+        t.when_exists_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_the_path_does_not_exist();
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_on_write)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+        t.given_the_file_is_opened_through_the_cache();
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_written_through_the_cache("a longer object");
+        t.when_stat_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_the_size_is(15);
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_on_writev)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+        t.given_the_file_is_opened_through_the_cache();
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_written_with_writev("a longer", " object");
+        t.when_stat_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_the_size_is(15);
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_on_truncate)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+        t.given_the_file_is_opened_through_the_cache();
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_truncated(3);
+        t.when_stat_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_the_size_is(3);
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_on_close)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+        t.given_the_file_is_opened_through_the_cache();
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_closed();
+        t.when_stat_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_the_size_is(6);
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_on_watched_dir_events)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+        t.given_the_dir_is_watched();
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_changed_externally("a longer object");
+        t.when_stat_is_invoked();
+
+        t.then_error_result_is_zero();
+        t.then_the_size_is(15);
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_cache_negative_lookups_until_the_path_is_created)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+
+        t.when_exists_is_invoked_on("missing");
+        t.when_exists_is_invoked_on("missing");
+
+        t.then_the_path_does_not_exist();
+        t.then_the_negative_stats_are(1, 0);
+
+        t.when_the_file_is_created("missing");
+        t.when_exists_is_invoked_on("missing");
+
+        t.then_error_result_is_zero();
+        t.then_the_path_exists();
+        t.then_the_stats_are(0, 2);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_answer_definite_misses_from_the_filter)
+    {
+        t_stat_cache t;
+
+        t.given_files({"a", "b"});
+        t.given_the_filter_is_enabled();
+
+        t.when_exists_is_invoked_without_running_the_loop_on("missing");
+
+        t.then_the_callback_was_invoked_synchronously();
+        t.then_error_result_is_zero();
+        t.then_the_path_does_not_exist();
+        t.then_the_negative_stats_are(0, 1);
+
+        t.when_exists_is_invoked_on("a");
+
+        t.then_the_path_exists();
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_keep_the_filter_current_on_create_and_unlink)
+    {
+        t_stat_cache t;
+
+        t.given_files({"a"});
+        t.given_the_filter_is_enabled();
+
+        t.when_the_file_is_created("new");
+        t.when_exists_is_invoked_on("new");
+
+        t.then_the_path_exists();
+
+        t.when_the_file_is_unlinked();
+        t.when_exists_is_invoked();
+
+        t.then_the_path_does_not_exist();
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_rescan_the_filter_on_move)
+    {
+        t_stat_cache t;
+
+        t.given_a_dir_with_files("dir", {"a", "b"});
+        t.given_the_filter_is_enabled();
+
+        t.when_the_path_is_moved("dir", "moved");
+        t.when_exists_is_invoked_on("moved/b");
+
+        t.then_error_result_is_zero();
+        t.then_the_path_exists();
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_not_erase_paths_it_never_admitted_from_the_filter)
+    {
+        t_stat_cache t;
+
+        t.given_files({"a"});
+        t.given_the_filter_is_enabled();
+        t.given_files({"external"});
+
+        t.when_the_file_is_unlinked();
+        t.when_exists_is_invoked_on("a");
+
+        t.then_error_result_is_zero();
+        t.then_the_path_exists();
+        t.then_nothing_was_erased_from_the_filter();
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_rebuild_the_filter_after_enough_unlinks)
+    {
+        t_stat_cache t;
+
+        t.given_files({"a", "b"});
+        t.given_the_filter_is_enabled(4);
+
+        t.when_the_file_is_unlinked_on("a");
+        t.when_the_file_is_unlinked_on("b");
+        t.when_exists_is_invoked_without_running_the_loop_on("a");
+
+        t.then_the_callback_was_invoked_synchronously();
+        t.then_the_path_does_not_exist();
+        t.then_the_negative_stats_are(0, 1);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_not_reject_other_spellings_of_existing_paths)
+    {
+        t_stat_cache t;
+
+        t.given_a_dir_with_files("dir", {"a"});
+        t.given_the_filter_is_enabled();
+
+        t.when_exists_is_invoked_on("dir//a");
+
+        t.then_error_result_is_zero();
+        t.then_the_path_exists();
+
+        t.when_exists_is_invoked_on("dir/./a");
+
+        t.then_the_path_exists();
+
+        t.when_exists_is_invoked_on("dir/");
+
+        t.then_the_path_exists();
+        t.then_the_negative_stats_are(0, 0);
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_invalidate_through_other_spellings)
+    {
+        t_stat_cache t;
+
+        t.given_files({"object"});
+
+        t.when_stat_is_invoked();
+        t.when_the_file_is_unlinked_on("./object");
+        t.when_exists_is_invoked_on("object");
+
+        t.then_error_result_is_zero();
+        t.then_the_path_does_not_exist();
+    }
+
+    TEST(uv_filesystem_stat_cache, it_should_not_answer_from_the_filter_until_it_is_built)
+    {
+        t_stat_cache t;
+
+        t.given_files({"a"});
+
+        t.when_the_filter_is_enabled_without_running_the_loop();
+        t.when_exists_is_invoked_without_running_the_loop_on("missing");
+
+        t.then_result_is_zero();
+        t.then_the_filter_is_not_built();
+        t.then_the_callback_was_not_invoked();
+
+        t.when_the_loop_runs();
+
+        t.then_the_filter_is_built();
+        t.then_the_path_does_not_exist();
+        t.then_the_negative_stats_are(0, 0);
+    }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+
+namespace
+{
+    template<typename t_path>
+    class t_static_path
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::test::tmpfs_mount _mount;
+        vfs::uv::basic_uv_filesystem<t_path> _uv_fs;
+
+        t_path _path;
+
+        int _result = 0;
+        int _error_result = -1;
+        bool _exists = false;
+        std::string _read_result;
+
+        // </editor-fold>
+
+        static vfs::buffer make_buffer(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            return buf;
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_an_object_path()
+        {
+            _path.clear()
+                .append(_mount.path())
+                .append("bucket-object");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_it_is_created()
+        {
+            _result = _uv_fs.create(_path, [this](t_path &, int err)
+            {
+                _error_result = err;
+
+                _uv_fs.exists(_path, [this](t_path &, int, bool exists)
+                {
+                    _exists = exists;
+                });
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_it_is_written_and_read_back(const std::string &content)
+        {
+            using file_type = typename vfs::uv::basic_uv_filesystem<t_path>::file_type;
+
+            _result = _uv_fs.open(_path, O_RDWR | O_CREAT, [this, content](t_path &, int err, file_type &file)
+            {
+                _error_result = err;
+
+                _uv_fs.write(file, make_buffer(content), 0, [this](file_type &file, int err, vfs::buffer &)
+                {
+                    _error_result = err;
+
+                    _uv_fs.read(file, vfs::buffer {64}, 0, [this](file_type &file, int err, vfs::buffer &buf)
+                    {
+                        _error_result = err;
+                        _read_result = std::string {buf.begin(), buf.end()};
+
+                        _uv_fs.close(file, [](file_type &, int)
+                        {});
+                    });
+                });
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_result_is_zero()
+        {
+            ASSERT_EQ(0, _result);
+        }
+
+        void then_error_result_is_zero()
+        {
+            ASSERT_EQ(0, _error_result);
+        }
+
+        void then_the_path_exists()
+        {
+            ASSERT_TRUE(_exists);
+        }
+
+        void then_the_content_is(const std::string &content)
+        {
+            ASSERT_EQ(content, _read_result);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_static_path, it_should_create_through_a_small_path)
+    {
+        t_static_path<vfs::unix_small_path> t;
+
+        t.given_an_object_path();
+
+        t.when_it_is_created();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_path_exists();
+    }
+
+    TEST(uv_filesystem_static_path, it_should_read_and_write_through_a_unix_path)
+    {
+        t_static_path<vfs::unix_path> t;
+
+        t.given_an_object_path();
+
+        t.when_it_is_written_and_read_back("statically-dispatched");
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_is("statically-dispatched");
+    }
+}
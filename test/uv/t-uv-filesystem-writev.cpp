@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <uv.h>
+
+#include "../include/t-tmpfs-mount.hpp"
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_writev :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        vfs::uv::_uv_file_t _file {_path};
+        std::vector<vfs::buffer> _bufs;
+
+        std::vector<uint64_t> _sizes_result;
+
+        // </editor-fold>
+
+        void add_buffer(const std::string &content)
+        {
+            vfs::buffer buf {content.size() + 1};
+
+            buf.put(content.data(), content.size());
+
+            _bufs.push_back(std::move(buf));
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_the_file_is_open()
+        {
+            _file = open_file(_path, O_WRONLY);
+        }
+
+        void given_buffers_with_header_payload_and_trailer()
+        {
+            add_buffer("HEAD");
+            add_buffer("payload-data");
+            add_buffer("TR");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_writev_is_invoked()
+        {
+            _result = _uv_fs.writev(_file, std::move(_bufs), 0, [this](vfs::uv::_uv_file_t &, int err,
+                                                                        std::vector<vfs::buffer> &bufs)
+            {
+                _error_result = err;
+
+                for (auto &buf : bufs)
+                {
+                    _sizes_result.push_back(buf.size());
+                }
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_buffers_have_been_gathered_into_the_file()
+        {
+            ASSERT_EQ("HEAD" "payload-data" "TR", read_file(_path));
+        }
+
+        void then_each_buffer_reports_its_written_size()
+        {
+            ASSERT_EQ(3, _sizes_result.size());
+            ASSERT_EQ(4, _sizes_result[0]);
+            ASSERT_EQ(12, _sizes_result[1]);
+            ASSERT_EQ(2, _sizes_result[2]);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_filesystem_writev, it_should_gather_the_buffers_into_the_file)
+    {
+        t_writev t;
+
+        t.given_an_existing_file();
+        t.given_the_file_is_open();
+        t.given_buffers_with_header_payload_and_trailer();
+
+        t.when_writev_is_invoked();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+
+        t.then_the_buffers_have_been_gathered_into_the_file();
+        t.then_each_buffer_reports_its_written_size();
+    }
+}
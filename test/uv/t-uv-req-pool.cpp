@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <vfs/uv/uv-req-pool.hpp>
+#include <uv.h>
+
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class test
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        struct small_data
+        {
+            uint64_t a;
+            uint64_t b;
+        };
+
+        struct large_data
+        {
+            uint8_t bytes[1024];
+        };
+
+        std::unique_ptr<vfs::uv::uv_req_pool> _pool;
+        std::vector<uv_fs_t *> _reqs;
+
+        // </editor-fold>
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_pool_with_two_slots()
+        {
+            _pool = std::make_unique<vfs::uv::uv_req_pool>(sizeof(small_data), 2);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_small_data_is_acquired(std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                _reqs.push_back(_pool->acquire(small_data {.a = i, .b = i}));
+            }
+        }
+
+        void when_large_data_is_acquired()
+        {
+            _reqs.push_back(_pool->acquire(large_data {}));
+        }
+
+        void when_small_data_is_released()
+        {
+            for (auto req : _reqs)
+            {
+                vfs::uv::uv_req_pool::release<small_data>(req);
+            }
+
+            _reqs.clear();
+        }
+
+        void when_large_data_is_released()
+        {
+            for (auto req : _reqs)
+            {
+                vfs::uv::uv_req_pool::release<large_data>(req);
+            }
+
+            _reqs.clear();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_data_is_stored_in_the_req()
+        {
+            for (std::size_t i = 0; i < _reqs.size(); ++i)
+            {
+                auto data = vfs::uv::get_uv_data<small_data>(_reqs[i]);
+
+                ASSERT_EQ(i, data->a);
+                ASSERT_EQ(i, data->b);
+            }
+        }
+
+        void then_the_stats_are(uint64_t hits, uint64_t misses, uint64_t grows, uint64_t capacity, uint64_t in_use)
+        {
+            auto &stats = _pool->stats();
+
+            ASSERT_EQ(hits, stats.hits);
+            ASSERT_EQ(misses, stats.misses);
+            ASSERT_EQ(grows, stats.grows);
+            ASSERT_EQ(capacity, stats.capacity);
+            ASSERT_EQ(in_use, stats.in_use);
+        }
+
+        // </editor-fold>
+    };
+
+    class t_pooled_stat :
+        public vfs::test::t_uv_filesystem_base
+    {
+      public:
+
+        // <editor-fold name="When">
+
+        void when_stat_is_invoked_sequentially(int n)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                _result = _uv_fs.stat(_path, [this](vfs::any_path &, int err, vfs::uv::uv_stat)
+                {
+                    _error_result = err;
+                });
+
+                _uv_fs.loop().run();
+            }
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_every_req_was_served_by_the_pool(uint64_t n)
+        {
+            auto &stats = _uv_fs.req_pool_stats();
+
+            ASSERT_EQ(n, stats.hits);
+            ASSERT_EQ(0, stats.misses);
+            ASSERT_EQ(0, stats.in_use);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_req_pool, it_should_serve_reqs_from_preallocated_slots)
+    {
+        test t;
+
+        t.given_a_pool_with_two_slots();
+
+        t.when_small_data_is_acquired(2);
+
+        t.then_the_data_is_stored_in_the_req();
+        t.then_the_stats_are(2, 0, 0, 2, 2);
+    }
+
+    TEST(uv_req_pool, it_should_grow_when_all_slots_are_in_use)
+    {
+        test t;
+
+        t.given_a_pool_with_two_slots();
+
+        t.when_small_data_is_acquired(3);
+
+        t.then_the_data_is_stored_in_the_req();
+        t.then_the_stats_are(2, 1, 1, 4, 3);
+    }
+
+    TEST(uv_req_pool, it_should_recycle_released_slots)
+    {
+        test t;
+
+        t.given_a_pool_with_two_slots();
+
+        t.when_small_data_is_acquired(2);
+        t.when_small_data_is_released();
+        t.when_small_data_is_acquired(2);
+
+        t.then_the_stats_are(4, 0, 0, 2, 2);
+    }
+
+    TEST(uv_req_pool, it_should_fall_back_to_the_heap_when_data_does_not_fit)
+    {
+        test t;
+
+        t.given_a_pool_with_two_slots();
+
+        t.when_large_data_is_acquired();
+        t.when_large_data_is_released();
+
+        t.then_the_stats_are(0, 1, 0, 2, 0);
+    }
+
+    TEST(uv_req_pool, it_should_be_used_by_the_uv_filesystem)
+    {
+        t_pooled_stat t;
+
+        t.given_an_existing_path();
+
+        t.when_stat_is_invoked_sequentially(8);
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_every_req_was_served_by_the_pool(8);
+    }
+}
@@ -0,0 +1,337 @@
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <vfs/uv/uv-sharded-filesystem.hpp>
+
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_sharded :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::uv::sharded_filesystem> _sharded_fs;
+
+        std::vector<vfs::unix_path> _unix_paths;
+        std::vector<vfs::any_path> _paths;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::size_t _completed = 0;
+        std::size_t _errors = 0;
+        std::size_t _found = 0;
+        std::set<std::thread::id> _threads;
+
+        std::string _content;
+        vfs::mapped_slice _view;
+
+        std::set<std::string> _names;
+
+        // </editor-fold>
+
+        void complete(int err, bool exists)
+        {
+            std::lock_guard<std::mutex> lock {_mutex};
+
+            ++_completed;
+
+            _errors += err != 0 ? 1 : 0;
+            _found += exists ? 1 : 0;
+
+            _threads.insert(std::this_thread::get_id());
+
+            _cv.notify_all();
+        }
+
+        void wait_for(std::size_t n)
+        {
+            std::unique_lock<std::mutex> lock {_mutex};
+
+            _cv.wait(lock, [this, n]()
+            {
+                return _completed >= n;
+            });
+        }
+
+      public:
+
+        // <editor-fold name="Given">
+
+        void given_a_sharded_filesystem(std::size_t n_shards)
+        {
+            _sharded_fs = std::make_unique<vfs::uv::sharded_filesystem>(n_shards);
+        }
+
+        void given_existing_files(std::size_t n)
+        {
+            _unix_paths.resize(n);
+
+            for (auto &unix_path : _unix_paths)
+            {
+                _paths.emplace_back(unix_path);
+            }
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                _paths[i].clear()
+                    .append(_mount.path())
+                    .append("file-" + std::to_string(i));
+
+                create_file(_paths[i]);
+            }
+        }
+
+        void given_a_file_with_content(const std::string &content)
+        {
+            _content = content;
+
+            _path.clear()
+                .append(_mount.path())
+                .append("mapped");
+
+            write_file(_path, _content);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_exists_is_invoked_for_each_file()
+        {
+            for (auto &path : _paths)
+            {
+                _result = _sharded_fs->exists(path, [this](vfs::any_path &, int err, bool exists)
+                {
+                    complete(err, exists);
+                });
+
+                ASSERT_EQ(0, _result);
+            }
+
+            wait_for(_paths.size());
+        }
+
+        void when_exists_is_invoked_through_a_reused_path()
+        {
+            vfs::unix_path unix_path;
+            vfs::any_path path {unix_path};
+
+            for (std::size_t i = 0; i < _paths.size(); ++i)
+            {
+                path.clear()
+                    .append(_mount.path())
+                    .append("file-" + std::to_string(i));
+
+                _result = _sharded_fs->exists(path, [this](vfs::any_path &, int err, bool exists)
+                {
+                    complete(err, exists);
+                });
+
+                ASSERT_EQ(0, _result);
+
+                path.clear()
+                    .append(_mount.path())
+                    .append("missing");
+            }
+
+            wait_for(_paths.size());
+        }
+
+        void when_the_file_is_mapped()
+        {
+            _result = _sharded_fs->map(open_file(_path, O_RDONLY), 0, 0, vfs::map_default,
+                                       [this](vfs::uv::_uv_file_t &, int err, vfs::mapped_slice &view)
+            {
+                {
+                    std::lock_guard<std::mutex> lock {_mutex};
+
+                    _view = view;
+                }
+
+                complete(err, true);
+            });
+
+            ASSERT_EQ(0, _result);
+
+            wait_for(1);
+        }
+
+        void when_the_mount_is_listed(std::size_t batch_size)
+        {
+            _path.clear()
+                .append(_mount.path());
+
+            _result = _sharded_fs->readdir(_path, batch_size, [this](vfs::any_path &, int err, vfs::dir_batch &batch)
+            {
+                {
+                    std::lock_guard<std::mutex> lock {_mutex};
+
+                    for (auto &entry : batch)
+                    {
+                        _names.emplace(entry.name);
+                    }
+                }
+
+                if (err != 0 || batch.eof())
+                {
+                    complete(err, false);
+                }
+
+                return true;
+            });
+
+            ASSERT_EQ(0, _result);
+
+            wait_for(1);
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_every_file_exists()
+        {
+            ASSERT_EQ(_paths.size(), _completed);
+            ASSERT_EQ(0, _errors);
+            ASSERT_EQ(_paths.size(), _found);
+        }
+
+        void then_completions_ran_off_the_calling_thread()
+        {
+            ASSERT_EQ(0, _threads.count(std::this_thread::get_id()));
+        }
+
+        void then_a_path_always_maps_to_the_same_shard()
+        {
+            for (auto &path : _paths)
+            {
+                ASSERT_EQ(_sharded_fs->shard_of(path), _sharded_fs->shard_of(path));
+                ASSERT_LT(_sharded_fs->shard_of(path), _sharded_fs->shards());
+            }
+        }
+
+        void then_shard_stats_add_up()
+        {
+            uint64_t submitted = 0;
+            uint64_t dispatched = 0;
+            std::size_t used = 0;
+
+            for (std::size_t i = 0; i < _sharded_fs->shards(); ++i)
+            {
+                auto stats = _sharded_fs->shard_stats(i);
+
+                submitted += stats.submitted;
+                dispatched += stats.dispatched;
+                used += stats.submitted > 0 ? 1 : 0;
+
+                ASSERT_EQ(0, stats.rejected);
+                ASSERT_EQ(0, stats.queued);
+            }
+
+            ASSERT_EQ(_paths.size(), submitted);
+            ASSERT_EQ(_paths.size(), dispatched);
+            ASSERT_LT(1, used);
+        }
+
+        void then_every_file_is_listed()
+        {
+            ASSERT_EQ(0, _errors);
+            ASSERT_EQ(_paths.size(), _names.size());
+
+            for (std::size_t i = 0; i < _paths.size(); ++i)
+            {
+                ASSERT_EQ(1, _names.count("file-" + std::to_string(i)));
+            }
+        }
+
+        void then_the_view_has_the_content()
+        {
+            ASSERT_EQ(0, _errors);
+            ASSERT_EQ(_content, std::string(_view.begin(), _view.end()));
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_sharded_filesystem, it_should_complete_ops_on_the_shard_threads)
+    {
+        t_sharded t;
+
+        t.given_a_sharded_filesystem(4);
+        t.given_existing_files(64);
+
+        t.when_exists_is_invoked_for_each_file();
+
+        t.then_every_file_exists();
+        t.then_completions_ran_off_the_calling_thread();
+    }
+
+    TEST(uv_sharded_filesystem, it_should_route_paths_to_stable_shards)
+    {
+        t_sharded t;
+
+        t.given_a_sharded_filesystem(4);
+        t.given_existing_files(64);
+
+        t.then_a_path_always_maps_to_the_same_shard();
+    }
+
+    TEST(uv_sharded_filesystem, it_should_report_per_shard_stats)
+    {
+        t_sharded t;
+
+        t.given_a_sharded_filesystem(4);
+        t.given_existing_files(64);
+
+        t.when_exists_is_invoked_for_each_file();
+
+        t.then_shard_stats_add_up();
+    }
+
+    TEST(uv_sharded_filesystem, it_should_not_depend_on_the_caller_path_after_submit)
+    {
+        t_sharded t;
+
+        t.given_a_sharded_filesystem(4);
+        t.given_existing_files(64);
+
+        t.when_exists_is_invoked_through_a_reused_path();
+
+        t.then_every_file_exists();
+    }
+
+    TEST(uv_sharded_filesystem, it_should_map_files_on_the_shard_threads)
+    {
+        t_sharded t;
+
+        t.given_a_sharded_filesystem(4);
+        t.given_a_file_with_content("sharded mapping");
+
+        t.when_the_file_is_mapped();
+
+        t.then_the_view_has_the_content();
+        t.then_completions_ran_off_the_calling_thread();
+    }
+
+    TEST(uv_sharded_filesystem, it_should_list_dirs_on_the_shard_threads)
+    {
+        t_sharded t;
+
+        t.given_a_sharded_filesystem(4);
+        t.given_existing_files(10);
+
+        t.when_the_mount_is_listed(4);
+
+        t.then_every_file_is_listed();
+        t.then_completions_ran_off_the_calling_thread();
+    }
+}
@@ -0,0 +1,393 @@
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <vfs/uv/uv-filesystem.hpp>
+#include <vfs/uv/uv-worker-pool.hpp>
+
+#include "t-uv-filesystem-base.hpp"
+
+namespace
+{
+    class t_worker_pool :
+        public vfs::test::t_uv_filesystem_base
+    {
+      private:
+
+        // <editor-fold name="Context">
+
+        std::unique_ptr<vfs::uv::uv_worker_pool> _pool;
+        std::unique_ptr<vfs::uv::uv_worker_pool> _other_pool;
+        uv_timer_t _timer;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _blocked = false;
+        bool _released = false;
+        std::size_t _running = 0;
+
+        std::vector<vfs::uv::uv_work_class> _order;
+
+        std::thread::id _cb_thread;
+        std::string _read_result;
+        uint64_t _stat_size = 0;
+        bool _exists = false;
+
+        // </editor-fold>
+
+        void block()
+        {
+            std::unique_lock<std::mutex> lock {_mutex};
+
+            ++_running;
+            _blocked = true;
+            _cv.notify_all();
+
+            _cv.wait(lock, [this]()
+            {
+                return _released;
+            });
+        }
+
+      public:
+
+        ~t_worker_pool()
+        {
+            when_the_workers_are_released();
+        }
+
+        // <editor-fold name="Given">
+
+        void given_a_worker_pool(std::size_t min_threads, std::size_t max_threads)
+        {
+            _pool = std::make_unique<vfs::uv::uv_worker_pool>(min_threads, max_threads);
+        }
+
+        void given_a_filesystem_using_the_pool()
+        {
+            given_a_worker_pool(2, 4);
+
+            _uv_fs.use_worker_pool(*_pool);
+        }
+
+        void given_a_filesystem_using_a_single_worker()
+        {
+            given_a_worker_pool(1, 1);
+
+            _uv_fs.use_worker_pool(*_pool);
+        }
+
+        void given_a_blocked_worker()
+        {
+            _pool->submit(vfs::uv::uv_work_class::data, [this]()
+            {
+                block();
+            });
+
+            std::unique_lock<std::mutex> lock {_mutex};
+
+            _cv.wait(lock, [this]()
+            {
+                return _blocked;
+            });
+        }
+
+        void given_an_existing_file_with_content()
+        {
+            given_an_existing_file();
+
+            write_file(_path, "pool-data");
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="When">
+
+        void when_metadata_and_data_work_is_queued(std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                for (auto cls : {vfs::uv::uv_work_class::data, vfs::uv::uv_work_class::metadata})
+                {
+                    _pool->submit(cls, [this, cls]()
+                    {
+                        std::lock_guard<std::mutex> lock {_mutex};
+
+                        _order.push_back(cls);
+                    });
+                }
+            }
+        }
+
+        void when_blocking_work_is_queued(std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                _pool->submit(vfs::uv::uv_work_class::data, [this]()
+                {
+                    block();
+                });
+            }
+
+            std::unique_lock<std::mutex> lock {_mutex};
+
+            _cv.wait(lock, [this, n]()
+            {
+                return _running >= n;
+            });
+        }
+
+        void when_the_workers_are_released()
+        {
+            {
+                std::lock_guard<std::mutex> lock {_mutex};
+
+                _released = true;
+            }
+
+            _cv.notify_all();
+
+            _pool.reset();
+        }
+
+        void when_a_file_is_read_through_the_pool()
+        {
+            _result = _uv_fs.open(_path, O_RDONLY, [this](vfs::any_path &, int err, vfs::uv::_uv_file_t &file)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                _uv_fs.read(file, vfs::buffer {64}, 0, [this](vfs::uv::_uv_file_t &file, int err, vfs::buffer &buf)
+                {
+                    _error_result = err;
+                    _read_result = std::string {buf.begin(), buf.end()};
+                    _cb_thread = std::this_thread::get_id();
+
+                    _uv_fs.close(file, [](vfs::uv::_uv_file_t &, int)
+                    {});
+                });
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_a_file_is_created_and_stat_through_the_pool()
+        {
+            _result = _uv_fs.create(_path, [this](vfs::any_path &, int err)
+            {
+                _error_result = err;
+
+                if (err != 0)
+                {
+                    return;
+                }
+
+                _uv_fs.stat(_path, [this](vfs::any_path &, int err, vfs::uv::uv_stat stat)
+                {
+                    _error_result = err;
+                    _stat_size = stat.size();
+                    _cb_thread = std::this_thread::get_id();
+                });
+            });
+
+            _uv_fs.loop().run();
+        }
+
+        void when_the_pool_is_replaced_from_a_loop_callback_with_work_in_flight()
+        {
+            _other_pool = std::make_unique<vfs::uv::uv_worker_pool>(1, 1);
+
+            _result = _uv_fs.exists(_path, [this](vfs::any_path &, int err, bool exists)
+            {
+                _error_result = err;
+                _exists = exists;
+            });
+
+            _timer.data = this;
+
+            uv_timer_init(_uv_fs.loop(), &_timer);
+            uv_timer_start(&_timer, [](uv_timer_t *handle)
+            {
+                auto self = static_cast<t_worker_pool *>(handle->data);
+
+                self->_uv_fs.use_worker_pool(*self->_other_pool);
+
+                {
+                    std::lock_guard<std::mutex> lock {self->_mutex};
+
+                    self->_released = true;
+                }
+
+                self->_cv.notify_all();
+
+                uv_close(reinterpret_cast<uv_handle_t *>(handle), nullptr);
+            }, 0, 0);
+
+            _uv_fs.loop().run();
+        }
+
+        void when_exists_is_queued_and_the_path_is_reused()
+        {
+            _result = _uv_fs.exists(_path, [this](vfs::any_path &, int err, bool exists)
+            {
+                _error_result = err;
+                _exists = exists;
+            });
+
+            _path.append("-reused");
+
+            {
+                std::lock_guard<std::mutex> lock {_mutex};
+
+                _released = true;
+            }
+
+            _cv.notify_all();
+
+            _uv_fs.loop().run();
+        }
+
+        // </editor-fold>
+
+        // <editor-fold name="Then">
+
+        void then_the_pool_has_threads(std::size_t n)
+        {
+            ASSERT_EQ(n, _pool->stats().threads);
+        }
+
+        void then_metadata_work_ran_first_by_weight()
+        {
+            using c = vfs::uv::uv_work_class;
+
+            std::vector<c> expected {
+                c::metadata, c::metadata, c::metadata, c::data,
+                c::metadata, c::data, c::data, c::data
+            };
+
+            ASSERT_EQ(expected, _order);
+        }
+
+        void then_the_callbacks_ran_on_the_loop_thread()
+        {
+            ASSERT_EQ(std::this_thread::get_id(), _cb_thread);
+        }
+
+        void then_the_content_has_been_read()
+        {
+            ASSERT_EQ("pool-data", _read_result);
+        }
+
+        void then_the_queued_path_exists()
+        {
+            ASSERT_TRUE(_exists);
+        }
+
+        void then_the_created_file_is_empty()
+        {
+            ASSERT_EQ(0, _stat_size);
+        }
+
+        // </editor-fold>
+    };
+
+    // @formatter:off
+    TEST(uv_worker_pool, it_should_prewarm_the_minimum_number_of_threads)
+    {
+        t_worker_pool t;
+
+        t.given_a_worker_pool(3, 8);
+
+        t.then_the_pool_has_threads(3);
+    }
+
+    TEST(uv_worker_pool, it_should_grow_with_the_queue_depth)
+    {
+        t_worker_pool t;
+
+        t.given_a_worker_pool(1, 4);
+
+        t.when_blocking_work_is_queued(4);
+
+        t.then_the_pool_has_threads(4);
+    }
+
+    TEST(uv_worker_pool, it_should_favour_metadata_work_by_weight)
+    {
+        t_worker_pool t;
+
+        t.given_a_worker_pool(1, 1);
+        t.given_a_blocked_worker();
+
+        t.when_metadata_and_data_work_is_queued(4);
+        t.when_the_workers_are_released();
+
+        t.then_metadata_work_ran_first_by_weight();
+    }
+
+    TEST(uv_worker_pool, it_should_run_filesystem_reads_on_the_pool)
+    {
+        t_worker_pool t;
+
+        t.given_a_filesystem_using_the_pool();
+        t.given_an_existing_file_with_content();
+
+        t.when_a_file_is_read_through_the_pool();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_content_has_been_read();
+        t.then_the_callbacks_ran_on_the_loop_thread();
+    }
+
+    TEST(uv_worker_pool, it_should_run_filesystem_metadata_ops_on_the_pool)
+    {
+        t_worker_pool t;
+
+        t.given_a_filesystem_using_the_pool();
+        t.given_an_unexisting_path();
+
+        t.when_a_file_is_created_and_stat_through_the_pool();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_created_file_is_empty();
+        t.then_the_callbacks_ran_on_the_loop_thread();
+    }
+
+    TEST(uv_worker_pool, it_should_not_read_the_caller_path_after_submit)
+    {
+        t_worker_pool t;
+
+        t.given_a_filesystem_using_a_single_worker();
+        t.given_an_existing_file();
+        t.given_a_blocked_worker();
+
+        t.when_exists_is_queued_and_the_path_is_reused();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_queued_path_exists();
+    }
+
+    TEST(uv_worker_pool, it_should_finish_in_flight_work_when_the_pool_is_replaced_from_a_callback)
+    {
+        t_worker_pool t;
+
+        t.given_a_filesystem_using_a_single_worker();
+        t.given_an_existing_file();
+        t.given_a_blocked_worker();
+
+        t.when_the_pool_is_replaced_from_a_loop_callback_with_work_in_flight();
+
+        t.then_result_is_zero();
+        t.then_error_result_is_zero();
+        t.then_the_queued_path_exists();
+    }
+}